@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/examples/bulk.cpp" "src/examples/CMakeFiles/example_bulk.dir/bulk.cpp.o" "gcc" "src/examples/CMakeFiles/example_bulk.dir/bulk.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_mixed_build/src/CMakeFiles/libfaunus.dir/DependInfo.cmake"
+  "/root/repo/_mixed_build/src/xdrfile/CMakeFiles/xdrfile.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_bulk_dh.dir/bulk.cpp.o"
+  "CMakeFiles/example_bulk_dh.dir/bulk.cpp.o.d"
+  "bulk_dh"
+  "bulk_dh.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_bulk_dh.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_polymers.dir/polymers.cpp.o"
+  "CMakeFiles/example_polymers.dir/polymers.cpp.o.d"
+  "polymers"
+  "polymers.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_polymers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
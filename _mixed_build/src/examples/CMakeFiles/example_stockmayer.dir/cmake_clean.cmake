@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_stockmayer.dir/stockmayer.cpp.o"
+  "CMakeFiles/example_stockmayer.dir/stockmayer.cpp.o.d"
+  "stockmayer"
+  "stockmayer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_stockmayer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
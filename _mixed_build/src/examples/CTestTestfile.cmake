@@ -0,0 +1,28 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/examples
+# Build directory: /root/repo/_mixed_build/src/examples
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(unittests "/root/repo/_mixed_build/src/examples/unittests")
+set_tests_properties(unittests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;20;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_grand "python" "/root/repo/src/examples/grand.py")
+set_tests_properties(example_grand PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;28;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_stockmayer "/root/repo/src/examples/stockmayer.run")
+set_tests_properties(example_stockmayer PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;35;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_polymers "/root/repo/src/examples/polymers.run")
+set_tests_properties(example_polymers PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;45;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_slitpolymer "/root/repo/src/examples/slitpolymer.run")
+set_tests_properties(example_slitpolymer PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;49;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_membrane "/root/repo/src/examples/membrane.run")
+set_tests_properties(example_membrane PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;53;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_bulk "/root/repo/src/examples/bulk.run")
+set_tests_properties(example_bulk PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;57;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_mixedprecision "/root/repo/src/examples/mixedprecision.run")
+set_tests_properties(example_mixedprecision PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;69;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_water "/root/repo/src/examples/water.run")
+set_tests_properties(example_water PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;73;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_water2 "/root/repo/src/examples/water2.run")
+set_tests_properties(example_water2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;77;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
+add_test(example_cigarsenergy "/root/repo/src/examples/cigarsenergy.run")
+set_tests_properties(example_cigarsenergy PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/examples/CMakeLists.txt;82;add_test;/root/repo/src/examples/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/axel-tempertest.dir/axel/tempertest/temper.cpp.o"
+  "CMakeFiles/axel-tempertest.dir/axel/tempertest/temper.cpp.o.d"
+  "axel/tempertest/tempertest"
+  "axel/tempertest/tempertest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/axel-tempertest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cc-polymers.dir/cragnell/polymers.cpp.o"
+  "CMakeFiles/cc-polymers.dir/cragnell/polymers.cpp.o.d"
+  "cragnell/cc-polymers"
+  "cragnell/cc-polymers.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cc-polymers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/jana-wall.dir/jana/wall.cpp.o"
+  "CMakeFiles/jana-wall.dir/jana/wall.cpp.o.d"
+  "jana/jana-wall"
+  "jana/jana-wall.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/jana-wall.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-membrane-penalty.dir/mlund/membrane.cpp.o"
+  "CMakeFiles/mlund-membrane-penalty.dir/mlund/membrane.cpp.o.d"
+  "mlund/mlund-membrane-penalty"
+  "mlund/mlund-membrane-penalty.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-membrane-penalty.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
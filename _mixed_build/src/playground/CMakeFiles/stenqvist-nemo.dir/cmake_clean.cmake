@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stenqvist-nemo.dir/stenqvist/nemo.cpp.o"
+  "CMakeFiles/stenqvist-nemo.dir/stenqvist/nemo.cpp.o.d"
+  "stenqvist/nemo"
+  "stenqvist/nemo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stenqvist-nemo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
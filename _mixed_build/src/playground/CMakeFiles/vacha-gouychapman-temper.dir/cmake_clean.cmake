@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vacha-gouychapman-temper.dir/vacha/gouychapman.cpp.o"
+  "CMakeFiles/vacha-gouychapman-temper.dir/vacha/gouychapman.cpp.o.d"
+  "vacha/vacha-gouychapman-temper"
+  "vacha/vacha-gouychapman-temper.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vacha-gouychapman-temper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
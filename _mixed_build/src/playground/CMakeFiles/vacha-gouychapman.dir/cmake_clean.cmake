@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vacha-gouychapman.dir/vacha/gouychapman.cpp.o"
+  "CMakeFiles/vacha-gouychapman.dir/vacha/gouychapman.cpp.o.d"
+  "vacha/vacha-gouychapman"
+  "vacha/vacha-gouychapman.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vacha-gouychapman.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/xdrfile.dir/xdrfile.c.o"
+  "CMakeFiles/xdrfile.dir/xdrfile.c.o.d"
+  "CMakeFiles/xdrfile.dir/xdrfile_trr.c.o"
+  "CMakeFiles/xdrfile.dir/xdrfile_trr.c.o.d"
+  "CMakeFiles/xdrfile.dir/xdrfile_xtc.c.o"
+  "CMakeFiles/xdrfile.dir/xdrfile_xtc.c.o.d"
+  "libxdrfile.a"
+  "libxdrfile.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/xdrfile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/analysis.cpp" "src/CMakeFiles/libcigarfaunus.dir/analysis.cpp.o" "gcc" "src/CMakeFiles/libcigarfaunus.dir/analysis.cpp.o.d"
+  "/root/repo/src/geometry.cpp" "src/CMakeFiles/libcigarfaunus.dir/geometry.cpp.o" "gcc" "src/CMakeFiles/libcigarfaunus.dir/geometry.cpp.o.d"
+  "/root/repo/src/potentials.cpp" "src/CMakeFiles/libcigarfaunus.dir/potentials.cpp.o" "gcc" "src/CMakeFiles/libcigarfaunus.dir/potentials.cpp.o.d"
+  "/root/repo/src/slump.cpp" "src/CMakeFiles/libcigarfaunus.dir/slump.cpp.o" "gcc" "src/CMakeFiles/libcigarfaunus.dir/slump.cpp.o.d"
+  "/root/repo/src/species.cpp" "src/CMakeFiles/libcigarfaunus.dir/species.cpp.o" "gcc" "src/CMakeFiles/libcigarfaunus.dir/species.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_mpi_build/src/xdrfile/CMakeFiles/xdrfile.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcigarfaunus.dir/analysis.cpp.o"
+  "CMakeFiles/libcigarfaunus.dir/analysis.cpp.o.d"
+  "CMakeFiles/libcigarfaunus.dir/geometry.cpp.o"
+  "CMakeFiles/libcigarfaunus.dir/geometry.cpp.o.d"
+  "CMakeFiles/libcigarfaunus.dir/potentials.cpp.o"
+  "CMakeFiles/libcigarfaunus.dir/potentials.cpp.o.d"
+  "CMakeFiles/libcigarfaunus.dir/slump.cpp.o"
+  "CMakeFiles/libcigarfaunus.dir/slump.cpp.o.d"
+  "CMakeFiles/libcigarfaunus.dir/species.cpp.o"
+  "CMakeFiles/libcigarfaunus.dir/species.cpp.o.d"
+  "libcigarfaunus.pdb"
+  "libcigarfaunus.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcigarfaunus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libdipolefaunus.dir/analysis.cpp.o"
+  "CMakeFiles/libdipolefaunus.dir/analysis.cpp.o.d"
+  "CMakeFiles/libdipolefaunus.dir/geometry.cpp.o"
+  "CMakeFiles/libdipolefaunus.dir/geometry.cpp.o.d"
+  "CMakeFiles/libdipolefaunus.dir/potentials.cpp.o"
+  "CMakeFiles/libdipolefaunus.dir/potentials.cpp.o.d"
+  "CMakeFiles/libdipolefaunus.dir/slump.cpp.o"
+  "CMakeFiles/libdipolefaunus.dir/slump.cpp.o.d"
+  "CMakeFiles/libdipolefaunus.dir/species.cpp.o"
+  "CMakeFiles/libdipolefaunus.dir/species.cpp.o.d"
+  "libdipolefaunus.pdb"
+  "libdipolefaunus.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libdipolefaunus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libhyperfaunus.dir/analysis.cpp.o"
+  "CMakeFiles/libhyperfaunus.dir/analysis.cpp.o.d"
+  "CMakeFiles/libhyperfaunus.dir/geometry.cpp.o"
+  "CMakeFiles/libhyperfaunus.dir/geometry.cpp.o.d"
+  "CMakeFiles/libhyperfaunus.dir/potentials.cpp.o"
+  "CMakeFiles/libhyperfaunus.dir/potentials.cpp.o.d"
+  "CMakeFiles/libhyperfaunus.dir/slump.cpp.o"
+  "CMakeFiles/libhyperfaunus.dir/slump.cpp.o.d"
+  "CMakeFiles/libhyperfaunus.dir/species.cpp.o"
+  "CMakeFiles/libhyperfaunus.dir/species.cpp.o.d"
+  "libhyperfaunus.pdb"
+  "libhyperfaunus.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libhyperfaunus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_cigars2fibrils.dir/cigars2fibrils.cpp.o"
+  "CMakeFiles/example_cigars2fibrils.dir/cigars2fibrils.cpp.o.d"
+  "cigars2fibrils"
+  "cigars2fibrils.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_cigars2fibrils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_energysplit.dir/energysplit.cpp.o"
+  "CMakeFiles/example_energysplit.dir/energysplit.cpp.o.d"
+  "energysplit"
+  "energysplit.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_energysplit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_manybody.dir/manybody.cpp.o"
+  "CMakeFiles/example_manybody.dir/manybody.cpp.o.d"
+  "manybody"
+  "manybody.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_manybody.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
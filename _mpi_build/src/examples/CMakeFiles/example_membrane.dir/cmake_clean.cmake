@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_membrane.dir/membrane.cpp.o"
+  "CMakeFiles/example_membrane.dir/membrane.cpp.o.d"
+  "membrane"
+  "membrane.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_membrane.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
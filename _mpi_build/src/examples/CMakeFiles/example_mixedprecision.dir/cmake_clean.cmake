@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_mixedprecision.dir/mixedprecision.cpp.o"
+  "CMakeFiles/example_mixedprecision.dir/mixedprecision.cpp.o.d"
+  "mixedprecision"
+  "mixedprecision.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_mixedprecision.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_slitpolymer.dir/slitpolymer.cpp.o"
+  "CMakeFiles/example_slitpolymer.dir/slitpolymer.cpp.o.d"
+  "slitpolymer"
+  "slitpolymer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_slitpolymer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
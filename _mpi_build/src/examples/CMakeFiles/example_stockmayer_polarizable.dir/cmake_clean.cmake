@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_stockmayer_polarizable.dir/stockmayer.cpp.o"
+  "CMakeFiles/example_stockmayer_polarizable.dir/stockmayer.cpp.o.d"
+  "stockmayer_polarizable"
+  "stockmayer_polarizable.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_stockmayer_polarizable.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_temper.dir/temper.cpp.o"
+  "CMakeFiles/example_temper.dir/temper.cpp.o.d"
+  "temper"
+  "temper.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_temper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_titrate.dir/titrate.cpp.o"
+  "CMakeFiles/example_titrate.dir/titrate.cpp.o.d"
+  "titrate"
+  "titrate.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_titrate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_water2.dir/water2.cpp.o"
+  "CMakeFiles/example_water2.dir/water2.cpp.o.d"
+  "water2"
+  "water2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_water2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
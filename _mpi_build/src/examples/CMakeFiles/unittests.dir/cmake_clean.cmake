@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittests.dir/unittests.cpp.o"
+  "CMakeFiles/unittests.dir/unittests.cpp.o.d"
+  "unittests"
+  "unittests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
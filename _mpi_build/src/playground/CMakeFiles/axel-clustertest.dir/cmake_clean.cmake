@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/axel-clustertest.dir/axel/clustertest/cluster.cpp.o"
+  "CMakeFiles/axel-clustertest.dir/axel/clustertest/cluster.cpp.o.d"
+  "axel/clustertest/clustertest"
+  "axel/clustertest/clustertest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/axel-clustertest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
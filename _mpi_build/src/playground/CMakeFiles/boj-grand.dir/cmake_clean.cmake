@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/boj-grand.dir/bosse/grand.cpp.o"
+  "CMakeFiles/boj-grand.dir/bosse/grand.cpp.o.d"
+  "bosse/boj-grand"
+  "bosse/boj-grand.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/boj-grand.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
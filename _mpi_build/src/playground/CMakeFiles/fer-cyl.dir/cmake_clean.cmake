@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fer-cyl.dir/fernando/cyl.cpp.o"
+  "CMakeFiles/fer-cyl.dir/fernando/cyl.cpp.o.d"
+  "fernando/fer-cyl"
+  "fernando/fer-cyl.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fer-cyl.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
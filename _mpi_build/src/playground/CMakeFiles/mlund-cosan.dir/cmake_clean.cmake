@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-cosan.dir/mlund/cosan.cpp.o"
+  "CMakeFiles/mlund-cosan.dir/mlund/cosan.cpp.o.d"
+  "mlund/mlund-cosan"
+  "mlund/mlund-cosan.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-cosan.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-membrane-temper.dir/mlund/membrane-temper.cpp.o"
+  "CMakeFiles/mlund-membrane-temper.dir/mlund/membrane-temper.cpp.o.d"
+  "mlund/mlund-membrane-temper"
+  "mlund/mlund-membrane-temper.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-membrane-temper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-membrane.dir/mlund/membrane.cpp.o"
+  "CMakeFiles/mlund-membrane.dir/mlund/membrane.cpp.o.d"
+  "mlund/mlund-membrane"
+  "mlund/mlund-membrane.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-membrane.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
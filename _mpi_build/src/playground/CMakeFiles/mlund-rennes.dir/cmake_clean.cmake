@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-rennes.dir/mlund/rennes/twobody.cpp.o"
+  "CMakeFiles/mlund-rennes.dir/mlund/rennes/twobody.cpp.o.d"
+  "mlund/rennes/mlund-rennes"
+  "mlund/rennes/mlund-rennes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-rennes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
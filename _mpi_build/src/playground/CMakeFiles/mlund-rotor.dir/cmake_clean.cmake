@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-rotor.dir/mlund/twobodyrotor.cpp.o"
+  "CMakeFiles/mlund-rotor.dir/mlund/twobodyrotor.cpp.o.d"
+  "mlund/mlund-rotor"
+  "mlund/mlund-rotor.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-rotor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-test.dir/mlund/test.cpp.o"
+  "CMakeFiles/mlund-test.dir/mlund/test.cpp.o.d"
+  "mlund/mlund-test"
+  "mlund/mlund-test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/psc-nvt.dir/vacha/psc-nvt.cpp.o"
+  "CMakeFiles/psc-nvt.dir/vacha/psc-nvt.cpp.o.d"
+  "vacha/psc-nvt"
+  "vacha/psc-nvt.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/psc-nvt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libfaunus.dir/analysis.cpp.o"
+  "CMakeFiles/libfaunus.dir/analysis.cpp.o.d"
+  "CMakeFiles/libfaunus.dir/geometry.cpp.o"
+  "CMakeFiles/libfaunus.dir/geometry.cpp.o.d"
+  "CMakeFiles/libfaunus.dir/potentials.cpp.o"
+  "CMakeFiles/libfaunus.dir/potentials.cpp.o.d"
+  "CMakeFiles/libfaunus.dir/slump.cpp.o"
+  "CMakeFiles/libfaunus.dir/slump.cpp.o.d"
+  "CMakeFiles/libfaunus.dir/species.cpp.o"
+  "CMakeFiles/libfaunus.dir/species.cpp.o.d"
+  "libfaunus.pdb"
+  "libfaunus.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libfaunus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_bulk_coulomb.dir/bulk.cpp.o"
+  "CMakeFiles/example_bulk_coulomb.dir/bulk.cpp.o.d"
+  "bulk_coulomb"
+  "bulk_coulomb.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_bulk_coulomb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
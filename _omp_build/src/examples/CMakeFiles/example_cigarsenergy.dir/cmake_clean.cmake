@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_cigarsenergy.dir/cigarsenergy.cpp.o"
+  "CMakeFiles/example_cigarsenergy.dir/cigarsenergy.cpp.o.d"
+  "cigarsenergy"
+  "cigarsenergy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_cigarsenergy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_grand.dir/grand.cpp.o"
+  "CMakeFiles/example_grand.dir/grand.cpp.o.d"
+  "grand"
+  "grand.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_grand.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_hypersphere.dir/hypersphere.cpp.o"
+  "CMakeFiles/example_hypersphere.dir/hypersphere.cpp.o.d"
+  "hypersphere"
+  "hypersphere.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_hypersphere.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_minimal.dir/minimal.cpp.o"
+  "CMakeFiles/example_minimal.dir/minimal.cpp.o.d"
+  "minimal"
+  "minimal.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_minimal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
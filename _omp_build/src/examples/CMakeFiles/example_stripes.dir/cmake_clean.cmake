@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_stripes.dir/stripes.cpp.o"
+  "CMakeFiles/example_stripes.dir/stripes.cpp.o.d"
+  "stripes"
+  "stripes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_stripes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
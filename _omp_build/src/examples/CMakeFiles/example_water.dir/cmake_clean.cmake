@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_water.dir/water.cpp.o"
+  "CMakeFiles/example_water.dir/water.cpp.o.d"
+  "water"
+  "water.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_water.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/akurut-gouychapman-slit.dir/akurut/gouychapman.cpp.o"
+  "CMakeFiles/akurut-gouychapman-slit.dir/akurut/gouychapman.cpp.o.d"
+  "akurut/akurut-gouychapman-slit"
+  "akurut/akurut-gouychapman-slit.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/akurut-gouychapman-slit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
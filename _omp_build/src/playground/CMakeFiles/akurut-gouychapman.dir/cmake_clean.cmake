@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/akurut-gouychapman.dir/akurut/gouychapman.cpp.o"
+  "CMakeFiles/akurut-gouychapman.dir/akurut/gouychapman.cpp.o.d"
+  "akurut/akurut-gouychapman"
+  "akurut/akurut-gouychapman.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/akurut-gouychapman.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
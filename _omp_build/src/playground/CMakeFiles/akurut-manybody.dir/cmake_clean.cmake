@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/akurut-manybody.dir/akurut/manybody.cpp.o"
+  "CMakeFiles/akurut-manybody.dir/akurut/manybody.cpp.o.d"
+  "akurut/akurut-manybody"
+  "akurut/akurut-manybody.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/akurut-manybody.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
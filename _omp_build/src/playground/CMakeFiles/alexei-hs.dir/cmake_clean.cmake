@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/alexei-hs.dir/alexei/HS.cpp.o"
+  "CMakeFiles/alexei-hs.dir/alexei/HS.cpp.o.d"
+  "alexei/HS"
+  "alexei/HS.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/alexei-hs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
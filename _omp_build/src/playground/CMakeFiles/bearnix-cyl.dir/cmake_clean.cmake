@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bearnix-cyl.dir/bearnix/cyl.cpp.o"
+  "CMakeFiles/bearnix-cyl.dir/bearnix/cyl.cpp.o.d"
+  "bearnix/bearnix-cyl"
+  "bearnix/bearnix-cyl.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bearnix-cyl.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
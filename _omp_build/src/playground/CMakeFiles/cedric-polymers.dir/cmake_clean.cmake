@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cedric-polymers.dir/cedric/polymers.cpp.o"
+  "CMakeFiles/cedric-polymers.dir/cedric/polymers.cpp.o.d"
+  "cedric/cedric-polymers"
+  "cedric/cedric-polymers.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cedric-polymers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
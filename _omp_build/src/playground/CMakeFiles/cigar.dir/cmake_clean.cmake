@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cigar.dir/vacha/cigar.cpp.o"
+  "CMakeFiles/cigar.dir/vacha/cigar.cpp.o.d"
+  "vacha/cigar"
+  "vacha/cigar.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cigar.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-angular.dir/mlund/angular.cpp.o"
+  "CMakeFiles/mlund-angular.dir/mlund/angular.cpp.o.d"
+  "mlund/mlund-angular"
+  "mlund/mlund-angular.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-angular.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-cluster.dir/mlund/cluster.cpp.o"
+  "CMakeFiles/mlund-cluster.dir/mlund/cluster.cpp.o.d"
+  "mlund/mlund-cluster"
+  "mlund/mlund-cluster.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-cluster.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
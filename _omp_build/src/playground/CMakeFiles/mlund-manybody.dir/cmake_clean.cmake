@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-manybody.dir/mlund/manybody.cpp.o"
+  "CMakeFiles/mlund-manybody.dir/mlund/manybody.cpp.o.d"
+  "mlund/mlund-manybody"
+  "mlund/mlund-manybody.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-manybody.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mlund-volume.dir/mlund/volume.cpp.o"
+  "CMakeFiles/mlund-volume.dir/mlund/volume.cpp.o.d"
+  "mlund/mlund-volume"
+  "mlund/mlund-volume.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mlund-volume.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
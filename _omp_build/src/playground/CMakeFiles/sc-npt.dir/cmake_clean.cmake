@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sc-npt.dir/vacha/sc-npt.cpp.o"
+  "CMakeFiles/sc-npt.dir/vacha/sc-npt.cpp.o.d"
+  "vacha/sc-npt"
+  "vacha/sc-npt.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sc-npt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test2.dir/vacha/test2.cpp.o"
+  "CMakeFiles/test2.dir/vacha/test2.cpp.o.d"
+  "vacha/test2"
+  "vacha/test2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/xdrfile/xdrfile.c" "src/xdrfile/CMakeFiles/xdrfile.dir/xdrfile.c.o" "gcc" "src/xdrfile/CMakeFiles/xdrfile.dir/xdrfile.c.o.d"
+  "/root/repo/src/xdrfile/xdrfile_trr.c" "src/xdrfile/CMakeFiles/xdrfile.dir/xdrfile_trr.c.o" "gcc" "src/xdrfile/CMakeFiles/xdrfile.dir/xdrfile_trr.c.o.d"
+  "/root/repo/src/xdrfile/xdrfile_xtc.c" "src/xdrfile/CMakeFiles/xdrfile.dir/xdrfile_xtc.c.o" "gcc" "src/xdrfile/CMakeFiles/xdrfile.dir/xdrfile_xtc.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
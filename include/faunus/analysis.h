@@ -13,6 +13,9 @@
 
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 namespace Faunus {
 
@@ -46,6 +49,7 @@ namespace Faunus {
         string name;          //!< descriptive name
         string cite;          //!< reference, url, doi etc. describing the analysis
         bool run();           //!< true if we should run, false of not (based on runfraction)
+        static thread_local bool presampled; //!< true while `AnalysisPipeline` workers run analyses
       public:
         AnalysisBase();
         virtual ~AnalysisBase();
@@ -54,6 +58,322 @@ namespace Faunus {
         void test(UnitTest&);//!< Perform unit test
     };
 
+    /**
+     * @brief Asynchronous analysis of system snapshots in worker threads
+     *
+     * Analyses registered with `add()` are not run by the Markov chain
+     * thread. Instead `sample()` copies the particle vector, the geometry
+     * and all enrolled groups (incl. mass centers) into a snapshot, queues
+     * it and returns immediately. A pool of worker threads then runs every
+     * registered analysis on each snapshot. Snapshot buffers are allocated
+     * once and recycled so memory is bounded by `pipeline_queue` copies of
+     * the system. If all buffers are in use, `sample()` waits for one to
+     * become free. With `pipeline_drop` the snapshot is instead discarded
+     * so that the chain never waits -- results then depend on thread
+     * timing and are not reproducible.
+     *
+     * A `Snapshot` has `p` and `geo` members like `Space` and thus works
+     * with the templated `sample()` functions of most analyses. There
+     * are two kinds of tasks:
+     *
+     * - `add(name, target, f)` runs `f(T&, snapshot)` on a private copy of
+     *   `target` per worker. The copies are merged into `target` using
+     *   `operator+=` and reset when calling `merge()`, typically at every
+     *   macro step. Targets must be empty when added. Snapshot number `n`
+     *   always goes to worker `n` modulo the number of threads so merged
+     *   results do not depend on scheduling.
+     * - `add(name, f)` runs `f(snapshot)` on one worker at a time, for
+     *   analyses that cannot be merged. Different tasks run concurrently
+     *   and snapshots may arrive out of order; use `Snapshot::step`.
+     *
+     * Whether a task runs on a given snapshot is decided by `sample()`,
+     * i.e. on the Markov chain thread, using `runfraction` of the target
+     * (if derived from `AnalysisBase`) and of the pipeline itself. Inside
+     * the workers `AnalysisBase::run()` is always true and never touches
+     * the global random number generator.
+     *
+     * Example:
+     *
+     *     Analysis::AnalysisPipeline<Tspace> pipe(mcp, spc);
+     *     pipe.add("g(r)", rdf, [](decltype(rdf) &a, const decltype(pipe)::Snapshot &s) {
+     *         a.sample(s, salt, idA, idB); } );
+     *     ...
+     *     if (slp_global()<0.1)
+     *       pipe.sample();            // in micro loop
+     *     ...
+     *     pipe.merge();               // at macro step, before using rdf
+     *
+     * Keyword            | Description
+     * :----------------- | :---------------------------------------------
+     * `pipeline_threads` | Worker threads (default: hardware threads minus one, 0=run in `sample()`)
+     * `pipeline_queue`   | Number of snapshot buffers (default: 2 per thread)
+     * `pipeline_drop`    | Drop snapshots instead of waiting for a free buffer (default: no)
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class AnalysisPipeline : public AnalysisBase {
+        public:
+          /** @brief Immutable copy of the system */
+          struct Snapshot {
+            typename Tspace::p_vec p;                  //!< Particles
+            typename Tspace::GeometryType geo;         //!< Geometry
+            std::vector<Group> groups;                 //!< Copy of `Space::groupList()`
+            std::vector<char> active;                  //!< Tasks to run on this snapshot
+            unsigned long int step;                    //!< Sample number
+            Snapshot(const typename Tspace::GeometryType &g) : geo(g), step(0) {}
+          };
+
+        private:
+          struct TaskBase {
+            string name;
+            double runfraction;
+            std::vector<double> seconds;               // per worker
+            std::vector<unsigned long int> calls;      // per worker
+            TaskBase() : runfraction(1) {}
+            virtual void run(int, const Snapshot&)=0;
+            virtual void merge() {}
+            virtual ~TaskBase() {}
+          };
+
+          template<class T, class Tfunc>
+            struct MergedTask : public TaskBase {
+              T &target;
+              T prototype;
+              std::vector<T> copies;
+              Tfunc f;
+              MergedTask(T &t, Tfunc fn, int n) : target(t), prototype(t), copies(n,t), f(fn) {}
+              void run(int w, const Snapshot &s) FOVERRIDE { f(copies[w], s); }
+              void merge() FOVERRIDE {
+                for (auto &c : copies) {
+                  target += c;
+                  c = prototype;
+                }
+              }
+          };
+
+          template<class Tfunc>
+            struct SerialTask : public TaskBase {
+              std::mutex m;
+              Tfunc f;
+              SerialTask(Tfunc fn) : f(fn) {}
+              void run(int w, const Snapshot &s) FOVERRIDE {
+                std::lock_guard<std::mutex> lock(m);
+                f(s);
+              }
+          };
+
+          template<class T>
+            static typename std::enable_if<std::is_base_of<AnalysisBase,T>::value, double>::type
+            fraction(const T &a) { return a.runfraction; }
+
+          template<class T>
+            static typename std::enable_if<!std::is_base_of<AnalysisBase,T>::value, double>::type
+            fraction(const T&) { return 1; }
+
+          Tspace *spc;
+          int nthreads, nbuffers;
+          bool drop, stop;
+          std::vector<std::unique_ptr<TaskBase> > tasks;
+          std::vector<std::unique_ptr<Snapshot> > buffers;
+          std::vector<int> vacant;                     // free buffers
+          std::vector<std::deque<int> > queue;         // buffers waiting for analysis, per worker
+          int busy;                                    // buffers being analysed
+          unsigned long int dropped;
+          std::mutex mtx;
+          std::condition_variable cv_work, cv_done;
+          std::vector<std::thread> workers;
+
+          void runTasks(int w, const Snapshot &s) {
+            presampled=true;
+            for (size_t i=0; i<tasks.size(); i++)
+              if (s.active[i]) {
+                auto &t = tasks[i];
+                auto t0 = std::chrono::steady_clock::now();
+                t->run(w,s);
+                t->seconds[w] += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now()-t0 ).count();
+                t->calls[w]++;
+              }
+            presampled=false;
+          }
+
+          bool idle() const {
+            for (auto &q : queue)
+              if (!q.empty())
+                return false;
+            return busy==0;
+          }
+
+          void work(int w) {
+            while (true) {
+              int k;
+              {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_work.wait(lock, [&] { return stop || !queue[w].empty(); });
+                if (queue[w].empty())
+                  return;
+                k = queue[w].front();
+                queue[w].pop_front();
+                busy++;
+              }
+              runTasks(w, *buffers[k]);
+              {
+                std::lock_guard<std::mutex> lock(mtx);
+                vacant.push_back(k);
+                busy--;
+              }
+              cv_done.notify_all();
+            }
+          }
+
+          void start() {
+            for (int i=0; i<nbuffers; i++) {
+              buffers.emplace_back( new Snapshot(spc->geo) );
+              vacant.push_back(i);
+            }
+            queue.resize(nthreads);
+            for (int w=0; w<nthreads; w++)
+              workers.emplace_back( &AnalysisPipeline::work, this, w );
+          }
+
+          string _info() {
+            using namespace textio;
+            std::ostringstream o;
+            o << pad(SUB,w,"Worker threads") << nthreads << endl
+              << pad(SUB,w,"Snapshot buffers") << nbuffers << endl
+              << pad(SUB,w,"Snapshots") << cnt-dropped << endl;
+            if (cnt>0 && drop)
+              o << pad(SUB,w,"Dropped") << double(dropped)/cnt*100 << percent << endl;
+            for (auto &t : tasks) {
+              double s=0, n=0;
+              for (size_t i=0; i<t->calls.size(); i++) {
+                s+=t->seconds[i];
+                n+=t->calls[i];
+              }
+              if (n>0)
+                o << pad(SUB,w,t->name) << s/n*1e3 << " ms per snapshot" << endl;
+            }
+            return o.str();
+          }
+
+          void addTask(const string &name, TaskBase *t) {
+            assert(workers.empty() && buffers.empty() && "Add tasks before sampling");
+            tasks.emplace_back(t);
+            t->name=name;
+            t->seconds.resize(std::max(1,nthreads),0);
+            t->calls.resize(std::max(1,nthreads),0);
+          }
+
+        public:
+          AnalysisPipeline(InputMap &in, Tspace &s) : spc(&s), stop(false), busy(0), dropped(0) {
+            name="Asynchronous analysis";
+            int hw = std::thread::hardware_concurrency();
+            nthreads = in.get<int>("pipeline_threads", std::max(1,hw-1), "Analysis worker threads");
+            nbuffers = std::max(1, in.get<int>("pipeline_queue", 2*std::max(1,nthreads),
+                  "Analysis snapshot buffers") );
+            drop = in.get<bool>("pipeline_drop", false, "Drop snapshots if analysis is busy");
+          }
+
+          ~AnalysisPipeline() {
+            {
+              std::lock_guard<std::mutex> lock(mtx);
+              stop=true;
+            }
+            cv_work.notify_all();
+            for (auto &t : workers)
+              t.join();
+          }
+
+          /**
+           * @brief Add analysis with per-thread copies merged into `target`
+           * @param name Descriptive name
+           * @param target Analysis with `operator+=`; must be empty
+           * @param f Function called as `f(T&, const Snapshot&)`
+           */
+          template<class T, class Tfunc>
+            void add(const string &name, T &target, Tfunc f) {
+              auto t = new MergedTask<T,Tfunc>(target, f, std::max(1,nthreads));
+              t->runfraction = fraction(target);
+              addTask(name, t);
+            }
+
+          /**
+           * @brief Add analysis that is run by one thread at a time
+           * @param name Descriptive name
+           * @param f Function called as `f(const Snapshot&)`
+           */
+          template<class Tfunc>
+            void add(const string &name, Tfunc f) {
+              addTask(name, new SerialTask<Tfunc>(f));
+            }
+
+          /**
+           * @brief Queue snapshot of the current state for analysis
+           * @return False if not sampled due to `runfraction` or dropped
+           */
+          bool sample() {
+            if (!run())
+              return false;
+            std::vector<char> active(tasks.size());
+            bool any=false;
+            for (size_t i=0; i<tasks.size(); i++) {
+              active[i] = (tasks[i]->runfraction>=1 || slp_global()<=tasks[i]->runfraction);
+              any = any || active[i];
+            }
+            if (!any)
+              return false;
+            if (buffers.empty())
+              start();
+            int k;
+            {
+              std::unique_lock<std::mutex> lock(mtx);
+              if (vacant.empty()) {
+                if (drop) {
+                  dropped++;
+                  return false;
+                }
+                cv_done.wait(lock, [&] { return !vacant.empty(); });
+              }
+              k = vacant.back();
+              vacant.pop_back();
+            }
+            Snapshot &s = *buffers[k];
+            s.p = spc->p;
+            s.geo = spc->geo;
+            s.groups.resize( spc->groupList().size() );
+            for (size_t i=0; i<s.groups.size(); i++)
+              s.groups[i] = *spc->groupList()[i];
+            s.active.swap(active);
+            s.step = cnt;
+            if (workers.empty()) {
+              runTasks(0, s);
+              std::lock_guard<std::mutex> lock(mtx);
+              vacant.push_back(k);
+              return true;
+            }
+            {
+              std::lock_guard<std::mutex> lock(mtx);
+              queue[s.step % nthreads].push_back(k);
+            }
+            cv_work.notify_all();
+            return true;
+          }
+
+          /** @brief Wait until all queued snapshots are analysed */
+          void flush() {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv_done.wait(lock, [&] { return idle(); });
+          }
+
+          /** @brief Wait for queued snapshots and merge thread copies into targets */
+          void merge() {
+            flush();
+            for (auto &t : tasks)
+              t->merge();
+          }
+      };
+
     /**
      * @brief Pressure analysis using the virial theorem
      *
@@ -67,6 +387,17 @@ namespace Faunus {
      * and the excess pressure scalar is the trace of @f$\mathcal{P}@f$.
      * The trivial kinetic contribution is currently not included.
      *
+     * Only pairs closer than `cutoff` (default: infinity) are considered
+     * and if the geometry is a `Geometry::Cuboid` with room for at least three
+     * cells in each direction, these are found using a `Geometry::CellList`,
+     * i.e. forces are evaluated only for interacting pairs. The pair loop
+     * is OpenMP parallelized with per-thread tensors that are summed at the end.
+     *
+     * For rigid molecules set `molecularVirial=true`: internal pairs of
+     * molecular groups (`Group::isMolecular()`) are ignored, each molecule
+     * counts as one particle in the ideal term, and pair forces are multiplied
+     * by the mass center separation instead of the particle separation.
+     *
      * References:
      *
      * - <http://dx.doi.org/10/ffwrhd>
@@ -81,6 +412,8 @@ namespace Faunus {
         typedef Eigen::Matrix3d Ttensor;
         Ttensor T;           // excess pressure tensor
         Average<double> Pid; // ideal pressure
+        Geometry::CellList<Geometry::Cuboid> cells;
+        vector<int> index, gid; // particles in groups; group index of each particle
 
         inline string _info() {
           using namespace Faunus::textio;
@@ -102,6 +435,10 @@ namespace Faunus {
 
             char l=15;
             double kT=pc::kB*pc::T();
+            if (cutoff<pc::infty)
+              o << pad(SUB,l+5,"Pair cutoff") << cutoff << _angstrom << endl;
+            if (molecularVirial)
+              o << indent(SUB) << "Molecular virial" << endl;
             o << "\n  " << std::right
               << setw(l+l) << "kT/"+angstrom+cubed
               << setw(l) << "mM" << setw(l) << "Pa" << setw(l) << "atm" << "\n";
@@ -124,30 +461,28 @@ namespace Faunus {
           test("virial_pressure_mM", (T/cnt).trace()*1e30/pc::Nav );
         }
 
-        template<class Tpvec, class Tgeo, class Tpot>
-          Ttensor g_internal(const Tpvec &p, Tgeo &geo, Tpot &pot, Group &g) { 
-            Ttensor t;
-            t.setZero();
-            for (auto i=g.front(); i<g.back(); i++)
-              for (auto j=i+1; j<=g.back(); j++) {
-                auto rij = geo.vdist(p[i],p[j]);
-                auto fij = pot.f_p2p(p[i],p[j]);
-                t += rij * fij.transpose();
-              }
-            return t;
-          }
+        bool setGrid(const Geometry::Cuboid &geo) { return cells.setGrid(geo, cutoff); }
+
+        bool setGrid(const Geometry::Geometrybase&) { return false; }
 
-        template<class Tpvec, class Tgeo, class Tpot>
-          Ttensor g2g(const Tpvec &p, Tgeo &geo, Tpot &pot, Group &g1, Group &g2) { 
-            assert(&g1!=&g2);
+        /** @brief Virial contribution from pair i,j, zero if excluded or beyond cutoff */
+        template<class Tspace, class Tpot>
+          Ttensor pairVirial(Tspace &spc, Tpot &pot, int i, int j) {
             Ttensor t;
             t.setZero();
-            for (auto i : g1)
-              for (auto j : g2) {
-                auto rij = geo.vdist(p[i],p[j]);
-                auto fij = pot.f_p2p(p[i],p[j]);
-                t += rij * fij.transpose();
-              }
+            auto gi=spc.groupList()[ gid[i] ];
+            auto gj=spc.groupList()[ gid[j] ];
+            if (gi==gj && gi->isMolecular() && (noMolecularPressure || molecularVirial))
+              return t;
+            Point rij = spc.geo.vdist(spc.p[i], spc.p[j]);
+            if (rij.squaredNorm() > cutoff*cutoff)
+              return t;
+            Point fij = pot.f_p2p(spc.p[i], spc.p[j]);
+            if (molecularVirial)
+              if (gi->isMolecular() || gj->isMolecular())
+                rij = spc.geo.vdist( gi->isMolecular() ? gi->cm : Point(spc.p[i]),
+                    gj->isMolecular() ? gj->cm : Point(spc.p[j]) );
+            t = rij.cast<double>() * fij.cast<double>().transpose();
             return t;
           }
 
@@ -156,12 +491,23 @@ namespace Faunus {
         VirialPressure() {
           name="Virial Pressure";
           noMolecularPressure=false;
+          molecularVirial=false;
+          cutoff=pc::infty;
           T.setZero();
         }
 
         /*! @brief Ignore internal pressure in molecular groups (default: false) */
         bool noMolecularPressure;
 
+        /*! @brief Use mass center separations for molecular groups (default: false) */
+        bool molecularVirial;
+
+        /*! @brief Pair distance beyond which forces vanish (default: infinity) */
+        double cutoff;
+
+        /*! @brief Average excess pressure tensor (kT/angstrom^3) */
+        Eigen::Matrix3d excessTensor() const { return (cnt>0) ? Ttensor(T/cnt) : Ttensor(T); }
+
         template<class Tspace, class Tpotential>
           void sample(Tspace &spc, Tpotential &pot, int d=3, double area=0) {
             cnt++;
@@ -175,22 +521,44 @@ namespace Faunus {
               V=area;
             }
 
-            // loop over groups internally
-            for (auto g : spc.groupList()) {
-              if (noMolecularPressure)
-                if (g->isMolecular()) {
-                  N=N-g->size()+1;
-                  continue;
+            // particles in groups
+            index.clear();
+            gid.assign(spc.p.size(), -1);
+            for (size_t k=0; k<spc.groupList().size(); k++) {
+              auto g=spc.groupList()[k];
+              if (g->isMolecular() && (noMolecularPressure || molecularVirial))
+                N=N-g->size()+1;
+              for (auto i : *g)
+                if (gid[i]<0) {
+                  gid[i]=k;
+                  index.push_back(i);
                 }
-              t+=g_internal(spc.p, spc.geo, pot, *g);
             }
 
-            // loop group-to-group
-            auto beg=spc.groupList().begin();
-            auto end=spc.groupList().end();
-            for (auto gi=beg; gi!=end; ++gi)
-              for (auto gj=gi; ++gj!=end;)
-                t+=g2g(spc.p, spc.geo, pot, *(*gi), *(*gj));
+            bool useCells=setGrid(spc.geo);
+            if (useCells)
+              cells.build(spc.p, index);
+
+            int n=index.size();
+#pragma omp parallel
+            {
+              Ttensor tl;   // thread local tensor
+              tl.setZero();
+#pragma omp for schedule (dynamic)
+              for (int k=0; k<n; k++) {
+                int i=index[k];
+                if (useCells)
+                  cells.forNeighbors(spc.p[i], [&](int j) {
+                      if (j>i)
+                        tl += pairVirial(spc, pot, i, j);
+                      });
+                else
+                  for (int l=k+1; l<n; l++)
+                    tl += pairVirial(spc, pot, i, index[l]);
+              }
+#pragma omp critical
+              t += tl;
+            }
 
             // add to grand avarage
             T += t/(d*V);
@@ -251,6 +619,14 @@ namespace Faunus {
             return map[ round(x) ];
           }
 
+          /** @brief Merge data from another table with same resolution */
+          Table2D& operator+=(const Table2D &other) {
+            assert( dx==other.dx && "Tables must have same resolution");
+            for (auto &m : other.map)
+              map[m.first] = map[m.first] + m.second;
+            return *this;
+          }
+
           /** @brief Save table to disk */
           template<class T=double>
             void save(string filename, T scale=1) {
@@ -478,6 +854,8 @@ namespace Faunus {
       This threshold check is carried out every 1000th call to `update()`.
       Note also that when the penalty energy is scaled, so is the threshold
       (also by a factor of 0.5).
+
+      @see PenaltyGrid for a faster, dense grid version with multiple walkers.
       */
     template<typename Tcoord=float>
       class PenaltyFunction : public Table2D<Tcoord,double> {
@@ -544,6 +922,239 @@ namespace Faunus {
           }
       };
 
+    /**
+     * @brief Flat-histogram penalty function on a dense 1D or 2D grid
+     * @date Lund 2014
+     *
+     * Dense-grid alternative to `PenaltyFunction` for one or two reaction
+     * coordinates. Lookups and updates are plain index calculations
+     * and the bias can be shared between several walkers by periodically
+     * calling `merge()` (threads) or `MPI::mergePenalty()` (ranks). Two update schemes
+     * are available:
+     *
+     * - **Wang-Landau** (default): each update adds `f` to the bias. Every
+     *   `Ncheck` updates the histogram is tested for flatness,
+     *   \f$ \min(H)/\langle H\rangle > \f$ `flatness`, whereupon `f` is
+     *   halved and the histogram is reset. Bins never visited are ignored.
+     * - **Well-tempered**: each update adds \f$ f\exp(-V/\Delta T) \f$ where
+     *   \f$V\f$ is the current bias and \f$\Delta T\f$ the bias temperature (kT).
+     *
+     * Coordinates outside the grid have infinite penalty so that trial
+     * moves leaving the range are rejected. Example:
+     *
+     * ~~~
+     * PenaltyGrid<> pen(0, 50, 0.5);  // 1D grid, z=[0:50), 0.5 A bins
+     * pen.setWangLandau(0.1, 0.8, 1e4);
+     * ...
+     * double u = pen(z);              // penalty energy (kT)
+     * pen.update(z);                  // after each MC step
+     * MPI::mergePenalty(mpi, pen);    // now and then: share with other ranks
+     * pen.save("penalty.dat");
+     * ~~~
+     */
+    template<typename Tcoord=double>
+      class PenaltyGrid {
+        private:
+          Tcoord xmin, ymin, dx, dy;
+          int nx, ny;
+          std::vector<double> bias, hist;   // accumulated bias (kT) and visits
+          std::vector<double> dbias, dhist; // changes since last merge
+          double f, flatness, dT;
+          unsigned long long cnt, Ncheck;
+          bool welltempered;
+          std::string _log;
+
+          void checkFlatness() {
+            double hmin=pc::infty, hsum=0;
+            int n=0;
+            for (size_t i=0; i<hist.size(); i++)
+              if (bias[i]!=0) {
+                hmin=std::min(hmin, hist[i]);
+                hsum+=hist[i];
+                n++;
+              }
+            if (n>0 && hsum>0 && hmin/(hsum/n) > flatness) {
+              f*=0.5;
+              std::fill(hist.begin(), hist.end(), 0);
+              std::fill(dhist.begin(), dhist.end(), 0);
+              std::ostringstream o;
+              o << "#   n=" << cnt << " flat: f=" << f << "\n";
+              _log+=o.str();
+            }
+          }
+
+        public:
+          /**
+           * @brief Constructor
+           * @param x1 Lower bound of first coordinate
+           * @param x2 Upper bound of first coordinate
+           * @param resx Resolution of first coordinate
+           * @param y1 Lower bound of second coordinate
+           * @param y2 Upper bound of second coordinate
+           * @param resy Resolution of second coordinate (zero for 1D grid, default)
+           */
+          PenaltyGrid(Tcoord x1, Tcoord x2, Tcoord resx, Tcoord y1=0, Tcoord y2=0, Tcoord resy=0)
+            : xmin(x1), ymin(y1), dx(resx), dy(resy>0 ? resy : 1), cnt(0) {
+              assert(x2>x1 && resx>0);
+              nx = std::max(1, int(std::ceil((x2-x1)/resx)));
+              ny = (resy>0) ? std::max(1, int(std::ceil((y2-y1)/resy))) : 1;
+              bias.resize(nx*ny, 0);
+              hist=dbias=dhist=bias;
+              setWangLandau(0.1);
+            }
+
+          /**
+           * @brief Use Wang-Landau updates
+           * @param penalty Initial penalty energy for each update (kT)
+           * @param flat Histogram flatness criterion (default 0.8)
+           * @param check Check flatness every `check`th update (default 1e4)
+           */
+          void setWangLandau(double penalty, double flat=0.8, unsigned long long check=1e4) {
+            welltempered=false;
+            f=penalty;
+            flatness=flat;
+            Ncheck=std::max(check, 1ull);
+            _log+="#   Wang-Landau: f=" + std::to_string(f) + "\n";
+          }
+
+          /**
+           * @brief Use well-tempered updates
+           * @param penalty Initial penalty energy for each update (kT)
+           * @param biasTemperature Bias temperature, \f$\Delta T\f$ (kT)
+           */
+          void setWellTempered(double penalty, double biasTemperature) {
+            assert(biasTemperature>0);
+            welltempered=true;
+            f=penalty;
+            dT=biasTemperature;
+            _log+="#   Well-tempered: f=" + std::to_string(f)
+              + " dT=" + std::to_string(dT) + "\n";
+          }
+
+          /** @brief Flat grid index of coordinate or -1 if outside */
+          int index(Tcoord x, Tcoord y=0) const {
+            int i = int(std::floor((x-xmin)/dx));
+            int j = (ny>1) ? int(std::floor((y-ymin)/dy)) : 0;
+            if (i<0 || i>=nx || j<0 || j>=ny)
+              return -1;
+            return i*ny+j;
+          }
+
+          /** @brief Penalty energy at coordinate (kT) - infinite if outside grid */
+          double operator()(Tcoord x, Tcoord y=0) const {
+            int i=index(x,y);
+            return (i<0) ? pc::infty : bias[i];
+          }
+
+          /** @brief Update penalty at coordinate and return added energy (kT) */
+          double update(Tcoord x, Tcoord y=0) {
+            int i=index(x,y);
+            if (i<0)
+              return 0;
+            cnt++;
+            double du = welltempered ? f*std::exp(-bias[i]/dT) : f;
+            bias[i]+=du;
+            dbias[i]+=du;
+            hist[i]++;
+            dhist[i]++;
+            if (!welltempered && cnt%Ncheck==0)
+              checkFlatness();
+            return du;
+          }
+
+          /** @brief Current penalty increment (kT) */
+          double penalty() const { return f; }
+
+          /**
+           * @brief Merge bias of several walkers, e.g. one per thread
+           *
+           * All walkers must have identical grids. Afterwards all walkers
+           * share the same bias and histogram and the smallest Wang-Landau
+           * increment.
+           */
+          static void merge(std::vector<PenaltyGrid*> &walkers) {
+            if (walkers.size()<2)
+              return;
+            std::vector<double> sb(walkers[0]->bias.size(),0), sh=sb;
+            double fmin=pc::infty;
+            for (auto w : walkers) {
+              assert(w->bias.size()==sb.size());
+              for (size_t i=0; i<sb.size(); i++) {
+                sb[i]+=w->dbias[i];
+                sh[i]+=w->dhist[i];
+              }
+              fmin=std::min(fmin, w->f);
+            }
+            for (auto w : walkers)
+              w->addRemote(sb, sh, fmin);
+          }
+
+          /** @brief Bias and histogram changes since last merge */
+          void getChanges(std::vector<double> &sumbias, std::vector<double> &sumhist) const {
+            sumbias=dbias;
+            sumhist=dhist;
+          }
+
+          /** @brief Add summed changes of all walkers, excluding own, and reset changes */
+          void addRemote(const std::vector<double> &sumbias, const std::vector<double> &sumhist, double fmin) {
+            assert(sumbias.size()==bias.size() && sumhist.size()==hist.size());
+            for (size_t i=0; i<bias.size(); i++) {
+              bias[i] += sumbias[i]-dbias[i];
+              hist[i] += sumhist[i]-dhist[i];
+            }
+            std::fill(dbias.begin(), dbias.end(), 0);
+            std::fill(dhist.begin(), dhist.end(), 0);
+            f=fmin;
+          }
+
+          /** @brief Save bias and histogram to disk as `x [y] bias hist` */
+          void save(const string &filename) const {
+            std::ofstream o(filename.c_str());
+            if (o) {
+              o.precision(10);
+              for (int i=0; i<nx; i++)
+                for (int j=0; j<ny; j++) {
+                  o << xmin+(i+0.5)*dx << " ";
+                  if (ny>1)
+                    o << ymin+(j+0.5)*dy << " ";
+                  o << bias[i*ny+j] << " " << hist[i*ny+j] << "\n";
+                }
+            }
+          }
+
+          /** @brief Load bias from disk (as written by `save()`) */
+          bool load(const string &filename) {
+            std::ifstream in(filename.c_str());
+            if (!in)
+              return false;
+            std::string line;
+            while (std::getline(in, line)) {
+              std::istringstream s(line);
+              double x, y=0, u;
+              if (ny>1)
+                s >> x >> y >> u;
+              else
+                s >> x >> u;
+              int i=index(x,y);
+              if (s && i>=0)
+                bias[i]=u;
+            }
+            return true;
+          }
+
+          string info() {
+            using namespace textio;
+            std::ostringstream o;
+            o << header("Penalty Grid")
+              << pad(SUB,25,"Grid size") << nx << "x" << ny << endl
+              << pad(SUB,25,"Scheme") << (welltempered ? "well-tempered" : "Wang-Landau") << endl
+              << pad(SUB,25,"Penalty increment") << f << kT << endl
+              << pad(SUB,25,"Number of updates") << cnt << endl
+              << indent(SUB) << "Log:" << endl << _log;
+            return o.str();
+          }
+      };
+
     template<typename Tx, typename Ty=unsigned long int>
       class Histogram : public Table2D<Tx,Ty> {
         public:
@@ -636,6 +1247,14 @@ namespace Faunus {
             }
 
 
+          /** @brief Merge with distribution sampled elsewhere, i.e. in another thread */
+          RadialDistribution& operator+=(const RadialDistribution &other) {
+            Ttable::operator+=(other);
+            bulkconc = bulkconc + other.bulkconc;
+            Npart = Npart + other.Npart;
+            return *this;
+          }
+
           template<class Tspace>
             void sample(Tspace &spc, short ida, short idb) {
               Group all(0, spc.p.size()-1);
@@ -1020,6 +1639,16 @@ namespace Faunus {
                 sample(g, spc);
           }
 
+        /** @brief Merge with multipoles sampled elsewhere, i.e. in another thread */
+        ChargeMultipole& operator+=(const ChargeMultipole &other) {
+          for (auto &m : other.Z)  Z[m.first]  = Z[m.first]  + m.second;
+          for (auto &m : other.Z2) Z2[m.first] = Z2[m.first] + m.second;
+          for (auto &m : other.mu) mu[m.first] = mu[m.first] + m.second;
+          for (auto &m : other.mu2) mu2[m.first] = mu2[m.first] + m.second;
+          cnt += other.cnt;
+          return *this;
+        }
+
         std::set<string> exclusionlist; //!< Atom names listed here will be excluded from the analysis.
     };
 
@@ -1875,6 +2504,7 @@ namespace Faunus {
       class analyzeVector {
         private:
           std::vector<T> noise;
+          std::vector<T> acf;
           int N;
           int lag;
           double mu;
@@ -1980,17 +2610,16 @@ namespace Faunus {
             return pow(x,s)*exp(-x)*sum;
           }
 
+          /**
+           * @brief Sample autocorrelation at lag k
+           *
+           * All lags are evaluated at once by FFT on first call, reducing
+           * the portmanteau tests below from O(N^2) to O(N log N).
+           */
           double sampleAutocorrelation(double k) {
-            double nom = 0;
-            double den = 0;
-            for(int t = 0; t < N-k;t++) {
-              nom += (noise[t]-mu)*(noise[t+k]-mu);
-              den += (noise[t]-mu)*(noise[t]-mu);
-            }
-            for(int t = N-k; t < N;t++) {
-              den += (noise[t]-mu)*(noise[t]-mu);
-            }
-            return (nom/den);
+            if (acf.size()!=noise.size())
+              acf = autocorrelation(noise);
+            return acf.at(int(k));
           }
 
           /**
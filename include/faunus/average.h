@@ -4,6 +4,8 @@
 #ifndef SWIG
 #include <vector>
 #include <string>
+#include <complex>
+#include <numeric>
 #endif
 
 namespace Faunus {
@@ -276,5 +278,342 @@ namespace Faunus {
       return false;
     }
 
+  /**
+   * @brief Hierarchical block averaging in logarithmic memory
+   *
+   * Samples are averaged pairwise into ever coarser blocks as they
+   * arrive (Flyvbjerg and Petersen, J. Chem. Phys. 91, 461 (1989)). Only
+   * one pending value and the sum and square sum of block means are kept
+   * for each level so that memory is O(log N) and nothing is stored.
+   * For correlated samples the naive error of the mean grows with block
+   * length until blocks are longer than the correlation time, after which
+   * it reaches a plateau: the true error. The plateau is taken as the first
+   * level where the error grows by less than the uncertainty of the error
+   * estimate, @f$\sigma/\sqrt{2(n-1)}@f$ for n blocks. Levels with fewer than
+   * `minblocks` blocks are too noisy and are ignored.
+   *
+   * Example:
+   *
+   * ~~~
+   * BlockAverage<double> u;
+   * while ( loop.macroCnt() ) {
+   *   while ( loop.microCnt() ) {
+   *     ...
+   *     u += sys.current();
+   *   }
+   *   if ( u.converged(0.1) )  // error bar below 0.1 kT?
+   *     loop.stop();
+   * }
+   * std::cout << u << " " << u.inefficiency() << endl;
+   * ~~~
+   *
+   * @date Lund 2014
+   */
+  template<class T=double>
+    class BlockAverage {
+      private:
+        struct Level {
+          Average<T> mean; //!< Block means at this level
+          T pending;       //!< First half of next block
+          bool half;       //!< True if `pending` is set
+          Level() : pending(0), half(false) {}
+        };
+        std::vector<Level> level;
+        unsigned int minblocks;
+
+        /** @brief Squared error of the mean from blocks at level l */
+        T err2(size_t l) const {
+          const Average<T> &a = level[l].mean;
+          if (a.cnt<2)
+            return 0;
+          T m = a.sum/a.cnt;
+          return std::max( T(0), a.sqsum/a.cnt - m*m ) / (a.cnt-1);
+        }
+
+        /** @brief Number of levels with enough blocks */
+        size_t usable() const {
+          size_t l=0;
+          while (l<level.size() && level[l].mean.cnt>=minblocks)
+            l++;
+          return l;
+        }
+
+        /** @brief Relative uncertainty of the error estimate at level l */
+        T uncertainty(size_t l) const {
+          return 1/std::sqrt( 2.0*(level[l].mean.cnt-1) );
+        }
+
+        /**
+         * @brief First level on the plateau, or number of usable levels if none
+         *
+         * The plateau is reached when the error no longer increases beyond
+         * its own uncertainty on going to the next level.
+         */
+        size_t plateau() const {
+          size_t n=usable();
+          for (size_t l=0; l+1<n; l++)
+            if ( std::sqrt(err2(l+1)) <= std::sqrt(err2(l))*(1+uncertainty(l)) )
+              return l;
+          return n;
+        }
+
+      public:
+        /** @param minBlocks Minimum number of blocks for a level to be used */
+        BlockAverage(unsigned int minBlocks=32) : minblocks(std::max(2u,minBlocks)) {}
+
+        /** @brief Add sample */
+        BlockAverage& operator+=(T x) {
+          for (size_t l=0; ; l++) {
+            if (l==level.size())
+              level.push_back( Level() );
+            Level &b = level[l];
+            b.mean += x;
+            if (!b.half) {
+              b.pending=x;
+              b.half=true;
+              return *this;
+            }
+            x = (b.pending+x)/2;
+            b.half=false;
+          }
+        }
+
+        void reset() { level.clear(); }                      //!< Clear all data
+        unsigned long long int cnt() const { return level.empty() ? 0 : level[0].mean.cnt; } //!< Number of samples
+        T avg() const { return level.empty() ? 0 : level[0].mean.avg(); } //!< Average
+        size_t levels() const { return level.size(); }       //!< Number of blocking levels
+
+        /** @brief Variance of the samples */
+        T variance() const {
+          return (cnt()<2) ? 0 : err2(0)*(cnt()-1);
+        }
+
+        /** @brief Error of the mean at blocking level `l` (blocks of 2^l samples) */
+        T error(size_t l) const {
+          return (l<level.size()) ? std::sqrt(err2(l)) : 0;
+        }
+
+        /** @brief Error of the mean at the plateau, or coarsest usable level if none */
+        T error() const {
+          size_t l=plateau(), n=usable();
+          if (n==0)
+            return 0;
+          return std::sqrt( err2( std::min(l,n-1) ) );
+        }
+
+        /**
+         * @brief Statistical inefficiency
+         *
+         * Number of samples per independent sample, @f$ s=N\sigma^2_{\bar{x}}/\sigma^2_x @f$,
+         * i.e. @f$ 1+2\tau @f$ where @f$\tau@f$ is the integrated correlation time.
+         */
+        T inefficiency() const {
+          T v=variance();
+          return (v>0) ? cnt()*error()*error()/v : 1;
+        }
+
+        /**
+         * @brief Poll for convergence
+         *
+         * True if blocks are longer than the correlation time, i.e. a plateau
+         * is found, and the error of the mean is below `target`.
+         */
+        bool converged(T target) const {
+          return plateau()<usable() && error()<=target;
+        }
+
+        friend std::ostream &operator<<(std::ostream &o, const BlockAverage<T> &a) {
+          o << a.avg() << " " << a.error();
+          return o;
+        }
+    };
+
+  /**
+   * @brief Multiple-tau autocorrelation in logarithmic memory
+   *
+   * Correlations are sampled on a quasi-logarithmic grid of lags.
+   * The first level correlates the last `p` samples; each following
+   * level correlates averages of `m` values from the level below and
+   * thus reaches `m` times longer lags at the same cost (Ramirez,
+   * Sukumaran, Vorselaars and Likhtman, J. Chem. Phys. 133, 154103 (2010)).
+   * Memory and cost per sample are O(p log N) and O(p), respectively,
+   * compared to O(N) for `BlockCorrelation` with a lag window of N.
+   *
+   * Example:
+   *
+   * ~~~
+   * MultipleTauCorrelation<double> c;
+   * c += x;    // in MC loop
+   * ...
+   * for (size_t i=0; i<c.size(); i++)
+   *   std::cout << c.lag(i) << " " << c[i] << "\n";
+   * ~~~
+   *
+   * @date Lund 2014
+   */
+  template<class T=double>
+    class MultipleTauCorrelation {
+      private:
+        struct Level {
+          std::vector<T> x;                  //!< Shift register, newest at `head`
+          std::vector<T> sum;                //!< Correlation sums for each lag
+          std::vector<unsigned long> cnt;    //!< Samples for each lag
+          unsigned int head, filled, nacc;
+          T acc;                             //!< Accumulator for next level
+        };
+        unsigned int p, m;
+        std::vector<Level> level;
+        Average<T> xmean;
+
+        void add(T x, size_t k) {
+          if (k==level.size()) {
+            level.push_back( Level() );
+            Level &b = level.back();
+            b.x.assign(p, 0);
+            b.sum.assign(p, 0);
+            b.cnt.assign(p, 0);
+            b.head=b.filled=b.nacc=0;
+            b.acc=0;
+          }
+          Level &b = level[k];
+          b.head = (b.head+p-1) % p;
+          b.x[b.head] = x;
+          if (b.filled<p)
+            b.filled++;
+          for (unsigned int j=(k==0 ? 0 : p/m); j<b.filled; j++) {
+            b.sum[j] += x*b.x[(b.head+j)%p];
+            b.cnt[j]++;
+          }
+          b.acc += x;
+          if (++b.nacc==m) {
+            T a = b.acc/m;
+            b.acc=0;
+            b.nacc=0;
+            add(a, k+1);
+          }
+        }
+
+        /** @brief Level and register index of i'th output point */
+        std::pair<size_t,unsigned int> locate(size_t i) const {
+          if (i<p)
+            return {0, i};
+          i-=p;
+          size_t n=p-p/m;
+          return {1+i/n, p/m+i%n};
+        }
+
+      public:
+        /**
+         * @param points Lags per level, `p`
+         * @param average Samples averaged between levels, `m` (must divide `p`)
+         */
+        MultipleTauCorrelation(unsigned int points=16, unsigned int average=2) : p(points), m(average) {
+          assert(m>1 && p>=m && p%m==0);
+        }
+
+        /** @brief Sample value */
+        MultipleTauCorrelation& operator+=(T x) {
+          xmean+=x;
+          add(x,0);
+          return *this;
+        }
+
+        /** @brief Number of lags with data */
+        size_t size() const {
+          size_t n=0;
+          for (size_t i=0; ; i++) {
+            auto l=locate(i);
+            if (l.first>=level.size() || level[l.first].cnt[l.second]==0)
+              return n;
+            n++;
+          }
+        }
+
+        /** @brief Lag, in number of samples, of i'th point */
+        unsigned long lag(size_t i) const {
+          auto l=locate(i);
+          return l.second * (unsigned long)std::pow(m, l.first);
+        }
+
+        /** @brief Normalized autocorrelation of i'th point */
+        T operator[](size_t i) const {
+          auto l=locate(i);
+          T xm=xmean.avg(), x2m=xmean.sqsum/xmean.cnt;
+          const Level &b=level.at(l.first);
+          return ( b.sum[l.second]/b.cnt[l.second] - xm*xm ) / ( x2m - xm*xm );
+        }
+
+        /** @brief Dump lag and correlation to disk */
+        bool dump(std::string filename) const {
+          std::ofstream f(filename.c_str());
+          if (f) {
+            f.precision(6);
+            for (size_t i=0; i<size(); i++)
+              f << lag(i) << " " << operator[](i) << "\n";
+            return true;
+          }
+          return false;
+        }
+    };
+
+  /** @brief In-place radix-2 fast Fourier transform (size must be a power of two) */
+  inline void fft(std::vector<std::complex<double> > &a, bool inverse=false) {
+    size_t n=a.size();
+    assert( (n&(n-1))==0 && "FFT size must be a power of two");
+    for (size_t i=1, j=0; i<n; i++) { // bit reversal permutation
+      size_t bit=n>>1;
+      for (; j&bit; bit>>=1)
+        j^=bit;
+      j^=bit;
+      if (i<j)
+        std::swap(a[i],a[j]);
+    }
+    for (size_t len=2; len<=n; len<<=1) {
+      double ang = 2*std::acos(-1.0)/len * (inverse ? 1 : -1);
+      std::complex<double> wlen( std::cos(ang), std::sin(ang) );
+      for (size_t i=0; i<n; i+=len) {
+        std::complex<double> w(1);
+        for (size_t j=0; j<len/2; j++) {
+          std::complex<double> u=a[i+j], v=a[i+j+len/2]*w;
+          a[i+j]=u+v;
+          a[i+j+len/2]=u-v;
+          w*=wlen;
+        }
+      }
+    }
+    if (inverse)
+      for (auto &i : a)
+        i/=n;
+  }
+
+  /**
+   * @brief Normalized sample autocorrelation for all lags using FFT
+   *
+   * Returns @f$ r_k = \sum_{t<N-k} \delta x_t \delta x_{t+k} / \sum_t \delta x_t^2 @f$
+   * for @f$ k=0,\ldots,N-1 @f$ with @f$ \delta x = x-\langle x\rangle @f$, computed in
+   * O(N log N) via the Wiener-Khinchin theorem and zero padding.
+   */
+  template<class T>
+    std::vector<T> autocorrelation(const std::vector<T> &x) {
+      size_t N=x.size(), n=1;
+      if (N==0)
+        return std::vector<T>();
+      while (n<2*N)
+        n<<=1;
+      T mu = std::accumulate(x.begin(), x.end(), T(0)) / N;
+      std::vector<std::complex<double> > a(n, 0.0);
+      for (size_t i=0; i<N; i++)
+        a[i]=x[i]-mu;
+      fft(a);
+      for (auto &i : a)
+        i=std::norm(i);
+      fft(a,true);
+      std::vector<T> r(N, 0);
+      if (a[0].real()>0)
+        for (size_t k=0; k<N; k++)
+          r[k] = a[k].real()/a[0].real();
+      return r;
+    }
+
 }//namespace
 #endif
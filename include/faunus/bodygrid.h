@@ -0,0 +1,297 @@
+#ifndef FAUNUS_BODYGRID_H
+#define FAUNUS_BODYGRID_H
+
+#ifndef SWIG
+#include <faunus/energy.h>
+#include <faunus/externalpotential.h>
+#endif
+
+namespace Faunus {
+
+  namespace Energy {
+
+    /**
+     * @brief Nonbonded energy with body frame potential grids for rigid molecules
+     *
+     * The potential from each rigid molecule, added with `addBody()`, is
+     * tabulated on a 3D grid in the molecule's own body frame using
+     * `Potential::ExternalGrid`, i.e. one table per species of the probing
+     * particle. The interaction of any particle outside the molecule with
+     * the whole molecule then costs a single cubic interpolation instead of a
+     * sum over all its atoms. To evaluate, the query position is transformed
+     * into the body frame, which is defined by three atoms of the molecule
+     * and thus follows any rigid rotation or translation without
+     * bookkeeping in the moves.
+     *
+     * The grid covers the molecule plus `bodygrid_pad` in each direction.
+     * Particles beyond the grid, and within `bodygrid_shell` of any atom,
+     * are summed exactly. Interpolation uses nodes up to
+     * @f$2\sqrt{3}@f$ grid spacings from the query so the shell should
+     * exceed that by the range of the steep short range repulsion.
+     *
+     * Grids are used for `i2all()`, `i2g()` and `g2g()` whenever exactly one
+     * side is a registered molecule and the other holds no registered
+     * atoms. This speeds up salt moves around large proteins and moves
+     * of a protein in salt, while molecule-molecule and intramolecular
+     * energies are summed exactly by `Tnonbonded`.
+     *
+     *     typedef Energy::NonbondedBodyGrid<Tspace,Tpairpot> Tenergy;
+     *     Tenergy pot(in);
+     *     pot.setSpace(spc);
+     *     pot.addBody(protein);  // protein is a molecular Group
+     *
+     * Keyword             | Description
+     * :------------------ | :---------------------------------------------
+     * `bodygrid_spacing`  | Grid spacing (default: 0.5 A)
+     * `bodygrid_pad`      | Grid extension beyond the atoms (default: 12 A)
+     * `bodygrid_shell`    | Exact summation within this distance from atoms (default: 6 A)
+     *
+     * @warning The molecules must be rigid and their charges fixed.
+     *          For periodic boundaries, the molecule extent plus the pair
+     *          interaction range must not exceed half the box length.
+     * @date Lund 2014
+     */
+    template<class Tspace, class Tpairpot, class Tnonbonded=Energy::Nonbonded<Tspace,Tpairpot> >
+      class NonbondedBodyGrid : public Tnonbonded {
+        private:
+          typedef Tnonbonded base;
+          typedef typename Energybase<Tspace>::Tpvec Tpvec;
+          typedef typename Energybase<Tspace>::Tparticle Tparticle;
+
+          /** @brief Exact potential from molecule template in body frame */
+          class BodyPotential : public Potential::ExternalPotentialBase<> {
+            private:
+              string _info() { return string(); }
+            public:
+              Tpairpot *pairpot;
+              Tpvec ref;
+              BodyPotential() : pairpot(nullptr) { name="Body frame"; }
+
+              template<class T>
+                double operator()(const T &a) {
+                  double u=0;
+                  for (auto &b : ref)
+                    u+=(*pairpot)(b, a, (a-b).squaredNorm());
+                  return u;
+                }
+          };
+
+          typedef Potential::ExternalGrid<BodyPotential,3> Tgrid;
+
+          struct Body {
+            int front, back;                // particle range of molecule
+            int a, b, c;                    // atoms defining the body frame
+            Eigen::Matrix3d F0;             // body frame axes (rows) at registration
+            Eigen::Vector3d lo;             // lower corner of shell mask
+            Eigen::Vector3i n;              // shell mask cells, side rshell/2
+            vector<char> shell;             // true if cell is near an atom
+            std::shared_ptr<Tgrid> grid;
+          };
+
+          std::map<int,Body> bodies;        // key: first particle
+          double spacing, padding, rshell;
+          unsigned long long int cnt_grid, cnt_exact;
+
+          string _info() {
+            using namespace Faunus::textio;
+            std::ostringstream o;
+            o << base::_info()
+              << pad(SUB,30,"Body grids") << bodies.size() << endl
+              << pad(SUB,30,"Body grid spacing") << spacing << _angstrom << endl
+              << pad(SUB,30,"Body grid exact shell") << rshell << _angstrom << endl;
+            if (cnt_grid+cnt_exact>0)
+              o << pad(SUB,30,"Body grid fraction")
+                << double(cnt_grid)/(cnt_grid+cnt_exact)*100 << percent << endl;
+            return o.str();
+          }
+
+          /** @brief Orthonormal axes (rows) spanned by two vectors */
+          static Eigen::Matrix3d frame(const Eigen::Vector3d &u, const Eigen::Vector3d &v) {
+            Eigen::Matrix3d F;
+            F.row(0) = u.normalized();
+            F.row(1) = (v - v.dot(F.row(0).transpose())*F.row(0).transpose()).normalized();
+            F.row(2) = F.row(0).cross(F.row(1));
+            return F;
+          }
+
+          /** @brief Registered molecule holding particle i, if any */
+          const Body* bodyAt(int i) const {
+            auto it = bodies.upper_bound(i);
+            if (it==bodies.begin())
+              return nullptr;
+            --it;
+            return (i<=it->second.back) ? &it->second : nullptr;
+          }
+
+          /** @brief Registered molecule matching the range of g, if any */
+          Body* bodyOf(const Group &g) {
+            auto it = bodies.find(g.front());
+            if (it!=bodies.end() && it->second.back==g.back())
+              return &it->second;
+            return nullptr;
+          }
+
+          /** @brief True if group holds atoms of any registered molecule */
+          bool holdsBody(const Group &g) const {
+            for (auto &m : bodies)
+              if (m.second.front<=g.back() && m.second.back>=g.front())
+                return true;
+            return false;
+          }
+
+          /** @brief Axes of current body frame */
+          Eigen::Matrix3d frame(const Tpvec &p, const Body &B) const {
+            return frame(
+                base::geo.vdist(p[B.b], p[B.a]).template cast<double>(),
+                base::geo.vdist(p[B.c], p[B.a]).template cast<double>() );
+          }
+
+          /** @brief Energy of particle with molecule, not belonging to it */
+          double energy(const Tpvec &p, Body &B, const Tparticle &x) {
+            Eigen::Vector3d r = B.F0.transpose() * ( frame(p,B)
+                * base::geo.vdist(x, p[B.a]).template cast<double>() );
+            Eigen::Vector3i c = ( 2*(r-B.lo)/rshell ).array().floor().template cast<int>();
+            if ( (c.array()>=0).all() && (c.array()<B.n.array()).all() )
+              if ( B.shell[ c.x() + B.n.x()*( c.y() + B.n.y()*c.z() ) ] ) {
+#pragma omp atomic
+                cnt_exact++;
+                double u=0;
+                for (int j=B.front; j<=B.back; j++)
+                  u+=base::pairpot(p[j], x, base::geo.sqdist(p[j], x));
+                return u;
+              }
+#pragma omp atomic
+            cnt_grid++;
+            Tparticle y = x;
+            y = r;
+            return (*B.grid)(y);
+          }
+
+        public:
+          NonbondedBodyGrid(InputMap &in) : base(in), cnt_grid(0), cnt_exact(0) {
+            base::name+=" + body grids";
+            spacing = in.get<double>("bodygrid_spacing", 0.5, "Body frame grid spacing (A)");
+            padding = in.get<double>("bodygrid_pad", 12.0, "Body frame grid padding (A)");
+            rshell = in.get<double>("bodygrid_shell", 6.0, "Body frame exact shell (A)");
+          }
+
+          /**
+           * @brief Register rigid molecule and set its body frame from `Space::p`
+           *
+           * Tables are built on first use for each species.
+           */
+          void addBody(Group &g) {
+            assert(base::spc!=nullptr && "Space must be set before adding bodies");
+            assert(g.size()>=3 && "Body frame requires at least three atoms");
+            const Tpvec &p = base::spc->p;
+            Body &B = bodies[g.front()];
+            B.front = g.front();
+            B.back = g.back();
+
+            // body frame atoms: a farthest from mass center, b and c=b+1
+            // spanning the largest triangle with a
+            Point cm = Geometry::massCenter(base::geo, p, g);
+            double max=-1;
+            for (auto i : g) {
+              double r2=base::geo.sqdist(p[i],cm);
+              if (r2>max) {
+                max=r2;
+                B.a=i;
+              }
+            }
+            max=-1;
+            for (auto i : g) {
+              int k = (i==g.back()) ? g.front() : i+1;
+              Eigen::Vector3d u = base::geo.vdist(p[i], p[B.a]).template cast<double>();
+              Eigen::Vector3d v = base::geo.vdist(p[k], p[B.a]).template cast<double>();
+              double s = u.cross(v).squaredNorm();
+              if (s>max) {
+                max=s;
+                B.b=i;
+                B.c=k;
+              }
+            }
+            B.F0 = frame(p,B);
+
+            // template at registration, relative to atom a
+            BodyPotential pot;
+            pot.pairpot = &this->pairpot;
+            Eigen::Vector3d lo, hi;
+            for (auto i : g) {
+              Tparticle t = p[i];
+              t = base::geo.vdist(p[i], p[B.a]);
+              pot.ref.push_back(t);
+              Eigen::Vector3d r = t.template cast<double>();
+              lo = (i==g.front()) ? r : lo.cwiseMin(r);
+              hi = (i==g.front()) ? r : hi.cwiseMax(r);
+            }
+            lo.array() -= padding;
+            hi.array() += padding;
+            B.grid = std::make_shared<Tgrid>(pot, spacing);
+            B.grid->setRange(lo,hi);
+
+            // mask cells of side rshell/2; unmarked cells are at least rshell from all atoms
+            B.lo = lo;
+            B.n = ( 2*(hi-lo)/rshell ).array().ceil().template cast<int>();
+            B.shell.assign(B.n.prod(), 0);
+            for (auto &t : pot.ref) {
+              Eigen::Vector3i c = ( 2*(t.template cast<double>()-lo)/rshell ).array().floor().template cast<int>();
+              for (int x=std::max(0,c.x()-2); x<=std::min(B.n.x()-1,c.x()+2); x++)
+                for (int y=std::max(0,c.y()-2); y<=std::min(B.n.y()-1,c.y()+2); y++)
+                  for (int z=std::max(0,c.z()-2); z<=std::min(B.n.z()-1,c.z()+2); z++)
+                    B.shell[ x + B.n.x()*( y + B.n.y()*z ) ] = 1;
+            }
+          }
+
+          double i2g(const Tpvec &p, Group &g, int j) FOVERRIDE {
+            Body *B = bodyOf(g);
+            if (B==nullptr || g.find(j) || bodyAt(j)!=nullptr)
+              return base::i2g(p,g,j);
+            return energy(p,*B,p[j]);
+          }
+
+          double i2all(Tpvec &p, int i) FOVERRIDE {
+            if (bodies.empty() || bodyAt(i)!=nullptr)
+              return base::i2all(p,i);
+            double u=0;
+            int j=0, n=(int)p.size();
+            for (auto &m : bodies) {
+              for (; j<m.second.front; j++)
+                if (j!=i)
+                  u+=base::pairpot( p[i], p[j], base::geo.sqdist(p[i],p[j]) );
+              u+=energy(p,m.second,p[i]);
+              j=m.second.back+1;
+            }
+            for (; j<n; j++)
+              if (j!=i)
+                u+=base::pairpot( p[i], p[j], base::geo.sqdist(p[i],p[j]) );
+            return u;
+          }
+
+          double g2g(const Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
+            Body *B = bodyOf(g1);
+            Group *g = &g2;
+            if (B==nullptr) {
+              B = bodyOf(g2);
+              g = &g1;
+            }
+            if (B==nullptr || g->empty() || holdsBody(*g))
+              return base::g2g(p,g1,g2);
+            double u=0;
+            for (auto j : *g)
+              u+=energy(p,*B,p[j]);
+            return u;
+          }
+
+          double i2all_bound(Tpvec &p, int i, double umax) FOVERRIDE {
+            return i2all(p,i);
+          }
+
+          double g2all_bound(const Tpvec &p, Group &g, double umax) FOVERRIDE {
+            return Energybase<Tspace>::g2all_bound(p,g,umax);
+          }
+      };
+
+  }//namespace
+}//namespace
+#endif
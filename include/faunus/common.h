@@ -27,8 +27,10 @@
 // Use explicit virtual override and final keywords (C++11)
 #ifdef NO_EXPLICIT_OVERRIDE
   #define FOVERRIDE
+  #define FFINAL
 #else
   #define FOVERRIDE override
+  #define FFINAL final
 #endif
 
 namespace Faunus {
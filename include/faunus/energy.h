@@ -9,7 +9,11 @@
 #include <faunus/space.h>
 #include <faunus/textio.h>
 #include <faunus/potentials.h>
+#include <faunus/tabulate.h>
 #include <faunus/auxiliary.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #endif
 
 namespace Faunus {
@@ -101,6 +105,31 @@ namespace Faunus {
           virtual double g2g(const Tpvec&, Group&, Group&)     // Group-Group energy
           { return 0; }
 
+          /**
+           * @brief `i2all` with early termination at `umax`
+           *
+           * Derived classes may return infinity as soon as the sum is certain
+           * to exceed `umax`, i.e. when the trial move is bound to be rejected.
+           * If not, the exact `i2all` must be returned. The default evaluates
+           * the full sum.
+           */
+          virtual double i2all_bound(Tpvec &p, int i, double umax)
+          { return i2all(p,i); }
+
+          /**
+           * @brief Energy of group `g` with all other groups, terminated at `umax`
+           *
+           * Same contract as `i2all_bound()`. The default sums `g2g()` over
+           * all groups in Space except `g` itself.
+           */
+          virtual double g2all_bound(const Tpvec &p, Group &g, double umax) {
+            double u=0;
+            for (auto gj : spc->groupList())
+              if (gj!=&g)
+                u+=g2g(p,*gj,g);
+            return u;
+          }
+
           virtual double g_external(const Tpvec&, Group&)      // External energy of group
           { return 0; }
 
@@ -116,6 +145,26 @@ namespace Faunus {
           virtual void field(const Tpvec&, Eigen::MatrixXd&) //!< Calculate electric field on all particles
           { }
 
+          /**
+           * @brief Particles that differ between `Space::trial` and `Space::p`
+           *
+           * Called by `Move::Movebase` with an empty list before each trial
+           * move, i.e. anything may change, and with the particles actually
+           * displaced (or re-charged) before the energy change is evaluated.
+           * An empty list means unknown. Energies that cache state for
+           * `Space::p` may use it to avoid scanning all particles.
+           */
+          virtual void setMoved(const std::vector<int>&)
+          { }
+
+          /**
+           * @brief Called after each move
+           * @param accepted True if `Space::p` now equals `Space::trial`, i.e. the
+           *        particles given to `setMoved()` have changed
+           */
+          virtual void update(bool accepted)
+          { }
+
           inline virtual std::string info() {
             assert(!name.empty() && "Energy name cannot be empty");
             if (_info().empty())
@@ -175,6 +224,16 @@ namespace Faunus {
           double g2g(const Tpvec&p, Group&g1, Group&g2) FOVERRIDE
           { return first.g2g(p,g1,g2)+second.g2g(p,g1,g2); }
 
+          double i2all_bound(Tpvec &p, int i, double umax) FOVERRIDE {
+            double u=second.i2all(p,i);
+            return u+first.i2all_bound(p,i,umax-u);
+          }
+
+          double g2all_bound(const Tpvec &p, Group &g, double umax) FOVERRIDE {
+            double u=second.g2all_bound(p,g,pc::infty);
+            return u+first.g2all_bound(p,g,umax-u);
+          }
+
           double g_external(const Tpvec&p, Group&g) FOVERRIDE
           { return first.g_external(p,g)+second.g_external(p,g); }
 
@@ -189,6 +248,12 @@ namespace Faunus {
 
           void field(const Tpvec&p, Eigen::MatrixXd&E) FOVERRIDE
           { first.field(p,E); second.field(p,E); }
+
+          void setMoved(const std::vector<int> &index) FOVERRIDE
+          { first.setMoved(index); second.setMoved(index); }
+
+          void update(bool accepted) FOVERRIDE
+          { first.update(accepted); second.update(accepted); }
       };
 
     /**
@@ -205,14 +270,14 @@ namespace Faunus {
     template<class Tgeometry> struct FunctorScalarDist {
       template<class Tparticle>
         inline double operator()(const Tgeometry &geo, const Tparticle &a, const Tparticle &b) const {
-          return geo.sqdist(a,b);
+          return Geometry::Policy<Tgeometry>::sqdist(geo,a,b);
         }
     };
 
     template<class Tgeometry> struct FunctorVectorDist {
       template<class Tparticle>
         Point operator()(const Tgeometry &geo, const Tparticle &a, const Tparticle &b) const {
-          return geo.vdist(a,b);
+          return Geometry::Policy<Tgeometry>::vdist(geo,a,b);
         }
     };
 
@@ -517,13 +582,13 @@ namespace Faunus {
                   if (gi!=gj) // discard identical groups (addresss comparison)
                     for (auto i : *gi)  // loop over particle index in 1st group
                       for (auto j : *gj) // loop ove
-                        E.col(i) = E.col(i) + pairpot.field(p[j],geo.vdist(p[i],p[j]));
+                        E.col(i) += pairpot.field(p[j],geo.vdist(p[i],p[j])).template cast<double>();
               } else {
               size_t i=0;
               for (auto &pi : p) {
                 for (auto &pj : p)
                   if (&pi!=&pj)
-                    E.col(i) = E.col(i) + pairpot.field(pj,geo.vdist(pi,pj));
+                    E.col(i) += pairpot.field(pj,geo.vdist(pi,pj)).template cast<double>();
                 i++;
               }
             }
@@ -533,15 +598,95 @@ namespace Faunus {
     /**
      * @brief Nonbonded with early rejection for infinite energies
      *
-     * Useful for potentials with a hard sphere part
+     * Useful for potentials with a hard sphere part. In addition,
+     * `i2all_bound()` and `g2all_bound()` terminate partial sums as soon
+     * as the energy is certain to exceed a given threshold. This requires
+     * a lower bound, `umin`, for the pair potential so that the remaining
+     * terms can be bounded. Pairs closer than `rnear` - most
+     * likely to be repulsive - are summed first, nearest first, and
+     * groups are visited in order of mass center separation.
+     *
+     * Keyword             | Description
+     * :------------------ | :------------------------------------------------
+     * `earlyreject_umin`  | Lower bound for any pair energy (kT) (default: -infinity = no truncation)
+     * `earlyreject_rnear` | Pairs within this distance are summed first (default: 0 A)
      */
     template<class Tspace, class Tpairpot, class Tnonbonded=Energy::Nonbonded<Tspace,Tpairpot> >
       class NonbondedEarlyReject : public Tnonbonded {
         private:
           typedef Tnonbonded base;
+          typedef typename Energybase<Tspace>::Tpvec Tpvec;
+          double umin, rnear2;
+          std::vector<std::pair<double,int> > near, far; // (r^2, index) within and beyond rnear
+          std::vector<std::pair<double,Group*> > order; // (r^2, group) by mass center
+
+          /** @brief True if `u` plus `n` remaining terms certainly exceeds `umax` */
+          bool exceeds(double u, double n, double umax) const {
+            return u + (n>0 ? n*umin : 0) > umax;
+          }
+
         public:
           NonbondedEarlyReject(InputMap &in) : base(in) {
             base::name+=" (early reject)";
+            umin = in.get<double>("earlyreject_umin", -pc::infty,
+                "Lower bound for pair energy (kT)");
+            rnear2 = pow( in.get<double>("earlyreject_rnear", 0,
+                  "Early rejection near shell (A)"), 2);
+          }
+
+          double i2all_bound(Tpvec &p, int i, double umax) FOVERRIDE {
+            if (umin==-pc::infty)
+              return base::i2all(p,i);
+            int n=(int)p.size();
+            double u=0, left=n-1;
+            near.clear();
+            far.clear();
+            for (int j=0; j<n; ++j)
+              if (j!=i) {
+                double r2=base::geo.sqdist(p[i],p[j]);
+                if (r2<rnear2)
+                  near.push_back( {r2,j} );
+                else
+                  far.push_back( {r2,j} );
+              }
+            std::sort(near.begin(), near.end()); // likely overlaps first
+            for (auto &m : near) {
+              u+=base::pairpot(p[i],p[m.second],m.first);
+              if (exceeds(u,--left,umax))
+                return pc::infty;
+            }
+            for (auto &m : far) {
+              u+=base::pairpot(p[i],p[m.second],m.first);
+              if (exceeds(u,--left,umax))
+                return pc::infty;
+            }
+            return u;
+          }
+
+          double g2all_bound(const Tpvec &p, Group &g, double umax) FOVERRIDE {
+            if (umin==-pc::infty || g.empty())
+              return Energybase<Tspace>::g2all_bound(p,g,umax);
+            Point cm = base::isTrial(p) ? g.cm_trial : g.cm;
+            double u=0, left=0;
+            order.clear();
+            for (auto gj : base::spc->groupList())
+              if (gj!=&g && !gj->empty()) {
+                Point cmj = base::isTrial(p) ? gj->cm_trial : gj->cm;
+                order.push_back( {base::geo.sqdist(cm,cmj), gj} );
+                left+=gj->size();
+              }
+            std::sort(order.begin(), order.end(),
+                [](const std::pair<double,Group*> &a, const std::pair<double,Group*> &b)
+                { return a.first<b.first; } );
+            left*=g.size();
+            for (auto &m : order)
+              for (auto i : *m.second)
+                for (auto j : g) {
+                  u+=base::pairpot(p[i],p[j],base::geo.sqdist(p[i],p[j]));
+                  if (exceeds(u,--left,umax))
+                    return pc::infty;
+                }
+            return u;
           }
 
           double g2g(const typename base::Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
@@ -666,14 +811,14 @@ namespace Faunus {
                   if (!cut(p,*gi,*gj))
                     for (int i : *gi)
                       for (int j : *gj)
-                        E.col(i)+=base::pairpot.field(p[j],base::geo.vdist(p[i],p[j]));
+                        E.col(i)+=base::pairpot.field(p[j],base::geo.vdist(p[i],p[j])).template cast<double>();
 
             // now loop over all internal particles in groups
             for (auto g : base::spc->groupList())
               for (int i : *g)
                 for (int j : *g)
                   if (i!=j)
-                    E.col(i)+=base::pairpot.field(p[j],base::geo.vdist(p[i],p[j]));
+                    E.col(i)+=base::pairpot.field(p[j],base::geo.vdist(p[i],p[j])).template cast<double>();
           }
       };
 
@@ -719,6 +864,732 @@ namespace Faunus {
           }
       };
 
+    /**
+     * @brief Error-controlled multipole expansion between distant molecules
+     *
+     * The electrostatic energy between two molecular groups is approximated
+     * by interacting their charge, dipole and (traceless) quadrupole moments,
+     *
+     * @f[
+     * \beta u_{AB} \approx \lambda_B \left [ \frac{q_Aq_B}{R}
+     * + \frac{q_B\boldsymbol{\mu}_A\cdot\mathbf{R} - q_A\boldsymbol{\mu}_B\cdot\mathbf{R}}{R^3}
+     * + \frac{\boldsymbol{\mu}_A\cdot\boldsymbol{\mu}_B}{R^3}
+     * - \frac{3(\boldsymbol{\mu}_A\cdot\mathbf{R})(\boldsymbol{\mu}_B\cdot\mathbf{R})}{R^5}
+     * + \frac{q_A\mathbf{R}^T\Theta_B\mathbf{R} + q_B\mathbf{R}^T\Theta_A\mathbf{R}}{R^5}
+     * \right ]
+     * @f]
+     *
+     * where @f$\mathbf{R}@f$ points from the charge center of A to that of B,
+     * and @f$\Theta=\frac{1}{2}\sum_i q_i(3\mathbf{r}_i\mathbf{r}_i^T-r_i^2\mathbf{I})@f$.
+     * This is used only if the truncation error is certainly below the
+     * threshold, @f$\epsilon@f$, i.e. if
+     *
+     * @f[
+     * \frac{\lambda_B Z_A Z_B}{R-a-b} \left ( \frac{a+b}{R} \right )^3 < \epsilon
+     * @f]
+     *
+     * where @f$Z=\sum_i|q_i|@f$ and @f$a,b@f$ are the largest distances of a
+     * charged particle from the expansion center. Otherwise the exact pair
+     * sum of `Tnonbonded` is used. Because the moments are evaluated for
+     * each group rather than for each particle pair, a group-group energy
+     * costs O(n) instead of O(n^2). Moments are cached for both `Space::p`
+     * and `Space::trial` and recalculated only for groups whose particles
+     * have moved or changed charge, so rotations and translations are
+     * handled automatically.
+     *
+     * For the expansion to be valid, `Tpairpot` must reduce to plain Coulomb
+     * beyond the closest possible particle separation, @f$R-a-b@f$; short
+     * ranged terms such as hard spheres or Lennard-Jones are neglected when
+     * this is larger than `multipole_cutoff`. In `i2all()` a particle in
+     * a molecule interacts with the multipoles of each other molecule,
+     * using the same error criterion with @f$a=0@f$ and @f$Z_A=|q_i|@f$.
+     *
+     * Keyword            | Description
+     * :----------------- | :-----------------------------------------------------
+     * `multipole_error`  | Max. truncation error per molecule pair (default: 0.01 kT)
+     * `multipole_cutoff` | Min. particle separation for using the expansion (default: 0)
+     *
+     * The Bjerrum length is read by `Potential::Coulomb`.
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace, class Tpairpot, class Tnonbonded=Energy::Nonbonded<Tspace,Tpairpot> >
+      class NonbondedMultipole : public Tnonbonded {
+        private:
+          typedef Tnonbonded base;
+          typedef typename Energybase<Tspace>::Tpvec Tpvec;
+
+          struct Moments {
+            Point center;
+            Eigen::Vector3d mu;
+            Eigen::Matrix3d theta;
+            double q, z, radius;            // net charge, sum of |q|, extent
+            vector<Point> pos;              // positions used...
+            vector<double> charge;          // ...and charges used
+          };
+
+          typedef std::map<const Group*,Moments> Tcache;
+          Tcache cache, cache_trial;
+          Potential::Coulomb coulomb;
+          double lB, eps, rmin;
+          unsigned long long int cnt_mp, cnt_exact;
+
+          string _info() {
+            using namespace Faunus::textio;
+            std::ostringstream o;
+            o << base::_info()
+              << pad(SUB,30,"Multipole error threshold") << eps << kT << endl
+              << pad(SUB,30,"Multipole min. separation") << rmin << _angstrom << endl;
+            if (cnt_mp+cnt_exact>0)
+              o << pad(SUB,30,"Multipole fraction")
+                << double(cnt_mp)/(cnt_mp+cnt_exact)*100 << percent << endl;
+            return o.str();
+          }
+
+          static bool uptodate(const Tpvec &p, const Group &g, const Moments &m) {
+            if ((int)m.pos.size()!=g.size())
+              return false;
+            int k=0;
+            for (auto i : g) {
+              if (p[i].x()!=m.pos[k].x() || p[i].y()!=m.pos[k].y()
+                  || p[i].z()!=m.pos[k].z() || p[i].charge!=m.charge[k])
+                return false;
+              k++;
+            }
+            return true;
+          }
+
+          /** @brief Charge, dipole, quadrupole and extent around charge center */
+          void calcMoments(const Tpvec &p, const Group &g, Moments &m, bool snapshot) {
+            m.q=m.z=m.radius=0;
+            m.mu.setZero();
+            m.theta.setZero();
+            m.pos.clear();
+            m.charge.clear();
+            for (auto i : g) {
+              if (snapshot) {
+                m.pos.push_back( p[i] );
+                m.charge.push_back( p[i].charge );
+              }
+              m.z+=std::fabs(p[i].charge);
+            }
+            if (m.z==0) {
+              m.center=p[g.front()];
+              return;
+            }
+            m.center = Geometry::chargeCenter(base::geo, p, g);
+            for (auto i : g)
+              if (p[i].charge!=0) {
+                Eigen::Vector3d r = base::geo.vdist(p[i], m.center).template cast<double>();
+                double q = p[i].charge, r2 = r.squaredNorm();
+                m.q += q;
+                m.mu += q*r;
+                m.theta += 0.5*q*( 3*r*r.transpose() - r2*Eigen::Matrix3d::Identity() );
+                m.radius = std::max(m.radius, r2);
+              }
+            m.radius=std::sqrt(m.radius);
+          }
+
+          /**
+           * @brief Cached moments for `Space::p` and `Space::trial`
+           *
+           * Other particle vectors, and calls from within parallel regions,
+           * are evaluated in `scratch`.
+           */
+          const Moments& moments(const Tpvec &p, const Group &g, Moments &scratch) {
+            Tcache *c = nullptr;
+            if (&p==&base::spc->p)
+              c=&cache;
+            else if (base::isTrial(p))
+              c=&cache_trial;
+#ifdef _OPENMP
+            if (omp_in_parallel())
+              c=nullptr;
+#endif
+            if (c==nullptr) {
+              calcMoments(p,g,scratch,false);
+              return scratch;
+            }
+            Moments &m = (*c)[&g];
+            if (!uptodate(p,g,m))
+              calcMoments(p,g,m,true);
+            return m;
+          }
+
+          /** @brief Multipole energy (kT) */
+          double energy(const Moments &a, const Moments &b, const Eigen::Vector3d &R) const {
+            double r2=R.squaredNorm(), r1=std::sqrt(r2), r3=r1*r2, r5=r3*r2;
+            double muaR=a.mu.dot(R), mubR=b.mu.dot(R);
+            return lB * ( a.q*b.q/r1
+                + (b.q*muaR - a.q*mubR)/r3
+                + a.mu.dot(b.mu)/r3 - 3*muaR*mubR/r5
+                + ( a.q*R.dot(b.theta*R) + b.q*R.dot(a.theta*R) )/r5 );
+          }
+
+        public:
+          NonbondedMultipole(InputMap &in) : base(in), coulomb(in), cnt_mp(0), cnt_exact(0) {
+            base::name+=" + multipoles";
+            lB = coulomb.bjerrumLength();
+            eps = in.get<double>("multipole_error", 0.01, "Multipole truncation error (kT)");
+            rmin = in.get<double>("multipole_cutoff", 0, "Multipole min. particle separation (A)");
+          }
+
+          /**
+           * @brief Multipole energy if within error threshold
+           * @return True and sets `u` if the expansion can be used
+           */
+          bool multipole(const Tpvec &p, Group &g1, Group &g2, double &u) {
+            if (!g1.isMolecular() || !g2.isMolecular() || &g1==&g2 || g1.empty() || g2.empty())
+              return false;
+            Moments sa, sb;
+            const Moments &a=moments(p,g1,sa);
+            const Moments &b=moments(p,g2,sb);
+            Point R = base::geo.vdist(b.center, a.center);
+            double r = R.norm(), ab = a.radius + b.radius;
+            if (r-ab<=rmin || r-ab<=0)
+              return false;
+            if (a.z*b.z>0)
+              if ( lB*a.z*b.z/(r-ab) * std::pow(ab/r,3) >= eps )
+                return false;
+            u = (a.z*b.z>0) ? energy(a,b,R.cast<double>()) : 0;
+            return true;
+          }
+
+          double g2g(const Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
+            double u;
+            if (multipole(p,g1,g2,u)) {
+#pragma omp atomic
+              cnt_mp++;
+              return u;
+            }
+#pragma omp atomic
+            cnt_exact++;
+            return base::g2g(p,g1,g2);
+          }
+
+          /**
+           * @brief Energy of particle `i` with the multipoles of `g` if within error threshold
+           * @return True and sets `u` if the expansion can be used
+           */
+          bool multipole(const Tpvec &p, int i, Group &g, double &u) {
+            if (!g.isMolecular() || g.empty() || g.find(i))
+              return false;
+            Moments sb;
+            const Moments &b=moments(p,g,sb);
+            Point R = base::geo.vdist(b.center, p[i]);
+            double r = R.norm(), q = p[i].charge;
+            if (r-b.radius<=rmin || r-b.radius<=0)
+              return false;
+            u=0;
+            if (q!=0 && b.z>0) {
+              if ( lB*std::fabs(q)*b.z/(r-b.radius) * std::pow(b.radius/r,3) >= eps )
+                return false;
+              Eigen::Vector3d Rd = R.cast<double>();
+              double r2=Rd.squaredNorm(), r1=std::sqrt(r2);
+              u = lB*q*( b.q/r1 - b.mu.dot(Rd)/(r1*r2) + Rd.dot(b.theta*Rd)/(r2*r2*r1) );
+            }
+            return true;
+          }
+
+          double i2all(Tpvec &p, int i) FOVERRIDE {
+            auto gi=base::spc->findGroup(i);
+            if (gi==nullptr || !gi->isMolecular())
+              return base::i2all(p,i);
+            double u=base::i2g(p,*gi,i);
+            for (auto gj : base::spc->groupList())
+              if (gj!=gi) {
+                double _u;
+                if (multipole(p,i,*gj,_u)) {
+#pragma omp atomic
+                  cnt_mp++;
+                  u+=_u;
+                } else {
+#pragma omp atomic
+                  cnt_exact++;
+                  u+=base::i2g(p,*gj,i);
+                }
+              }
+            return u;
+          }
+
+          double i2all_bound(Tpvec &p, int i, double umax) FOVERRIDE {
+            return i2all(p,i);
+          }
+
+          double g2all_bound(const Tpvec &p, Group &g, double umax) FOVERRIDE {
+            return Energybase<Tspace>::g2all_bound(p,g,umax);
+          }
+      };
+
+    /**
+     * @brief Nonbonded energy using a cell list for short ranged pair potentials
+     *
+     * Pair sums in `i2all()`, `i2g()`, `g2g()` and `g_internal()` are
+     * restricted to particles found in neighboring cells. The cell side
+     * length is at least the cut-off, `cell_cutoff`, i.e. the mass center
+     * separation beyond which all pair energies vanish. For spherocylinders
+     * this must include the particle lengths, see
+     * `Potential::CigarSphereSplit::maxRange()`.
+     *
+     * The list, `Geometry::CellList`, holds the accepted positions,
+     * `Space::p`, and is kept between calls. After each move it is updated
+     * for the particles reported to `setMoved()`, i.e. an atomic move costs
+     * a single list update. Trial energies use the list for all other
+     * particles and loop over the moved ones directly. If the moved
+     * particles are unknown, or more than a quarter of the system, per
+     * particle energies use the full loops of `Tnonbonded` while group
+     * energies compare the stored positions of the groups involved with
+     * `Space::p`, or build a list for the call. If the box holds less than
+     * three cells in any direction, or no `Space` is set, the full pair
+     * loops of `Tnonbonded` are used. Requires a geometry derived from
+     * `Geometry::Cuboid`.
+     *
+     * Keyword       | Description
+     * :------------ | :-------------------------------------------------
+     * `cell_cutoff` | Pair range defining the cell size (default: infinity, i.e. off)
+     *
+     * @note Moves that change `Space::p` while evaluating energies, i.e.
+     *       not through `Move::Movebase::move()`, must report each
+     *       change with `setMoved()` and `update()`.
+     */
+    template<class Tspace, class Tpairpot, class Tnonbonded=Energy::NonbondedVector<Tspace,Tpairpot> >
+      class NonbondedCellList : public Tnonbonded {
+        private:
+          typedef Tnonbonded base;
+          typedef typename Energybase<Tspace>::Tpvec Tpvec;
+          typedef Geometry::CellList<typename Tspace::GeometryType> Tcells;
+          double rc;
+          Tcells cells;                   // accepted positions, Space::p
+          Tcells scratch;                 // list built for a single call
+          std::vector<Point> home;        // positions stored in `cells`
+          Point len;                      // box length of `cells`
+          bool valid;                     // `cells` built for current box and particle count
+          bool dirty;                     // `cells` may differ from Space::p anywhere
+          bool known;                     // Space::trial differs from Space::p only at `moved`
+          std::vector<int> moved;         // particles changed in Space::trial
+          std::vector<char> ismoved;      // flag for each particle
+
+          /** @brief Compare stored positions with `Space::p` and update list */
+          template<class Tindex>
+            void sync(const Tindex &ndx) {
+              const Tpvec &p = base::spc->p;
+              for (auto i : ndx)
+                if (home[i]!=static_cast<const Point&>(p[i])) {
+                  cells.update(i, home[i], p[i]);
+                  home[i]=p[i];
+                }
+            }
+
+          void flag(char f) {
+            for (auto i : moved)
+              if (i>=0 && i<int(ismoved.size()))
+                ismoved[i]=f;
+          }
+
+          /** @brief Rebuild list for all particles in `Space::p` */
+          bool rebuild() {
+            const Tpvec &p = base::spc->p;
+            valid=cells.setGrid(base::geo, rc);
+            if (!valid)
+              return false;
+            cells.build(p, Group(0, int(p.size())-1));
+            home.assign(p.begin(), p.end());
+            ismoved.assign(p.size(), 0);
+            flag(1);
+            len=base::geo.len;
+            dirty=false;
+            return true;
+          }
+
+          /**
+           * @brief Prepare the persistent list for use with `p`
+           *
+           * Per particle energies (`group=false`) may be called from
+           * threads while the moved particles are unknown and must then
+           * not touch the list. Group energies instead check the positions
+           * of `ndx`.
+           *
+           * @return False if the list cannot be used for `p`
+           */
+          template<class Tindex>
+            bool ready(const Tpvec &p, const Tindex &ndx, bool group) {
+              if (base::spc==nullptr)
+                return false;
+              bool trial = (&p==&base::spc->trial);
+              if (!trial && &p!=&base::spc->p)
+                return false;
+              if (!known && (trial || !group))
+                return false;
+              if (trial && 4*moved.size()>p.size())
+                return false;
+              if (!valid || home.size()!=base::spc->p.size() || len!=base::geo.len)
+                if (!rebuild())
+                  return false;
+              if (dirty && known) {
+                sync( Group(0, int(home.size())-1) );
+                dirty=false;
+              }
+              else if (group && !known)
+                sync(ndx);
+              return true;
+            }
+
+          /** @brief Call `f(j)` for all particles in `p` near `a`, possibly including `a` itself */
+          template<class Tfunction>
+            void neighbors(const Tpvec &p, const Point &a, Tfunction f) const {
+              if (&p==&base::spc->trial) {
+                cells.forNeighbors(a, [&](int j) { if (!ismoved[j]) f(j); });
+                for (auto j : moved)
+                  f(j);
+              } else
+                cells.forNeighbors(a, f);
+            }
+
+        public:
+          NonbondedCellList(InputMap &in) : base(in), valid(false), dirty(true), known(false) {
+            static_assert(
+                std::is_base_of<Geometry::Cuboid, typename Tspace::GeometryType>::value,
+                "Cell list requires a Cuboid geometry" );
+            rc = in.get<double>("cell_cutoff", pc::infty, "Cell list pair range (angstrom)");
+            base::name+=" (cell list)";
+          }
+
+          /** @brief Set pair range defining the cell size (angstrom) */
+          void setCutoff(double cutoff) {
+            rc=cutoff;
+            valid=false;
+          }
+
+          void setSpace(Tspace &s) FOVERRIDE {
+            base::setSpace(s);
+            valid=false;
+          }
+
+          void setMoved(const std::vector<int> &index) FOVERRIDE {
+            base::setMoved(index);
+            flag(0);
+            moved=index;
+            known=!moved.empty();
+            flag(1);
+          }
+
+          /**
+           * Accepted particles reported to `setMoved()` are updated in the
+           * list. Call `update(true)` after changing `Space::p` outside of a
+           * move to have the list checked before its next use.
+           */
+          void update(bool accepted) FOVERRIDE {
+            base::update(accepted);
+            if (accepted) {
+              if (known && !moved.empty() && valid && !dirty && home.size()==base::spc->p.size())
+                sync(moved);
+              else
+                dirty=true;
+            }
+            flag(0);
+            moved.clear();
+            known=true;
+          }
+
+          double i2all(Tpvec &p, int i) FOVERRIDE {
+            Group none(0,-1);
+            if (!ready(p, none, false))
+              return base::i2all(p,i);
+            double u=0;
+            neighbors(p, p[i], [&](int j) {
+                if (j!=i)
+                  u+=base::i2i(p,i,j);
+                });
+            return u;
+          }
+
+          double i2g(const Tpvec &p, Group &g, int i) FOVERRIDE {
+            if (g.empty() || !ready(p, g, false))
+              return base::i2g(p,g,i);
+            double u=0;
+            neighbors(p, p[i], [&](int j) {
+                if (j!=i && g.find(j))
+                  u+=base::i2i(p,i,j);
+                });
+            return u;
+          }
+
+          double g_internal(const Tpvec &p, Group &g) FOVERRIDE {
+            if (g.empty())
+              return 0;
+            double u=0;
+            if (ready(p, g, true)) {
+              for (auto i : g)
+                neighbors(p, p[i], [&](int j) {
+                    if (j>i && g.find(j))
+                      u+=base::i2i(p,i,j);
+                    });
+              return u;
+            }
+            if (!scratch.setGrid(base::geo, rc))
+              return base::g_internal(p,g);
+            scratch.build(p,g);
+            for (auto i : g)
+              scratch.forNeighbors(p[i], [&](int j) {
+                  if (j>i)
+                    u+=base::i2i(p,i,j);
+                  });
+            return u;
+          }
+
+          double g2g(const Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
+            if (g1.empty() || g2.empty())
+              return 0;
+            if (g1.find(g2.front()) || g1.find(g2.back()) || g2.find(g1.front()))
+              return base::g2g(p,g1,g2); // overlapping groups
+            double u=0;
+            if (ready(p, g2, true)) {
+              for (auto i : g1)
+                neighbors(p, p[i], [&](int j) {
+                    if (g2.find(j))
+                      u+=base::i2i(p,i,j);
+                    });
+              return u;
+            }
+            if (!scratch.setGrid(base::geo, rc))
+              return base::g2g(p,g1,g2);
+            scratch.build(p,g2);
+            for (auto i : g1)
+              scratch.forNeighbors(p[i], [&](int j) { u+=base::i2i(p,i,j); });
+            return u;
+          }
+
+          double i2all_bound(Tpvec &p, int i, double umax) FOVERRIDE {
+            return i2all(p,i);
+          }
+
+          double g2all_bound(const Tpvec &p, Group &g, double umax) FOVERRIDE {
+            return Energybase<Tspace>::g2all_bound(p,g,umax);
+          }
+      };
+
+#ifdef HYPERSPHERE
+    /**
+     * @brief Nonbonded energy on the hypersphere without per-pair trigonometry
+     *
+     * `Geometry::hyperSphere::sqdist()` returns the squared geodesic
+     * distance which requires an `acos` for every pair. This class instead
+     * takes the 4D dot product, @f$\cos\theta@f$, of the contiguous
+     * `HyperPoint` coordinates and looks up the pair energy in a table
+     * indexed by the chord length,
+     *
+     * @f[ d = R\sqrt{2(1-\cos\theta)}, \quad r = 2R\arcsin(d/2R) @f]
+     *
+     * which equals the geodesic distance, @f$r@f$, at short separations.
+     * Tables use a uniform grid in @f$d@f$, i.e. the lookup is a direct
+     * index, and piecewise cubic Hermite polynomials. The spacing is halved
+     * until the error is below `hypertab_utol` everywhere. One table is
+     * built per pair of atom types found in `Space::p` when calling
+     * `setSpace()`, evaluating `Tpairpot` at the geodesic distance. Pairs
+     * closer than contact, or 1 A for point particles, further away than
+     * `hypertab_maxangle` times @f$\pi R@f$ (where @f$r(d)@f$ becomes
+     * singular), or of atom types without a table are evaluated exactly.
+     * For overlapping groups, all of `Tnonbonded` is used.
+     *
+     * Keyword              | Description
+     * :------------------- | :---------------------------------------------
+     * `hypertab_utol`      | Absolute table tolerance (default: 1e-6 kT)
+     * `hypertab_maxangle`  | Largest tabulated angle in units of pi (default: 0.9)
+     *
+     * @warning Charges and radii must follow the atom types.
+     */
+    template<class Tspace, class Tpairpot, class Tnonbonded=Energy::Nonbonded<Tspace,Tpairpot> >
+      class NonbondedHyperSphere : public Tnonbonded {
+        private:
+          typedef Tnonbonded base;
+          typedef typename Energybase<Tspace>::Tpvec Tpvec;
+          typedef typename Energybase<Tspace>::Tparticle Tparticle;
+
+          /** @brief Cubic Hermite table on a uniform grid */
+          struct Ttable {
+            double dmin, dmax, ih;
+            vector<double> c;   // four coefficients per interval
+            Ttable() : dmin(0), dmax(-1), ih(0) {}
+
+            inline double eval(double d) const {
+              double x = (d-dmin)*ih;
+              int i = int(x);
+              double t = x-i;
+              const double *ci = &c[4*i];
+              return ci[0]+t*(ci[1]+t*(ci[2]+t*ci[3]));
+            }
+          };
+
+          vector<Ttable> tables;             // index: id_a*n + id_b
+          size_t n;                          // number of atom types
+          double R, utol, maxangle;
+
+          string _info() {
+            using namespace Faunus::textio;
+            std::ostringstream o;
+            int cnt=0;
+            size_t mem=0;
+            for (size_t i=0; i<n; i++)
+              for (size_t j=i; j<n; j++)
+                if (!tables[i*n+j].c.empty()) {
+                  cnt++;
+                  mem+=tables[i*n+j].c.size()*sizeof(double);
+                }
+            o << base::_info()
+              << pad(SUB,30,"Hypersphere pair tables") << cnt << endl
+              << pad(SUB,30,"Table tolerance") << utol << kT << endl
+              << pad(SUB,30,"Table memory") << mem/1024 << " kB" << endl;
+            return o.str();
+          }
+
+          /** @brief Exact pair energy from cosine of angle */
+          double exact(const Tparticle &a, const Tparticle &b, double c) {
+            double r = R*std::acos( std::max(-1., std::min(1., c)) );
+            return base::pairpot(a,b,r*r);
+          }
+
+          /** @brief Tabulate f(d) in [dmin,dmax] to tolerance utol */
+          Ttable tabulate(std::function<double(double)> f, double dmin, double dmax) const {
+            Ttable t;
+            t.dmin = dmin;
+            for (int m=16; m<(1<<22); m*=2) {
+              double h = (dmax-dmin)/m, dd = 1e-4*h;
+              vector<double> u(m+1), du(m+1);
+              for (int i=0; i<=m; i++) {
+                double d = dmin+i*h;
+                u[i] = f(d);
+                du[i] = h*( f(d+dd)-f(d-dd) )/(2*dd);
+              }
+              t.c.resize(4*m);
+              for (int i=0; i<m; i++) {
+                t.c[4*i+0] = u[i];
+                t.c[4*i+1] = du[i];
+                t.c[4*i+2] = 3*(u[i+1]-u[i]) - 2*du[i] - du[i+1];
+                t.c[4*i+3] = 2*(u[i]-u[i+1]) + du[i] + du[i+1];
+              }
+              t.ih = 1/h;
+              t.dmax = dmin+m*h*(1-1e-12);
+              double err=0;
+              for (int i=0; i<m; i++)
+                for (double s : {0.25, 0.5, 0.75}) {
+                  double d = dmin+(i+s)*h;
+                  err = std::max(err, std::fabs(t.eval(d)-f(d)));
+                }
+              if (err<utol)
+                return t;
+            }
+            std::cerr << "Hypersphere table did not converge - increase hypertab_utol\n";
+            return Ttable();
+          }
+
+        public:
+          NonbondedHyperSphere(InputMap &in) : base(in), n(0) {
+            static_assert(
+                std::is_same<Geometry::hyperSphere, typename Tspace::GeometryType>::value,
+                "Requires a hyperSphere geometry" );
+            base::name+=" (hypersphere tables)";
+            utol = in.get<double>("hypertab_utol", 1e-6, "Hypersphere table tolerance (kT)");
+            maxangle = in.get<double>("hypertab_maxangle", 0.9, "Largest tabulated angle (pi)");
+            R = base::geo.getRadius();
+          }
+
+          /** @brief Set space and tabulate all pairs of atom types present */
+          void setSpace(Tspace &s) FOVERRIDE {
+            base::setSpace(s);
+            R = base::geo.getRadius();
+            n = atom.size();
+            tables.clear();
+            tables.resize(n*n);
+            vector<bool> present(n,false);
+            for (auto &i : s.p)
+              present.at(i.id)=true;
+            double dmax = 2*R*std::sin(maxangle*pc::pi/2);
+            for (size_t i=0; i<n; i++)
+              for (size_t j=i; j<n; j++)
+                if (present[i] && present[j]) {
+                  Tparticle a, b;
+                  a = atom[i];
+                  b = atom[j];
+                  double dmin = 2*R*std::sin( std::max(1.0, a.radius+b.radius)/(2*R) );
+                  if (dmin<dmax) {
+                    tables[i*n+j] = tabulate( [&](double d) {
+                        double r = 2*R*std::asin( std::min(1., d/(2*R)) );
+                        return base::pairpot(a,b,r*r); }, dmin, dmax );
+                    tables[j*n+i] = tables[i*n+j];
+                  }
+                }
+          }
+
+          /** @brief Particle-particle energy from the 4D dot product (kT) */
+          inline double p2p(const Tparticle &a, const Tparticle &b) FOVERRIDE {
+            double c = a.cosangle(b);
+            if (size_t(a.id)<n && size_t(b.id)<n) {
+              const Ttable &t = tables[a.id*n + b.id];
+              double d = R*std::sqrt( std::max(0., 2*(1-c)) );
+              if (d>t.dmin && d<t.dmax)
+                return t.eval(d);
+            }
+            return exact(a,b,c);
+          }
+
+          double all2p(const Tpvec &p, const Tparticle &a) FOVERRIDE {
+            double u=0;
+            for (auto &b : p)
+              u+=p2p(a,b);
+            return u;
+          }
+
+          double i2i(const Tpvec &p, int i, int j) FOVERRIDE {
+            return p2p(p[i],p[j]);
+          }
+
+          double i2g(const Tpvec &p, Group &g, int j) FOVERRIDE {
+            double u=0;
+            for (auto i : g)
+              if (i!=j)
+                u+=p2p(p[i],p[j]);
+            return u;
+          }
+
+          double i2all(Tpvec &p, int i) FOVERRIDE {
+            double u=0;
+            int len=(int)p.size();
+            for (int j=0; j<len; ++j)
+              if (j!=i)
+                u+=p2p(p[i],p[j]);
+            return u;
+          }
+
+          double g2g(const Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
+            if (g1.empty() || g2.empty())
+              return 0;
+            if (g1.find(g2.front()) || g1.find(g2.back()) || g2.find(g1.front()))
+              return base::g2g(p,g1,g2); // overlapping groups
+            double u=0;
+            int ilen=g1.back()+1, jlen=g2.back()+1;
+#pragma omp parallel for reduction (+:u)
+            for (int i=g1.front(); i<ilen; ++i)
+              for (int j=g2.front(); j<jlen; ++j)
+                u+=p2p(p[i],p[j]);
+            return u;
+          }
+
+          double g_internal(const Tpvec &p, Group &g) FOVERRIDE {
+            double u=0;
+            if (!g.empty())
+              for (int i=g.front(); i<g.back(); ++i)
+                for (int j=i+1; j<=g.back(); ++j)
+                  u+=p2p(p[i],p[j]);
+            return u;
+          }
+
+          /** @brief Pair energy from the geodesic distance, bypassing tables (kT) */
+          double p2p_exact(const Tparticle &a, const Tparticle &b) {
+            return exact(a,b,a.cosangle(b));
+          }
+      };
+#endif
+
     /**
      * @brief Class for handling bond pairs
      *
@@ -1020,7 +1891,7 @@ namespace Faunus {
           void field(const typename base::Tpvec &p, Eigen::MatrixXd &E) FOVERRIDE {
             assert((int)p.size()==E.cols());
             for (size_t i=0; i<p.size(); i++)
-              E.col(i) += expot.field(p[i]);
+              E.col(i) += expot.field(p[i]).template cast<double>();
           }
       };
 
@@ -1228,7 +2099,6 @@ namespace Faunus {
 
           std::map<string,Tuofr> uofr; // sasa energy vs. group-2-group distance
 
-          vector<bool> v;      // bool for all particles; true=active
           vector<double> sasa; // sasa for all particles
           double threshold;    // surface-surface distance threshold
           double tension, tension_dyne;
@@ -1291,6 +2161,48 @@ namespace Faunus {
             }
           }
 
+          /**
+           * @brief Active (hydrophobic and exposed) sites in group and their extent
+           *
+           * The extent, `R`, is the largest distance from the first active site,
+           * `c`, plus radius and is used to discard distant groups and sites.
+           */
+          struct Sites {
+            vector<int> index, keep;
+            Point c;
+            double R;
+            template<class Tgeo>
+              void set(const Tpvec &p, const Group &g, const vector<double> &sasa, const Tgeo &geo) {
+                index.clear();
+                R=0;
+                for (auto i : g)
+                  if (p[i].hydrophobic)
+                    if (sasa[i]>1e-3) {
+                      if (index.empty())
+                        c=p[i];
+                      index.push_back(i);
+                      R=std::max(R, geo.dist(c,p[i]) + p[i].radius);
+                    }
+              }
+            /** @brief Keep only sites that can reach within `d` of sphere `other` */
+            template<class Tgeo>
+              void prune(const Tpvec &p, const Sites &other, double d, const Tgeo &geo) {
+                keep.clear();
+                for (auto i : index)
+                  if (geo.dist(p[i],other.c) < other.R + p[i].radius + d)
+                    keep.push_back(i);
+                index.swap(keep);
+              }
+          };
+
+          /** @brief Work space for `g2g()` */
+          struct Buffers {
+            Sites s1, s2;
+            vector<char> v1, v2; // true if site not yet counted
+          };
+
+          Buffers buf; // reused outside parallel regions
+
         public:
           HydrophobicSASA(InputMap &in) {
             string pfx="sasahydro_";
@@ -1307,30 +2219,49 @@ namespace Faunus {
 
           ~HydrophobicSASA() { save(); }
 
-          /** @brief Group-to-group energy */
+          /**
+           * @brief Group-to-group energy
+           *
+           * Only active sites are considered and groups whose extents are
+           * further apart than the threshold return immediately. Otherwise sites
+           * out of reach of the other group are discarded so that only sites
+           * near the interface are tested pairwise.
+           */
           double g2g(const Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
             double dsasa=0;
             if (sasa.size()==p.size())
               if (g1.isMolecular())
                 if (g2.isMolecular()) {
-                  v.resize(p.size());
-                  std::fill(v.begin(), v.end(), true);
-                  for (auto i : g1)
-                    for (auto j : g2)
-                      if (p[i].hydrophobic)
-                        if (p[j].hydrophobic)
-                          if (sasa[i]>1e-3)
-                            if (sasa[j]>1e-3)
-                              if (v[i] || v[j]) {
-                                double r2=base::spc->geo.sqdist(p[i],p[j]);
-                                if (r2<pow(threshold+p[i].radius+p[j].radius,2)) {
-                                  if (v[i])
-                                    dsasa += sasa[i];
-                                  if (v[j])
-                                    dsasa += sasa[j];
-                                  v[i]=v[j]=false;
-                                }
-                              }
+                  auto &geo=base::spc->geo;
+                  Buffers local, *b=&buf;
+#ifdef _OPENMP
+                  if (omp_in_parallel())
+                    b=&local;
+#endif
+                  Sites &s1=b->s1, &s2=b->s2;
+                  s1.set(p,g1,sasa,geo);
+                  s2.set(p,g2,sasa,geo);
+                  if (!s1.index.empty() && !s2.index.empty())
+                    if (geo.dist(s1.c,s2.c) < s1.R+s2.R+threshold) {
+                      s1.prune(p,s2,threshold,geo); // extents, c and R, are kept
+                      s2.prune(p,s1,threshold,geo);
+                      auto &v1=b->v1, &v2=b->v2;
+                      v1.assign(s1.index.size(),true);
+                      v2.assign(s2.index.size(),true);
+                      for (size_t k=0; k<s1.index.size(); k++)
+                        for (size_t l=0; l<s2.index.size(); l++)
+                          if (v1[k] || v2[l]) {
+                            int i=s1.index[k], j=s2.index[l];
+                            double r2=geo.sqdist(p[i],p[j]);
+                            if (r2<pow(threshold+p[i].radius+p[j].radius,2)) {
+                              if (v1[k])
+                                dsasa += sasa[i];
+                              if (v2[l])
+                                dsasa += sasa[j];
+                              v1[k]=v2[l]=false;
+                            }
+                          }
+                    }
                   // analyze
                   if (sample_uofr && !base::isTrial(p)) {
                     double r = base::spc->geo.dist(g1.cm,g2.cm);
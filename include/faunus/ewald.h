@@ -1,364 +1,266 @@
 #ifndef FAUNUS_EWALD_H
 #define FAUNUS_EWALD_H
 
-#include "faunus/inputfile.h"
+#ifndef SWIG
+#include <faunus/energy.h>
 #include <complex>
+#endif
 
 namespace Faunus {
 
-  /*!
-   * @brief Ewald Summation for long-ranged electrostatics
-   *
-   * Energies are calculated using Ewald
-   * the class also contains a optimization concerning
-   * cutoff in the Fourier room
-   * Cutoff in realspace is set equal to half the box
-   *
-   * @author Martin Trulsson
-   */
-
-  template<typename T=double>
-    class Ewald {
-      private:
-        T a1,a2,a3,a4,a5,p1;
-        T boxlen, halfboxlen;
-        T lB; // Bjerrum length (AA)
-        T twopi;
-        T ewaldpres;
-        T alpha; 
-        T alphasqrt;
-        T pisqrt;
-        T Ewapre;
-        T rcut2;   // Squared real space cut-off
-        int totk;
-        vector<T> kvec;
-        vector<complex<T> > eikr, eikrold;
-        vector< vector< complex<T> > > eix, eiy, eiz, eixold, eiyold, eizold;
-        int kmax, ksqmax;
-        void kSpaceInit();//< initialize k-Space
-
-      public:
-        Ewald(InputMap&, std::string="ewald_");
-        string info();
-
-        void setVolume(T);
-
-        void store() {
-          eikrold = eikr;
-          eixold  = eix;
-          eiyold  = eiy;
-          eizold  = eiz;
-        }
-
-        void restore() {
-          swap(eikr,eikrold);
-          swap(eix,eixold);
-          swap(eiy,eiyold);
-          swap(eiz,eizold);
-        }
-
-        /** @brief Real-space particle-particle energy */
-        T rSpaceEnergy(T, T);
-
-        /** @brief Update k-vectors */
-        template<class Tpvec>
-          void kSpaceUpdate(const Tpvec&);
-
-        /** @brief Update k-vectors */
-        template<class Tpvec>
-          void kSpaceUpdate(const Tpvec&, int);
-
-        /** @brief k-space energy */
-        template<class Tpvec>
-          T kSpaceEnergy(const Tpvec&);
-
-        /** @brief k-space energy */
-        template<class Tpvec>
-          T kSpaceEnergy(const Tpvec&, int);
-
-        template<class Tpvec>
-          T selfEwald(const Tpvec&);            //< Self-Interaction
-
-        /** @brief Optimize alpha */
-        void calcAlpha(int, T=0.001);
-    };
+  namespace Energy {
+
+    /**
+     * @brief Ewald summation for long-ranged electrostatics in periodic boxes
+     *
+     * The electrostatic energy of a neutral or non-neutral `Cuboid` (not
+     * necessarily cubic) with tin-foil boundary conditions is split into
+     *
+     * @f[
+     * \beta U = \lambda_B \left [
+     * \sum_{i<j}^{r_{ij}<R_c} z_i z_j \frac{\mbox{erfc}(\alpha r_{ij})}{r_{ij}}
+     * + \frac{4\pi}{V} \sum_{\mathbf{k}>0}^{k<k_c}
+     *   \frac{e^{-k^2/4\alpha^2}}{k^2} |Q(\mathbf{k})|^2
+     * - \frac{\alpha}{\sqrt{\pi}}\sum_i z_i^2
+     * - \frac{\pi}{2V\alpha^2} \left ( \sum_i z_i \right )^2
+     * \right ]
+     * @f]
+     *
+     * where @f$Q(\mathbf{k})=\sum_i z_i e^{i\mathbf{k}\cdot\mathbf{r}_i}@f$ is
+     * summed over half of k-space. The real-space part is handled by the
+     * inherited `Nonbonded` pair loops with `Potential::CoulombEwald` while the
+     * reciprocal, self and background terms are returned by `external()`.
+     *
+     * The k-vectors and their prefactors are stored contiguously. The
+     * structure factor of the accepted configuration, `Space::p`, is kept and
+     * compared with the particle vector on each call so that only particles
+     * that were moved or had their charge changed are re-evaluated. A trial
+     * energy thus costs O(k) per moved particle, independent of system size.
+     * If the box or the number of particles changes, everything is rebuilt.
+     * Moves that insert particles outside the particle vector, i.e. grand
+     * canonical moves, are not supported.
+     *
+     * Parameters not specified are tuned to the relative accuracy
+     * @f$\epsilon@f$ so that @f$\mbox{erfc}(\alpha R_c)\approx e^{-\alpha^2R_c^2}=\epsilon@f$
+     * and @f$e^{-k_c^2/4\alpha^2}=\epsilon@f$. Without a cut-off, the cost of the
+     * real and reciprocal parts is balanced by @f$\alpha=\sqrt{\pi}(N/V^2)^{1/6}@f$
+     * (Perram, Petersen and de Leeuw, Mol. Phys. 65, 875 (1988)). The cut-off
+     * never exceeds half the shortest box side.
+     *
+     * Keyword           | Description
+     * :---------------- | :---------------------------------------------------
+     * `ewald_precision` | Relative accuracy, epsilon (default: 1e-5)
+     * `ewald_cutoff`    | Real-space cut-off (default: 0 = tune)
+     * `ewald_alpha`     | Damping parameter (default: 0 = tune)
+     * `ewald_kmax`      | Number of wave vectors along the shortest box side (default: 0 = tune)
+     *
+     * @note `Cuboid` geometry only. The remaining Coulomb keywords are
+     *       read by `Potential::Coulomb`.
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class Ewald : public Nonbonded<Tspace,Potential::CoulombEwald> {
+        private:
+          typedef Nonbonded<Tspace,Potential::CoulombEwald> base;
+          typedef typename base::Tparticle Tparticle;
+          typedef typename base::Tpvec Tpvec;
+          typedef std::complex<double> Tcomplex;
+
+          double eps, alpha, rc, kcut, lB;
+          double alpha_in, rc_in;
+          int kmax_in;
+          bool tuned;
+
+          Point box;                  // box used for the k-vectors
+          Eigen::Matrix3Xi n;         // integer wave vectors
+          Eigen::VectorXd A;          // prefactors, 4pi/V exp(-k^2/4a^2)/k^2
+          Eigen::VectorXcd Q, Qtrial; // structure factors
+          Eigen::Vector3i nmax;       // max. wave number in each direction
+          Tpvec cache;                // particles used for Q
+          double q1, q2;              // sum of charges and squared charges in cache
+          vector<Tcomplex> eix, eiy, eiz; // scratch space for one particle
+
+          string _info() {
+            using namespace Faunus::textio;
+            std::ostringstream o;
+            o << base::_info()
+              << pad(SUB,25,"Relative accuracy") << eps << endl
+              << pad(SUB,25,"Reciprocal cut-off") << kcut << " 1/"+angstrom << endl
+              << pad(SUB,25,"Max. wave numbers")
+              << nmax.x() << " " << nmax.y() << " " << nmax.z() << endl
+              << pad(SUB,25,"Number of k-vectors") << n.cols() << endl;
+            return o.str();
+          }
 
-  template<class T>
-    void Ewald<T>::kSpaceInit() {
-      int ksq;
-      T b;
-      T rkx,rky,rkz;
-      T rksq;
-      b=1./4./alpha;
-      T twopii=twopi/boxlen;
-      T vol=pow(boxlen,3);
-      totk=0;
+          /** @brief Choose alpha, cut-offs from accuracy and number of charges */
+          void tune(const Tpvec &p) {
+            const Point &len = base::geo.len;
+            double V=len.prod(), Lmin=len.minCoeff(), s=std::sqrt(-std::log(eps));
+            int N=0;
+            for (auto &i : p)
+              if (i.charge!=0)
+                N++;
+            alpha=alpha_in;
+            rc=rc_in;
+            if (rc<=0)
+              rc = (alpha>0) ? s/alpha : s/( std::sqrt(pc::pi) * std::pow(std::max(N,1)/(V*V), 1/6.) );
+            if (rc>Lmin/2)
+              rc=Lmin/2;
+            if (alpha<=0)
+              alpha=s/rc;
+            kcut = (kmax_in>0) ? 2*pc::pi*kmax_in/Lmin : 2*alpha*s;
+            base::pairpot.setParameters(alpha, rc);
+            tuned=true;
+          }
 
-      for (int kx=0; kx<(kmax+1); kx++) {      // uses symmetry
-        rkx = twopii*T(kx);
-        for (int ky=-kmax; ky<(kmax+1); ky++) {
-          rky = twopii*T(ky);
-          for (int kz=-kmax; kz<(kmax+1); kz++) {
-            rkz = twopii*T(kz);
-            ksq = kx*kx+ky*ky+kz*kz;
-            if (ksq < ksqmax && ksq!=0) {
-              totk+=1;
-              assert(totk<=2000 && "K vector too small");
-              rksq = rkx*rkx + rky*rky + rkz*rkz;
-              kvec.push_back( twopi * exp( -b*rksq ) / rksq / vol );
+          /** @brief Generate half-space k-vectors within kcut for current box */
+          void setupVectors() {
+            box=base::geo.len;
+            double V=box.prod(), kc2=kcut*kcut;
+            Point dk = 2*pc::pi*box.cwiseInverse();
+            for (int d=0; d<3; d++)
+              nmax[d] = int( kcut/dk[d] );
+            vector<Eigen::Vector3i> nvec;
+            vector<double> avec;
+            for (int nx=0; nx<=nmax.x(); nx++)
+              for (int ny=-nmax.y(); ny<=nmax.y(); ny++)
+                for (int nz=-nmax.z(); nz<=nmax.z(); nz++) {
+                  if (nx==0 && (ny<0 || (ny==0 && nz<=0)))
+                    continue; // other half, or k=0
+                  double k2 = pow(nx*dk.x(),2) + pow(ny*dk.y(),2) + pow(nz*dk.z(),2);
+                  if (k2<=kc2) {
+                    nvec.push_back( Eigen::Vector3i(nx,ny,nz) );
+                    avec.push_back( 4*pc::pi/V * std::exp(-k2/(4*alpha*alpha)) / k2 );
+                  }
+                }
+            n.resize(3, nvec.size());
+            A.resize(avec.size());
+            for (size_t k=0; k<nvec.size(); k++) {
+              n.col(k)=nvec[k];
+              A[k]=avec[k];
             }
+            eix.resize(nmax.x()+1);
+            eiy.resize(2*nmax.y()+1);
+            eiz.resize(2*nmax.z()+1);
           }
-        }
-      }
-      kvec.resize(totk);
-      eikr.resize(totk);
-      eikrold.resize(totk);
-      cout << "# Number of wavefunctions :" << totk << endl;
-    }
-
-  template<class T>
-    void Ewald<T>::setVolume(T vol) {
-      assert(vol>0);
-      boxlen=pow(vol,1/3.);
-      halfboxlen=boxlen/2;
-      kSpaceInit();
-      store();
-    }
-
-  /**
-   * @param qq particle-particle charge product
-   * @param r particle-particle distance
-   */
-  template<class T>
-    T Ewald<T>::rSpaceEnergy(T qq, T r) {
-      return  (r*r>rcut2 ? 0 :
-          qq*std::erfc(r*alphasqrt)/r );
-    }
-
-  template<class T>
-    Ewald<T>::Ewald(InputMap &in, std::string pfx) {
-      a1=0.254829592;
-      a2=-0.284496736;
-      a3=1.421413741;
-      a4=-1.453152027;
-      a5=1.061405429;
-      p1=0.3275911;
-
-      int size  = in(pfx+"size",0);
-      kmax      = in(pfx+"kmax",5);
-      alpha     = in(pfx+"alpha",0.001);
-      Ewapre    = in(pfx+"Ewapre",0.01);
-      lB        = in("bjerrum",7.12591);
-      boxlen    = in("cuboid_len",0);
-      rcut2     = in(pfx+"cutoff", boxlen/2);
-      rcut2 = pow(rcut2,2);
-      halfboxlen= boxlen/2;
-      alphasqrt=sqrt(alpha);
-      T pi=std::acos(-1.);
-      twopi = 2*pi;
-      pisqrt = sqrt(pi);
-      ksqmax=kmax*kmax+1;
-      eix.resize(size);
-      eiy.resize(size);
-      eiz.resize(size);
-      eixold.resize(size);
-      eiyold.resize(size);
-      eizold.resize(size);
-      for (int i=0; i<size; i++) {
-        eix[i].resize(kmax+1);
-        eiy[i].resize(2*kmax+1);
-        eiz[i].resize(2*kmax+1);
-        eixold[i].resize(kmax+1);
-        eiyold[i].resize(2*kmax+1);
-        eizold[i].resize(2*kmax+1);
-      }
-      kSpaceInit();
-    }
-
-  template<class T>
-    string Ewald<T>::info() {
-      std::ostringstream o;
-      o << "# kmax                    = " << kmax << endl
-        << "# Number of wavefunctions = " << totk << endl;
-      return o.str();
-    }
-
-  template<class T>
-    void Ewald<T>::calcAlpha(int size, T inewaldpression) {
-      ewaldpres=inewaldpression;
-      int i=0;
-      T incr=1e-3, A=10;
 
-      while( A > (1.+1e-10) || A < (1-1e-10)) {
-        A=sqrt(alpha) * ewaldpres / exp( -alpha*rcut2 );
-
-        if (A>1) {
-          while (A > 1.) {
-            alpha-= incr;
-            A = sqrt(alpha) * ewaldpres / exp(-alpha*rcut2);
-            i++;
-            assert(i<=10000);
+          /** @brief Add q*exp(ik.r) to structure factor using trigonometric recursion */
+          void add(Eigen::VectorXcd &S, const Point &r, double q) {
+            if (q==0)
+              return;
+            Tcomplex x( std::polar(1.0, 2*pc::pi*r.x()/box.x()) );
+            Tcomplex y( std::polar(1.0, 2*pc::pi*r.y()/box.y()) );
+            Tcomplex z( std::polar(1.0, 2*pc::pi*r.z()/box.z()) );
+            Tcomplex *ey=&eiy[nmax.y()], *ez=&eiz[nmax.z()]; // allow negative index
+            eix[0]=ey[0]=ez[0]=1;
+            for (int i=1; i<=nmax.x(); i++)
+              eix[i]=eix[i-1]*x;
+            for (int i=1; i<=nmax.y(); i++) {
+              ey[i]=ey[i-1]*y;
+              ey[-i]=std::conj(ey[i]);
+            }
+            for (int i=1; i<=nmax.z(); i++) {
+              ez[i]=ez[i-1]*z;
+              ez[-i]=std::conj(ez[i]);
+            }
+            for (int k=0; k<n.cols(); k++)
+              S[k] += q * eix[n(0,k)] * ey[n(1,k)] * ez[n(2,k)];
           }
-          assert(i<=10000);
 
-          if (A < (1.-1e-10)) {
-            alpha += 2*incr;
-            A = sqrt(alpha)*ewaldpres / exp(-alpha*rcut2);
-            incr = incr*0.1;
-          }  
-        } else {
-          while (A < 1.) {
-            alpha += incr;
-            A = sqrt(alpha)*ewaldpres / exp(-alpha*rcut2);
-            assert(i<=10000);
+          /** @brief True if position or charge differ */
+          static bool changed(const Tparticle &a, const Tparticle &b) {
+            return a.x()!=b.x() || a.y()!=b.y() || a.z()!=b.z() || a.charge!=b.charge;
           }
-          assert(i<=10000);
 
-          if (A < (1.-1e-10)) {
-            alpha += 2*incr;
-            A = sqrt(alpha)*ewaldpres / exp(-alpha*rcut2);
-            incr = incr*0.1;
+          /** @brief Rebuild structure factor from scratch */
+          void rebuild(const Tpvec &p, Eigen::VectorXcd &S, double &s1, double &s2) {
+            if (box!=base::geo.len)
+              setupVectors();
+            S.setZero(n.cols());
+            s1=s2=0;
+            for (auto &i : p) {
+              add(S, i, i.charge);
+              s1+=i.charge;
+              s2+=i.charge*i.charge;
+            }
           }
-        }
-      }
-
-      assert(alpha>=0 && "Alpha negative!");
-
-      cout << "# New alpha fit = " << alpha << endl;
-      alphasqrt=sqrt(alpha);
-
-      kmax = 1. + alpha*halfboxlen*boxlen/twopi*2.;
-      //ksqmax = (1.+alpha*halfboxlen*boxlen/twopi*2.)*(1.+alpha*halfboxlen*boxlen/twopi*2.);
-      ksqmax = kmax*kmax;
-      cout << "# New kmax fit = " << kmax << endl;
-
-      for (int i=0; i<size; i++) {
-        eix[i].resize(kmax+1);
-        eiy[i].resize(2*kmax+1);
-        eiz[i].resize(2*kmax+1);
-        eixold[i].resize(kmax+1);
-        eiyold[i].resize(2*kmax+1);
-        eizold[i].resize(2*kmax+1);
-      }
-    }
-
-  template<class T>
-    template<class Tpvec>
-    T Ewald<T>::selfEwald(const Tpvec &p) {
-      T u=0;
-      for (auto &i : p)
-        u += i.charge * i.charge;
-      return -u*lB*alphasqrt/pisqrt;
-    }
-
-  template<class T>
-    template<class Tpvec>
-    void Ewald<T>::kSpaceUpdate(const Tpvec &p) {
-      int size=p.size();
-      T twopii=twopi/boxlen;
-
-      for (int i=0; i<size; i++) {
-        eix[i][0]=complex<T>(1,0);
-        eiy[i][kmax]=complex<T>(1,0);      //kmax = defines the '0'
-        eiz[i][kmax]=complex<T>(1,0);
 
-        eix[i][1] = complex<T>( cos( twopii*p[i].x() ), sin( twopii*p[i].x() ) );
-        eiy[i][kmax+1] = complex<T>( cos( twopii*p[i].y() ), sin( twopii*p[i].y() ) );
-        eiz[i][kmax+1] = complex<T>( cos( twopii*p[i].z() ), sin( twopii*p[i].z() ) );
-
-        eiy[i][kmax-1] = conj(eiy[i][kmax+1]);
-        eiz[i][kmax-1] = conj(eiz[i][kmax+1]);
-      }
-
-      for (int kk=2; kk<(kmax+1); kk++) {
-        for (int i=0; i<size; i++) {
-          eix[i][kk]=eix[i][kk-1]*eix[i][1];
-          eiy[i][kmax+kk]=eiy[i][kmax+kk-1]*eiy[i][kmax+1];
-          eiy[i][kmax-kk]=conj(eiy[i][kmax+kk]);
-          eiz[i][kmax+kk]=eiz[i][kmax+kk-1]*eiz[i][kmax+1];
-          eiz[i][kmax-kk]=conj(eiz[i][kmax+kk]);
-        }
-      }
-    }
-
-  template<class T>
-    template<class Tpvec>
-    void Ewald<T>::kSpaceUpdate(const Tpvec &p, int j) {
-      T twopii=twopi/boxlen;
-
-      eix[j][0]    = complex<T>(1,0);
-      eiy[j][kmax] = complex<T>(1,0);
-      eiz[j][kmax] = complex<T>(1,0);
-
-      eix[j][1]      = complex<T>( cos(twopii*p[j].x() ), sin(twopii*p[j].x()) );
-      eiy[j][kmax+1] = complex<T>( cos(twopii*p[j].y() ), sin(twopii*p[j].y()) );
-      eiz[j][kmax+1] = complex<T>( cos(twopii*p[j].z() ), sin(twopii*p[j].z()) );
+          /** @brief Bring cached structure factor in sync with `Space::p` */
+          void sync() {
+            const Tpvec &p = base::spc->p;
+            if (box!=base::geo.len || cache.size()!=p.size()) {
+              rebuild(p, Q, q1, q2);
+              cache=p;
+              return;
+            }
+            for (size_t i=0; i<p.size(); i++)
+              if (changed(p[i],cache[i])) {
+                add(Q, cache[i], -cache[i].charge);
+                add(Q, p[i], p[i].charge);
+                q1+=p[i].charge-cache[i].charge;
+                q2+=p[i].charge*p[i].charge - cache[i].charge*cache[i].charge;
+                cache[i]=p[i];
+              }
+          }
 
-      eiy[j][kmax-1] = conj( eiy[j][kmax+1] ); //1+kmax = -1   2+kmax = -2 osv.
-      eiz[j][kmax-1] = conj( eiz[j][kmax+1] );
+          double energy(const Eigen::VectorXcd &S, double s1, double s2) const {
+            double V=box.prod();
+            return lB * ( (A.array()*S.array().abs2()).sum()
+                - alpha/std::sqrt(pc::pi)*s2 - pc::pi/(2*V*alpha*alpha)*s1*s1 );
+          }
 
-      for (int kk=2; kk<(kmax+1); kk++) {
-        eix[j][kk]      = eix[j][kk-1] * eix[j][1];
-        eiy[j][kmax+kk] = eiy[j][kmax+kk-1] * eiy[j][kmax+1];
-        eiy[j][kmax-kk] = conj(eiy[j][kmax+kk]);
-        eiz[j][kmax+kk] = eiz[j][kmax+kk-1] * eiz[j][kmax+1];
-        eiz[j][kmax-kk] = conj( eiz[j][kmax+kk] );
-      }
-    }
+        public:
+          Ewald(InputMap &in) : base(in), tuned(false), box(0,0,0), q1(0), q2(0) {
+            static_assert(
+                std::is_same<Geometry::Cuboid, typename Tspace::GeometryType>::value,
+                "Ewald summation requires a Cuboid geometry" );
+            base::name="Ewald summation";
+            eps = in.get<double>("ewald_precision", 1e-5, "Ewald relative accuracy");
+            rc_in = in.get<double>("ewald_cutoff", 0, "Ewald real-space cut-off (A)");
+            alpha_in = in.get<double>("ewald_alpha", 0, "Ewald damping parameter (1/A)");
+            kmax_in = in.get<int>("ewald_kmax", 0, "Ewald wave vectors along shortest side");
+            lB = base::pairpot.bjerrumLength();
+            assert(eps>0 && eps<1);
+          }
 
-  template<class T>
-    template<class Tpvec>
-    T Ewald<T>::kSpaceEnergy(const Tpvec &p) {
-      complex<T> sum;
-      int ksq;
-      T u=0, fact;
-      totk=0;
-      for (int kx=0; kx<(kmax+1); kx++) {
-        if (kx==0)
-          fact=1.;
-        else
-          fact=2.;
-        for (int ky=0; ky<(2*kmax+1); ky++) {
-          for (int kz=0; kz<(2*kmax+1); kz++) {
-            ksq=kx*kx+(ky-kmax)*(ky-kmax)+(kz-kmax)*(kz-kmax);
-            if ( ksq < ksqmax && ksq!=0 ) {
-              sum = complex<T>(0,0);
-              for (int i=0; i<(int)p.size(); i++)
-                sum += p[i].charge * eix[i][kx]*eiy[i][ky]*eiz[i][kz];
-              eikr[totk] = sum;
-              u += fact*kvec[totk]*std::real( sum*conj(sum) );
-              totk+=1;
+          /** @brief Set space and tune parameters on first call */
+          void setSpace(Tspace &s) FOVERRIDE {
+            base::setSpace(s);
+            if (!tuned) {
+              tune(s.p);
+              setupVectors();
+              cache.clear();
             }
           }
-        }
-      }
-      return u*lB;
-    }
 
-  template<class T>
-    template<class Tpvec>
-    T Ewald<T>::kSpaceEnergy(const Tpvec &p, int j) {
-      complex<T> sum;
-      T u=0, fact;
-      totk=0;
-      for (int kx=0; kx<(kmax+1); kx++) {
-        (kx==0 ? fact=1 : fact=2);
-        for (int ky=0; ky<(2*kmax+1); ky++) {
-          for (int kz=0; kz<(2*kmax+1); kz++) {
-            int ksq=kx*kx+(ky-kmax)*(ky-kmax)+(kz-kmax)*(kz-kmax);
-            if (ksq < ksqmax && ksq!=0) {
-              eikr[totk] = eikrold[totk]+p[j].charge *
-                ( eix[j][kx]*eiy[j][ky]*eiz[j][kz]
-                  - eixold[j][kx]*eiyold[j][ky]*eizold[j][kz] );
-              sum = eikr[totk];
-              u += fact*kvec[totk] * std::real( sum*conj(sum) );
-              totk+=1;
+          /** @brief Reciprocal, self and background energy (kT) */
+          double external(const Tpvec &p) FOVERRIDE {
+            assert(base::spc!=nullptr && tuned && "Call setSpace() first");
+            sync();
+            if (&p==&base::spc->p)
+              return energy(Q, q1, q2);
+            const Tpvec &pold = base::spc->p;
+            double s1=q1, s2=q2;
+            if (p.size()!=pold.size()) {
+              rebuild(p, Qtrial, s1, s2);
+              return energy(Qtrial, s1, s2);
             }
+            Qtrial=Q;
+            for (size_t i=0; i<p.size(); i++)
+              if (changed(p[i],pold[i])) {
+                add(Qtrial, pold[i], -pold[i].charge);
+                add(Qtrial, p[i], p[i].charge);
+                s1+=p[i].charge-pold[i].charge;
+                s2+=p[i].charge*p[i].charge - pold[i].charge*pold[i].charge;
+              }
+            return energy(Qtrial, s1, s2);
           }
-        }
-      }
-      return u*lB;
-    }
 
-}//namespace
+          double getAlpha() const { return alpha; }  //!< Damping parameter (1/A)
+          double getCutoff() const { return rc; }    //!< Real-space cut-off (A)
+          int numKVectors() const { return n.cols(); } //!< Number of k-vectors
+      };
+
+  }//namespace Energy
+}//namespace Faunus
 #endif
@@ -105,7 +105,7 @@ namespace Faunus {
           std::string _info();
         public:
           GouyChapman(InputMap&);          //!< Constructor
-          void setSurfPositionZ(T*);       //!< Set surface position on z-axis
+          void setSurfPositionZ(Point::Tcoord*); //!< Set surface position on z-axis
           T surfDist(const Point&);        //!< Point<->GC surface distance
           template<typename Tparticle>
             T operator()(const Tparticle&);//!< Particle<->GC interaction energy
@@ -150,7 +150,7 @@ namespace Faunus {
       }
 
     template<class T>
-      void GouyChapman<T>::setSurfPositionZ(T* z) {
+      void GouyChapman<T>::setSurfPositionZ(Point::Tcoord* z) {
         setCoordinateFunc
           (
            [=](const Point &p) { return std::abs(*z-p.z()); }
@@ -378,7 +378,7 @@ namespace Faunus {
       std::string _info();
     public:
       HydrophobicWall(InputMap&);
-      void setSurfPositionZ(T*);        // sets position of surface
+      void setSurfPositionZ(Point::Tcoord*); // sets position of surface
       template<typename Tparticle>
       T operator()(const Tparticle &p); // returns energy
     };
@@ -393,7 +393,7 @@ namespace Faunus {
     }
 
     template<class T>
-    void HydrophobicWall<T>::setSurfPositionZ(T* z) {
+    void HydrophobicWall<T>::setSurfPositionZ(Point::Tcoord* z) {
         this->setCoordinateFunc
           (
            [=](const Point &p) { return std::abs(*z-p.z()); }
@@ -455,6 +455,246 @@ namespace Faunus {
           }
       };
 
+    /**
+     * @brief Grid-interpolated external potential
+     *
+     * Any external potential, `Texpot`, is tabulated on a regular grid and
+     * evaluated by separable cubic (Catmull-Rom) spline interpolation,
+     * i.e. 4, 16 or 64 table look-ups for 1D, 2D or 3D grids. This avoids
+     * transcendental functions in the inner loops for potentials such as
+     * `GouyChapman`. The internal coordinate depends on the grid dimension:
+     *
+     * Dimension | Coordinate
+     * :-------- | :------------------------------------
+     * `D=1`     | z
+     * `D=2`     | cylindrical, \f$(\sqrt{x^2+y^2},z)\f$
+     * `D=3`     | Cartesian, (x,y,z)
+     *
+     * By default, one table (channel) is built for each atom type in
+     * `atom.list` by placing a particle with the type's properties
+     * on the grid nodes. For potentials linear in charge a single
+     * table can be built for a unit charge and scaled by the particle
+     * charge, which also respects charges changed during simulation.
+     * Tables are built on first use of each species so any setup of the
+     * wrapped potential, `potential`, must be done before that. Outside the grid, and if no
+     * range is given, the wrapped potential is evaluated directly.
+     *
+     *     typedef Potential::ExternalGrid<Potential::GouyChapman<> > Texpot;
+     *     Energy::ExternalPotential<Tspace,Texpot> pot(in);
+     *     pot.expot.potential.setSurfPositionZ( &spc.geo.len_half.z() );
+     *
+     * Keyword            | Description
+     * :----------------- | :------------------------------------------------------
+     * `extgrid_spacing`  | Grid spacing (default: 0.5 A)
+     * `extgrid_channels` | `species` or `charge` (default: `species`)
+     * `extgrid_zmin`     | Lower bound for z (default: 0); likewise `x`, `y` and `r`
+     * `extgrid_zmax`     | Upper bound for z (default: 0); likewise `x`, `y` and `r`
+     *
+     * @note The wrapped potential should be smooth on the scale of the grid
+     *       spacing; discontinuities are smeared by the interpolation.
+     * @date Lund 2014
+     */
+    template<class Texpot, int D=1>
+      class ExternalGrid : public ExternalPotentialBase<> {
+        private:
+          static_assert(D>=1 && D<=3, "Grid dimension must be 1, 2, or 3");
+          typedef Eigen::Matrix<double,D,1> Tvec;
+          typedef Eigen::Matrix<int,D,1> Tivec;
+
+          Tvec lo, hi;          // grid range
+          Tvec origin, hinv;    // position of first (ghost) node; inverse spacing
+          Tivec npts, stride;   // nodes and index stride in each dimension
+          double spacing;
+          bool bycharge;
+          std::vector<std::vector<double> > channel;
+
+          static string label(int d) {
+            const char* l[3][3] = { {"z"}, {"r","z"}, {"x","y","z"} };
+            return l[D-1][d];
+          }
+
+          /** @brief Particle position to internal coordinate */
+          static Tvec coord(const Point &a) {
+            Tvec c;
+            if (D==1)
+              c[0]=a.z();
+            else if (D==2) {
+              c[0]=std::sqrt(a.x()*a.x()+a.y()*a.y());
+              c[D-1]=a.z();
+            } else
+              for (int d=0; d<D; d++)
+                c[d]=a[d];
+            return c;
+          }
+
+          /** @brief Internal coordinate to particle position */
+          static Point position(const Tvec &c) {
+            Point a(0,0,0);
+            if (D==1)
+              a.z()=c[0];
+            else if (D==2) {
+              a.x()=c[0];
+              a.z()=c[D-1];
+            } else
+              for (int d=0; d<D; d++)
+                a[d]=c[d];
+            return a;
+          }
+
+          /** @brief Catmull-Rom weights for fractional position f */
+          static void weights(double f, double *w) {
+            double f2=f*f, f3=f2*f;
+            w[0] = 0.5*(-f3+2*f2-f);
+            w[1] = 0.5*(3*f3-5*f2+2);
+            w[2] = 0.5*(-3*f3+4*f2+f);
+            w[3] = 0.5*(f3-f2);
+          }
+
+          /**
+           * Nodes inside the range are evaluated with the wrapped potential
+           * while the ghost nodes are extrapolated (quadratic) so that the
+           * potential is never evaluated outside the given range.
+           */
+          template<class Tparticle>
+            void tabulate(const Tparticle &, int ch) {
+              long size=npts.prod();
+              std::vector<double> &v = channel[ch];
+              v.resize(size);
+              Tparticle a0;
+              if (bycharge)
+                a0.charge=1;
+              else
+                a0=atom.list[ch];
+#pragma omp parallel for
+              for (long i=0; i<size; i++) {
+                Tivec n = node(i);
+                if ((n.array()==0).any() || (n.array()==npts.array()-1).any())
+                  continue; // ghost node
+                Point r=position( origin + n.template cast<double>().cwiseQuotient(hinv) );
+                Tparticle a=a0;
+                a.x()=r.x();
+                a.y()=r.y();
+                a.z()=r.z();
+                v[i] = potential(a);
+              }
+              for (int d=0; d<D; d++) // fill ghosts, one dimension at a time
+                for (long i=0; i<size; i++) {
+                  Tivec n = node(i);
+                  if (n[d]==0)
+                    v[i] = 3*v[i+stride[d]] - 3*v[i+2*stride[d]] + v[i+3*stride[d]];
+                  else if (n[d]==npts[d]-1)
+                    v[i] = 3*v[i-stride[d]] - 3*v[i-2*stride[d]] + v[i-3*stride[d]];
+                }
+            }
+
+          /** @brief Node indices from flat index */
+          Tivec node(long i) const {
+            Tivec n;
+            for (int d=0; d<D; d++) {
+              n[d] = i % npts[d];
+              i /= npts[d];
+            }
+            return n;
+          }
+
+          std::string _info() {
+            using namespace textio;
+            std::ostringstream o;
+            o << potential.info()
+              << pad(SUB,30,"Grid dimension") << D << endl
+              << pad(SUB,30,"Grid spacing") << spacing << _angstrom << endl
+              << pad(SUB,30,"Grid channels") << (bycharge ? "charge" : "species") << endl;
+            for (int d=0; d<D; d++)
+              o << pad(SUB,30,"Grid range, "+label(d))
+                << lo[d] << " " << hi[d] << _angstrom << endl;
+            size_t n=0;
+            for (auto &v : channel)
+              n+=v.size();
+            if (n>0)
+              o << pad(SUB,30,"Grid memory") << n*sizeof(double)/1024 << " kB" << endl;
+            return o.str();
+          }
+
+        public:
+          Texpot potential; //!< Wrapped external potential
+
+          ExternalGrid(InputMap &in) : potential(in) {
+            name = potential.name + " (grid)";
+            spacing = in.get<double>("extgrid_spacing", 0.5, "External potential grid spacing (A)");
+            bycharge = ( in.get<string>("extgrid_channels", "species") == "charge" );
+            Tvec a, b;
+            for (int d=0; d<D; d++) {
+              a[d] = in.get<double>("extgrid_"+label(d)+"min", 0);
+              b[d] = in.get<double>("extgrid_"+label(d)+"max", 0);
+            }
+            setRange(a,b);
+          }
+
+          /** @brief Construct from potential and grid spacing; set range with `setRange()` */
+          ExternalGrid(const Texpot &pot, double gridspacing, bool chargechannel=false)
+            : spacing(gridspacing), bycharge(chargechannel), potential(pot) {
+            name = potential.name + " (grid)";
+            setRange(Tvec::Zero(), Tvec::Zero());
+          }
+
+          /** @brief Set grid range; tables are rebuilt on next evaluation */
+          void setRange(const Tvec &min, const Tvec &max) {
+            assert(spacing>0);
+            lo=min;
+            hi=max;
+            channel.clear();
+            for (int d=0; d<D; d++) {
+              int m = std::max( 2, int( std::ceil( (hi[d]-lo[d])/spacing ) ) );
+              hinv[d] = (hi[d]>lo[d]) ? m/(hi[d]-lo[d]) : 1/spacing;
+              origin[d] = lo[d] - 1/hinv[d]; // one ghost node on each side
+              npts[d] = m+3;
+              stride[d] = (d==0) ? 1 : stride[d-1]*npts[d-1];
+            }
+          }
+
+          template<class Tparticle>
+            double operator()(const Tparticle &p) {
+              if (bycharge && p.charge==0)
+                return 0;
+              Tvec c=coord(p);
+              for (int d=0; d<D; d++)
+                if (!(c[d]>=lo[d] && c[d]<hi[d]))
+                  return potential(p); // outside grid (or no grid)
+              int ch = bycharge ? 0 : p.id;
+              if (channel.empty())
+                channel.resize( bycharge ? 1 : atom.list.size() );
+              if (channel[ch].empty())
+                tabulate(p, ch);
+              double w[D][4];
+              long i=0;
+              for (int d=0; d<D; d++) {
+                double t = (c[d]-origin[d])*hinv[d];
+                int k = int(t);
+                weights(t-k, w[d]);
+                i += (k-1)*stride[d];
+              }
+              const double *v = &channel[ch][i];
+              double u=0;
+              if (D==1)
+                u = w[0][0]*v[0] + w[0][1]*v[1] + w[0][2]*v[2] + w[0][3]*v[3];
+              else
+                for (int z=0; z<4; z++) {
+                  double uy=0;
+                  for (int y=0; y<(D==3 ? 4 : 1); y++) {
+                    const double *r = v + z*stride[D-1] + y*stride[1];
+                    double ux = w[0][0]*r[0] + w[0][1]*r[1] + w[0][2]*r[2] + w[0][3]*r[3];
+                    uy += (D==3) ? w[1][y]*ux : ux;
+                  }
+                  u += w[D-1][z]*uy;
+                }
+              return bycharge ? p.charge*u : u;
+            }
+
+          /** @brief Field from the wrapped potential */
+          template<class Tparticle>
+            Point field(const Tparticle &p) { return potential.field(p); }
+      };
+
   } //namespace
 } //namespace
 #endif
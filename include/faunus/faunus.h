@@ -29,6 +29,9 @@
 #include <faunus/inputfile.h>
 #include <faunus/energy.h>
 #include <faunus/potentials.h>
+#include <faunus/ewald.h>
+#include <faunus/treecode.h>
+#include <faunus/bodygrid.h>
 #include <faunus/multipole.h>
 #include <faunus/externalpotential.h>
 #include <faunus/average.h>
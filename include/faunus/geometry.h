@@ -7,6 +7,7 @@
 #include <faunus/textio.h>
 #include <faunus/physconst.h>
 #include <Eigen/Geometry>
+#include <typeinfo>
 #endif
 
 namespace Faunus {
@@ -36,7 +37,7 @@ namespace Faunus {
      *       may have negative impact on performance as function inlining may not be
      *       possible. This is usually a problem only for inner loop distance calculations.
      *       To get optimum performance in inner loops use a derived class directly and do
-     *       static, compile-time polymorphism (templates).
+     *       static, compile-time polymorphism (templates), see `Geometry::Policy`.
      */
     class Geometrybase {
       private:
@@ -63,7 +64,7 @@ namespace Faunus {
         virtual void boundary(Point &) const=0;             //!< Apply boundary conditions to a point
         virtual void scale(Point&, const double&) const;    //!< Scale point to a new volume - for NPT ensemble
         virtual double sqdist(const Point &a, const Point &b) const=0; //!< Squared distance between two points
-        virtual Point vdist(const Point&, const Point&)=0;  //!< Distance in vector form
+        virtual Point vdist(const Point&, const Point&) const=0; //!< Distance in vector form
         virtual ~Geometrybase();
     };
 
@@ -81,6 +82,7 @@ namespace Faunus {
         string _info(char);
       public:
         void setRadius(double);                 //!< Set radius (angstrom)
+        double getRadius() const { return r; }  //!< Radius (angstrom)
         Sphere(double);                         //!< Construct from radius (angstrom)
         Sphere(InputMap&, string="sphere");     //!< Construct from InputMap key \c prefix_radius
         void randompos(Point &);
@@ -89,7 +91,7 @@ namespace Faunus {
         inline double sqdist(const Point &a, const Point &b) const {
           return (a-b).squaredNorm();
         }
-        inline Point vdist(const Point &a, const Point &b) { return a-b; }
+        inline Point vdist(const Point &a, const Point &b) const { return a-b; }
         void scale(Point&, const double&) const; //!< Linear scaling along radius (NPT ensemble)
     };
 
@@ -142,7 +144,7 @@ namespace Faunus {
           // return (d-k.cast<double>().cwiseProduct(len)).squaredNorm();
         }
 
-        inline Point vdist(const Point &a, const Point &b) {
+        inline Point vdist(const Point &a, const Point &b) const {
           Point r=a-b;
           if (r.x()>len_half.x())
             r.x()-=len.x();
@@ -173,7 +175,7 @@ namespace Faunus {
      * \author Chris Evers
      * \date Lund, nov 2010
      */
-    class Cuboidslit : public Cuboid {
+    class Cuboidslit FFINAL : public Cuboid {
       public:
         Cuboidslit(InputMap &);
 
@@ -186,7 +188,7 @@ namespace Faunus {
           return dx*dx + dy*dy + dz*dz;
         }   
 
-        inline Point vdist(const Point &a, const Point &b) {
+        inline Point vdist(const Point &a, const Point &b) const {
           Point r(a-b);
           if (r.x()>len_half.x())
             r.x()-=len.x();
@@ -233,7 +235,7 @@ namespace Faunus {
         inline double sqdist(const Point &a, const Point &b) const {
           return (a-b).squaredNorm();
         }
-        inline Point vdist(const Point &a, const Point &b) FOVERRIDE {
+        inline Point vdist(const Point &a, const Point &b) const FOVERRIDE {
           return a-b;
         }
     };
@@ -243,7 +245,7 @@ namespace Faunus {
      * \author Mikael Lund
      * \warning something seems rotten...
      */
-    class PeriodicCylinder : public Cylinder {
+    class PeriodicCylinder FFINAL : public Cylinder {
       public:
         PeriodicCylinder(double, double);
         PeriodicCylinder(InputMap&);
@@ -258,7 +260,7 @@ namespace Faunus {
           return dx*dx + dy*dy + dz*dz;
         }
 
-        inline Point vdist(const Point &a, const Point &b) FOVERRIDE {
+        inline Point vdist(const Point &a, const Point &b) const FOVERRIDE {
           Point r=a-b;
           if (r.z()>halflen)
             r.z()-=len;
@@ -269,42 +271,122 @@ namespace Faunus {
     };
 
 #ifdef HYPERSPHERE
-    /*  \brief HyperSphere simulation container
-     *  \author Martin Trulsson
-     *  \date Lund, 2009
+    /**
+     * @brief HyperSphere simulation container
+     *
+     * Particles live on the surface of a 4D sphere of radius @f$R@f$ and are
+     * stored as unit `HyperPoint`s. Distances are geodesic,
+     * @f$ R\theta @f$ with @f$ \cos\theta @f$ given by the 4D dot product.
+     * `sqdist()` returns the squared geodesic distance so that the generic
+     * energy classes work unchanged but it costs an `acos` per pair. Inner
+     * loops should instead use `cosangle()` and `overlap()` which avoid all
+     * per-pair trigonometry, see `Energy::NonbondedHyperSphere`.
+     *
+     * @author Martin Trulsson
+     * @date Lund, 2009
      */
-    class hyperSphere : public Sphere {
+    class hyperSphere FFINAL : public Sphere {
       private:
-        const double pi;
         string _info(char);
       public:
         hyperSphere(InputMap&);
         void randompos(Point&);
         bool collision(const particle&, collisiontype=BOUNDARY) const;
 
-        // dist() is not virtual...
-        double dist(const Point &a, const Point &b) {
-          return r*a.geodesic(b);
+        /** @brief Cosine of the angle between two points, clamped to [-1,1] */
+        inline double cosangle(const Point &a, const Point &b) const {
+          return std::max(-1., std::min(1., a.cosangle(b)));
+        }
+
+        /** @brief Geodesic distance (A) */
+        inline double dist(const Point &a, const Point &b) const {
+          return getRadius()*std::acos( cosangle(a,b) );
         }
 
         inline double sqdist(const Point &a, const Point &b) const FOVERRIDE {
-          return pow(dist(a,b),2);
+          double d=dist(a,b);
+          return d*d;
         }
 
-        bool overlap(const particle &a) {
-          for (int i=0; i<p.size(); i++)
-            if (hyperoverlap(a,p[i])==true)
-              return true;
-          return false;
+        /** @brief Cosine of the angle spanned by geodesic distance `d` */
+        inline double cosarc(double d) const {
+          double t=d/getRadius(), t2=t*t;
+          if (t>0.5)
+            return std::cos(t);
+          return 1-t2/2*(1-t2/12*(1-t2/30*(1-t2/56*(1-t2/90))));
         }
 
-        inline bool hyperoverlap(const particle &a, const particle &b) {
-          return (r*a.geodesic(b)<a.radius+b.radius);
+        /**
+         * @brief Hard sphere overlap without inverse trigonometry
+         *
+         * The geodesic distance is below the contact distance
+         * @f$ d @f$ if @f$ \cos\theta > \cos(d/R) @f$. For contact angles
+         * below 0.5 the right hand side is a truncated series accurate
+         * to @f$10^{-12}@f$.
+         */
+        inline bool overlap(const particle &a, const particle &b) const {
+          return a.cosangle(b) > cosarc(a.radius+b.radius);
         }
     };
 
 #endif
 
+    /**
+     * @brief Compile-time geometry policy for inner loops
+     *
+     * Binds the distance and boundary functions of a concrete geometry
+     * statically, i.e. without going through the virtual table. This lets
+     * the compiler inline and vectorize for example `Cuboid::sqdist` in
+     * pair loops while the virtual interface of `Geometrybase` remains for
+     * setup code. Templates that receive the geometry by reference should
+     * call through this class:
+     *
+     *     template<class Tgeometry>
+     *       double f(const Tgeometry &geo, const Point &a, const Point &b) {
+     *         return Geometry::Policy<Tgeometry>::sqdist(geo,a,b);
+     *       }
+     *
+     * The dynamic type of the geometry must be exactly `Tgeometry`, which is
+     * always the case for `Space::geo` (checked in debug mode). If
+     * `Tgeometry` is abstract, e.g. `Geometrybase`, the calls are virtual.
+     */
+    template<class Tgeometry, bool=std::is_abstract<Tgeometry>::value>
+      struct Policy {
+        static inline double sqdist(const Tgeometry &g, const Point &a, const Point &b) {
+          assert(typeid(g)==typeid(Tgeometry) && "Geometry policy type mismatch");
+          return g.Tgeometry::sqdist(a,b);
+        }
+        static inline Point vdist(const Tgeometry &g, const Point &a, const Point &b) {
+          assert(typeid(g)==typeid(Tgeometry) && "Geometry policy type mismatch");
+          return g.Tgeometry::vdist(a,b);
+        }
+        static inline void boundary(const Tgeometry &g, Point &a) {
+          assert(typeid(g)==typeid(Tgeometry) && "Geometry policy type mismatch");
+          g.Tgeometry::boundary(a);
+        }
+        static inline bool collision(const Tgeometry &g, const particle &a,
+            Geometrybase::collisiontype type=Geometrybase::BOUNDARY) {
+          assert(typeid(g)==typeid(Tgeometry) && "Geometry policy type mismatch");
+          return g.Tgeometry::collision(a,type);
+        }
+      };
+
+    /** @brief Virtual fall-back for abstract geometries */
+    template<class Tgeometry>
+      struct Policy<Tgeometry,true> {
+        static inline double sqdist(const Tgeometry &g, const Point &a, const Point &b) {
+          return g.sqdist(a,b);
+        }
+        static inline Point vdist(const Tgeometry &g, const Point &a, const Point &b) {
+          return g.vdist(a,b);
+        }
+        static inline void boundary(const Tgeometry &g, Point &a) { g.boundary(a); }
+        static inline bool collision(const Tgeometry &g, const particle &a,
+            Geometrybase::collisiontype type=Geometrybase::BOUNDARY) {
+          return g.collision(a,type);
+        }
+      };
+
     /**
      * @brief Calculate center of cluster of particles
      * @param geo Geometry
@@ -324,16 +406,17 @@ namespace Faunus {
         Point cm(0,0,0);
         if (!g.empty()) {
           Point o = p[ g.front()+(g.back()-g.front())*0.5 ];  // set origo to middle particle
+          Eigen::Vector3d s(0,0,0); // sum in double, also for float coordinates
           double sum=0;
           for (auto i : g) {
             Point t = p[i]-o;       // translate to origo
-            geo.boundary(t);        // periodic boundary (if any)
-            cm += t * weight(p[i]);
+            Policy<Tgeo>::boundary(geo,t); // periodic boundary (if any)
+            s += t.cast<double>() * weight(p[i]);
             sum += weight(p[i]);
           }
           if (fabs(sum)<1e-6) sum=1;
-          cm=cm/sum + o;
-          geo.boundary(cm);
+          cm=s/sum + o.cast<double>();
+          Policy<Tgeo>::boundary(geo,cm);
         }
         return cm;
       }
@@ -392,7 +475,7 @@ namespace Faunus {
       void translate(const Tgeo &geo, Tpvec &p, const Point &d) {
         for (auto &pi : p) {
           pi += d;
-          geo.boundary(pi);
+          Policy<Tgeo>::boundary(geo,pi);
         }
       }
 
@@ -431,7 +514,7 @@ namespace Faunus {
               for (auto &i : p1)
                 for (auto &j : p2) {
                   double max=i.radius+j.radius;
-                  if ( geo.sqdist(i,j)<max*max )
+                  if ( Policy<Tgeometry>::sqdist(geo,i,j)<max*max )
                     return true;
                 }
             return false;
@@ -441,7 +524,7 @@ namespace Faunus {
           bool containerOverlap(const Tgeometry &geo, const Tpvec &p) const {
             if (allowContainerOverlap==false)
               for (auto &i : p)
-                if (geo.collision(i)) return true;
+                if (Policy<Tgeometry>::collision(geo,i)) return true;
             return false;
           }
 
@@ -488,14 +571,19 @@ namespace Faunus {
     /**
      * @brief Quaternion rotation routine using the Eigen library
      * @note Boundary condition are respected.
+     *
+     * Boundaries are applied via `Policy<Tgeometry>` so that a concrete
+     * geometry type avoids virtual calls for each rotated particle.
+     * `QuaternionRotate` uses the polymorphic `Geometrybase`.
      */
-    class QuaternionRotate {
+    template<class Tgeometry=Geometrybase>
+    class QuaternionRotateBase {
       private:
         double angle_;
         Eigen::Vector3d origin;
         Eigen::Quaterniond q;
         Eigen::Matrix3d rot_mat; // rotation matrix
-        Geometrybase *geoPtr;
+        const Tgeometry *geoPtr;
 
       public:
         //!< Get rotation origin
@@ -509,7 +597,7 @@ namespace Faunus {
 
         bool ignoreBoundaries;
 
-        QuaternionRotate() {
+        QuaternionRotateBase() : geoPtr(nullptr) {
           ignoreBoundaries=false;
         }
 
@@ -520,16 +608,15 @@ namespace Faunus {
          * @param end Ending point for vector to rotate around
          * @param angle Radians to rotate
          */
-        inline void setAxis(Geometrybase &g, const Point &beg, const Point &end, double angle) {
-          assert(&g!=nullptr && "Invalid geometry");
+        inline void setAxis(const Tgeometry &g, const Point &beg, const Point &end, double angle) {
           geoPtr=&g;
-          origin=beg;
+          origin=beg.cast<double>();
           angle_=angle;
           Point u(end-beg); //Point u(end-beg);
           assert(u.squaredNorm()>0 && "Rotation vector has zero length");
-          g.boundary(u);
+          Policy<Tgeometry>::boundary(g,u);
           u.normalize(); // make unit vector
-          q=Eigen::AngleAxisd(angle, u);
+          q=Eigen::AngleAxisd(angle, u.cast<double>());
 
           rot_mat << 0, -u.z(), u.y(),u.z(),0,-u.x(),-u.y(),u.x(),0;
           rot_mat = Eigen::Matrix3d::Identity() + rot_mat*std::sin(angle) + rot_mat*rot_mat*(1-std::cos(angle));
@@ -538,20 +625,23 @@ namespace Faunus {
         /** @brief Rotate point - respect boundaries */
         inline Point operator()(Point a) const {
           if(ignoreBoundaries)
-            return q*a;
-          a=a-origin;
-          geoPtr->boundary(a);
-          a=q*a+origin;
-          geoPtr->boundary(a);
+            return q*a.cast<double>();
+          a=a-origin.cast<Point::Tcoord>();
+          Policy<Tgeometry>::boundary(*geoPtr,a);
+          a=q*a.cast<double>()+origin;
+          Policy<Tgeometry>::boundary(*geoPtr,a);
           return a;
         }
 
-        inline Eigen::Matrix3d operator()(Eigen::Matrix3d a) const {
-          a = rot_mat*a*rot_mat.transpose();
-          return a;
-        }
+        template<typename T>
+          inline Eigen::Matrix<T,3,3> operator()(Eigen::Matrix<T,3,3> a) const {
+            a = rot_mat.cast<T>()*a*rot_mat.cast<T>().transpose();
+            return a;
+          }
     };
 
+    typedef QuaternionRotateBase<> QuaternionRotate;
+
     /**
      * @brief Calculates the volume of a collection of particles
      *
@@ -592,6 +682,101 @@ namespace Faunus {
         return hit/double(cnt) * pow(L,3);
       }
 
+    /**
+     * @brief Cell list for finding neighbors in periodic boxes
+     *
+     * The box is divided into cells with side lengths no smaller than
+     * a given cut-off so that all pairs closer than the cut-off are found
+     * in the 27 cells surrounding a particle. Cells are stored as a sorted
+     * vector of (cell, particle index) pairs, i.e. memory scales with the
+     * number of particles rather than the number of cells.
+     * `Tgeometry` must be derived from `Cuboid`.
+     *
+     *     Geometry::CellList<Geometry::Cuboid> cells;
+     *     if (cells.setGrid(geo, 10.0)) {       // false if less than 3 cells
+     *       cells.build(p, g);                  // g is a range of indices
+     *       cells.forNeighbors(p[i], [&](int j) { ... });
+     *     }
+     */
+    template<class Tgeometry>
+      class CellList {
+        private:
+          typedef Eigen::Vector3i Tcell;
+          Tcell n;                              // number of cells in each direction
+          Point clen, len_half;                 // cell side lengths; half box length
+          std::vector<std::pair<long,int> > cell; // (cell index, particle index), sorted
+
+          Tcell coord(const Point &a) const {
+            Tcell c;
+            for (int d=0; d<3; d++) {
+              c[d] = int( std::floor( (a[d]+len_half[d])/clen[d] ) );
+              c[d] = std::min( std::max(c[d],0), n[d]-1 );
+            }
+            return c;
+          }
+
+          long index(Tcell c) const {
+            for (int d=0; d<3; d++)
+              c[d] = (c[d]+n[d]) % n[d];
+            return ( long(c[0])*n[1] + c[1] )*n[2] + c[2];
+          }
+
+        public:
+          /** @brief Set cell grid for cut-off `rc`; false if less than three cells in a direction */
+          bool setGrid(const Tgeometry &geo, double rc) {
+            if (rc>=pc::infty || rc<=0)
+              return false;
+            len_half=geo.len_half;
+            for (int d=0; d<3; d++) {
+              n[d] = int(geo.len[d]/rc);
+              if (n[d]<3)
+                return false;
+              clen[d] = geo.len[d]/n[d];
+            }
+            return true;
+          }
+
+          /** @brief Sort particles with given indices into cells */
+          template<class Tpvec, class Tindex>
+            void build(const Tpvec &p, const Tindex &ndx) {
+              cell.clear();
+              cell.reserve(ndx.size());
+              for (auto i : ndx)
+                cell.push_back( {index(coord(p[i])), i} );
+              std::sort(cell.begin(), cell.end());
+            }
+
+          /** @brief Move particle `i` in the list from position `from` to `to` */
+          void update(int i, const Point &from, const Point &to) {
+            long a=index(coord(from)), b=index(coord(to));
+            if (a==b)
+              return;
+            auto it=std::lower_bound(cell.begin(), cell.end(), std::make_pair(a,i));
+            assert(it!=cell.end() && it->second==i && "Particle not in cell list");
+            cell.erase(it);
+            auto pair=std::make_pair(b,i);
+            cell.insert(std::lower_bound(cell.begin(), cell.end(), pair), pair);
+          }
+
+          /** @brief Smallest cell side length */
+          double cellLength() const { return clen.minCoeff(); }
+
+          /** @brief Call `f(j)` for all particles in the 27 cells around `a` */
+          template<class Tfunction>
+            void forNeighbors(const Point &a, Tfunction f) const {
+              Tcell c=coord(a);
+              for (int dx=-1; dx<=1; dx++)
+                for (int dy=-1; dy<=1; dy++)
+                  for (int dz=-1; dz<=1; dz++) {
+                    long k=index( c+Tcell(dx,dy,dz) );
+                    auto it=std::lower_bound(cell.begin(), cell.end(),
+                        std::make_pair(k, std::numeric_limits<int>::min()));
+                    for (; it!=cell.end() && it->first==k; ++it)
+                      f(it->second);
+                  }
+            }
+      };
+
   }//namespace Geometry
 }//namespace Faunus
 #endif
@@ -133,11 +133,11 @@ namespace Faunus {
       template<class Tspace>
         void rotate(Tspace &spc, const Point &endpoint, double angle) {
           assert( spc.geo.dist(cm,massCenter(spc) )<1e-6 );
-          Geometry::QuaternionRotate vrot1;
+          Geometry::QuaternionRotateBase<typename Tspace::GeometryType> vrot1;
           cm_trial = cm;
           vrot1.setAxis(spc.geo, cm, endpoint, angle);//rot around CM->point vec
           auto vrot2 = vrot1;
-          vrot2.getOrigin() = Point(0,0,0);
+          vrot2.getOrigin().setZero();
           for (auto i : *this) {
             spc.trial[i] = vrot1(spc.trial[i]); // rotate coordinates
             spc.trial[i].rotate(vrot2);         // rotate internal coordinates
@@ -306,6 +306,121 @@ namespace Faunus {
         }
   };
 
+  /**
+   * @brief Rigid body pose of a molecular group
+   *
+   * Stores the particle positions of a rigid group relative to its mass
+   * center in a body frame, together with the current and trial
+   * orientation. Rotations and translations of the group then only modify
+   * the pose (`Group::cm_trial` and `q_trial`) while lab frame coordinates
+   * are generated from the template by `materialize()`. Since positions
+   * are always regenerated from the same template, the internal geometry
+   * of the group does not drift due to accumulated rounding errors.
+   *
+   * ~~~
+   * RigidBody body;
+   * body.setTemplate(spc.geo, spc.p, g);  // g is the current pose
+   * body.rotate(u, angle);                // trial orientation
+   * g.cm_trial.translate(spc.geo, dr);    // trial position
+   * body.materialize(spc.geo, g, g.cm_trial, spc.trial);
+   * ~~~
+   *
+   * Moves that change the group by other means invalidate the template.
+   * This is detected by `uptodate()`, comparing with the lab frame
+   * positions of the last accepted pose, whereafter `setTemplate()` must
+   * be called again.
+   */
+  class RigidBody {
+    private:
+      std::vector<Eigen::Vector3d> ref; // body frame positions relative to mass center
+      std::vector<Point> lab;           // lab frame positions of current pose
+
+      template<class Tpvec>
+        void sync(const Tpvec &p, const Group &g) {
+          lab.resize(g.size());
+          auto l = lab.begin();
+          for (auto i : g)
+            *l++ = p[i];
+        }
+
+    public:
+      Eigen::Quaterniond q;             //!< Current orientation
+      Eigen::Quaterniond q_trial;       //!< Trial orientation
+
+      RigidBody() : q(Eigen::Quaterniond::Identity()), q_trial(q) {}
+
+      /** @brief Number of particles in template */
+      inline size_t size() const { return ref.size(); }
+
+      /** @brief Set body frame from current positions and mass center of group */
+      template<class Tgeometry, class Tpvec>
+        void setTemplate(const Tgeometry &geo, const Tpvec &p, const Group &g) {
+          ref.clear();
+          ref.reserve(g.size());
+          for (auto i : g)
+            ref.push_back( Geometry::Policy<Tgeometry>::vdist(geo, p[i], g.cm).template cast<double>() );
+          q = q_trial = Eigen::Quaterniond::Identity();
+          sync(p,g);
+        }
+
+      /** @brief True if the group positions in `p` are those of the current pose */
+      template<class Tpvec>
+        bool uptodate(const Tpvec &p, const Group &g) const {
+          if ((int)lab.size()!=g.size())
+            return false;
+          auto l = lab.begin();
+          for (auto i : g) {
+            if (p[i].x()!=l->x() || p[i].y()!=l->y() || p[i].z()!=l->z())
+              return false;
+            ++l;
+          }
+          return true;
+        }
+
+      /**
+       * @brief Rotate trial orientation
+       * @param u Unit vector to rotate around (through mass center)
+       * @param angle Angle [rad]
+       */
+      void rotate(const Point &u, double angle) {
+        q_trial = Eigen::AngleAxisd(angle, u.cast<double>()) * q;
+        q_trial.normalize();
+      }
+
+      /**
+       * @brief Write lab frame positions of trial pose to particle vector
+       * @param geo Geometry for boundary conditions
+       * @param g Group to write
+       * @param cm Mass center of pose
+       * @param p Destination particle vector. Only positions are set.
+       */
+      template<class Tgeometry, class Tpvec>
+        void materialize(const Tgeometry &geo, const Group &g, const Point &cm, Tpvec &p) const {
+          assert((int)ref.size()==g.size() && "Rigid body template out of sync.");
+          Eigen::Matrix3d R = q_trial.toRotationMatrix();
+          Eigen::Vector3d c = cm.cast<double>();
+          auto r = ref.begin();
+          for (auto i : g) {
+            p[i] = R * (*r++) + c;
+            Geometry::Policy<Tgeometry>::boundary(geo, p[i]);
+          }
+        }
+
+      /** @brief Relative rotation from current to trial orientation */
+      Eigen::AngleAxisd trialRotation() const {
+        return Eigen::AngleAxisd( q_trial * q.conjugate() );
+      }
+
+      /** @brief Accept trial pose with lab frame positions `p` */
+      template<class Tpvec>
+        void accept(const Tpvec &p, const Group &g) {
+          q=q_trial;
+          sync(p,g);
+        }
+
+      inline void undo() { q_trial=q; }    //!< Reject trial pose
+  };
+
   /** @brief Number of hydrophobic sites */
   template<class Tpvec, class Tindex>
     int numHydrophobic(const Tpvec &p, const Tindex &g) {
@@ -15,6 +15,9 @@
 #endif
 #include <xdrfile/xdrfile_trr.h>
 #include <xdrfile/xdrfile_xtc.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #endif
 #include <xdrfile/xdrfile_trr.h>
@@ -536,9 +539,8 @@ namespace Faunus {
             if (natoms_xtc==(int)c.p.size()) { 
               int rc = read_xtc(xd, natoms_xtc, &step_xtc, &time_xtc, xdbox, x_xtc, &prec_xtc);
               if (rc==0) {
-                Geometry::Cuboid* geo = dynamic_cast<Geometry::Cuboid*>(c.geo);
-                assert(geo!=nullptr && "Geometry must to derived from Cuboid");
-                geo->setlen( Point( xdbox[0][0], xdbox[1][1], xdbox[2][2] ) );
+                Geometry::Cuboid* geo = &c.geo; // must be derived from Cuboid
+                geo->setlen( Point( xdbox[0][0], xdbox[1][1], xdbox[2][2] )*10 ); // nm->AA
                 for (size_t i=0; i<c.p.size(); i++) {
                   c.p[i].x() = x_xtc[i][0];
                   c.p[i].y() = x_xtc[i][1];
@@ -677,6 +679,278 @@ namespace Faunus {
 
   };
 
+  /**
+   * @brief Indexed, random access and parallel reading of xtc trajectories
+   *
+   * On opening, the byte offset of every frame is found by reading only
+   * the frame headers and skipping the compressed coordinates. The index
+   * is saved next to the trajectory (`<file>.idx`) together with the file
+   * size and reused the next time if the number of atoms match, the file
+   * has not shrunk, and the last indexed offset still holds a frame header;
+   * should the trajectory have grown since, only the new frames are indexed.
+   * Otherwise the whole trajectory is scanned again. Any frame can then be read in constant
+   * time and each thread uses its own file handle so that frames can be
+   * decoded concurrently.
+   *
+   * The `analyze()` driver distributes frames over OpenMP threads, each
+   * with a private copy of the analysis object and a private `Frame`,
+   * and finally merges the results using the analysis' `operator+=`.
+   * A `Frame` holds a particle vector and geometry copied from a `Space`
+   * and may be passed wherever an analysis expects a `Space` that provides
+   * only `p` and `geo`:
+   *
+   *     TrajectoryXTC traj("traj.xtc");
+   *     Analysis::RadialDistribution<> rdf(0.1);
+   *     rdf = traj.analyze( spc, rdf,
+   *         [](Analysis::RadialDistribution<> &r, TrajectoryXTC::Frame<Tspace> &f) {
+   *           r.sample(f, cationId, anionId);
+   *         } );
+   *     rdf.save("rdf.dat");
+   *
+   * As for `FormatXTC`, coordinates are converted from nm to angstrom and
+   * shifted so that the origin is in the middle of the box, which must be
+   * a `Geometry::Cuboid` (or derived). The particle vector must match the
+   * number of atoms in the trajectory.
+   *
+   * @note Frames are processed out of order; analyses must not depend
+   *       on the sampling sequence.
+   * @date Lund 2014
+   */
+  class TrajectoryXTC {
+    public:
+      /** @brief Trajectory frame with a `Space`-like interface */
+      template<class Tspace>
+        struct Frame {
+          typename Tspace::ParticleVector p;  //!< Particles with frame coordinates
+          typename Tspace::GeometryType geo;  //!< Geometry with frame box
+          size_t index;                       //!< Frame number
+          int step;                           //!< Simulation step
+          float time;                         //!< Simulation time
+          Frame(const Tspace &spc) : p(spc.p), geo(spc.geo), index(0), step(0), time(0) {}
+        };
+
+    private:
+      enum { MAGIC=1995, INDEXVERSION=2 };
+      string file;
+      int natoms;
+      std::vector<int64_t> offset;           // byte offset of each frame
+      int64_t indexed;                       // bytes covered by the index
+      std::vector<XDRFILE*> xd;              // file handle for each thread
+      std::vector<std::vector<float> > xbuf; // coordinate buffer for each thread
+
+      static int thread() {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+      }
+
+      static int threads() {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+      }
+
+      /** @brief Size of trajectory file in bytes (-1 if it cannot be opened) */
+      int64_t fileSize() const {
+        XDRFILE *f = xdrfile_open(file.c_str(), "r");
+        if (f==NULL)
+          return -1;
+        xdr_seek(f, 0, SEEK_END);
+        int64_t size = xdr_tell(f);
+        xdrfile_close(f);
+        return size;
+      }
+
+      /** @brief True if a frame header with matching number of atoms is found at `pos` */
+      bool isFrame(XDRFILE *f, int64_t pos) const {
+        int head[2];
+        return xdr_seek(f, pos, SEEK_SET)==0 && xdrfile_read_int(head,2,f)==2
+          && head[0]==MAGIC && head[1]==natoms;
+      }
+
+      /** @brief Find frame offsets from byte `start` by skipping coordinate data */
+      void scan(int64_t start) {
+        XDRFILE *f = xdrfile_open(file.c_str(), "r");
+        if (f==NULL)
+          return;
+        xdr_seek(f, 0, SEEK_END);
+        int64_t size = xdr_tell(f), pos = start;
+        while (pos<size) {
+          int bytes=0;
+          if (!isFrame(f,pos))
+            break;
+          int64_t next = pos + 56 + 12*int64_t(natoms);      // uncompressed (<10 atoms)
+          if (natoms>9) {
+            if (xdr_seek(f, pos+88, SEEK_SET)!=0 || xdrfile_read_int(&bytes,1,f)!=1)
+              break;
+            next = pos + 92 + ( (int64_t(bytes)+3) & ~int64_t(3) ); // padded to 4 bytes
+          }
+          if (next>size)
+            break; // incomplete frame
+          offset.push_back(pos);
+          pos=next;
+        }
+        indexed=pos;
+        xdrfile_close(f);
+      }
+
+      /**
+       * @brief Load frame offsets from index file
+       *
+       * The index is discarded if it was made for another number of atoms,
+       * if the trajectory is now smaller than when indexed, or if there is
+       * no frame header at the last offset, i.e. if the trajectory was
+       * replaced.
+       */
+      bool loadIndex(const string &idx) {
+        std::ifstream f(idx.c_str(), std::ios::binary);
+        int64_t head[5]; // version, atoms, indexed bytes, frames, file size
+        if (!f.read((char*)head, sizeof(head)) || head[0]!=INDEXVERSION || head[1]!=natoms
+            || head[2]<0 || head[3]<0 || head[2]>head[4] || head[4]>fileSize())
+          return false;
+        offset.resize(head[3]);
+        bool valid = offset.empty() || f.read((char*)&offset[0], offset.size()*sizeof(int64_t));
+        if (valid && !offset.empty()) {
+          XDRFILE *x = xdrfile_open(file.c_str(), "r");
+          valid = (x!=NULL && isFrame(x, offset.back()));
+          if (x!=NULL)
+            xdrfile_close(x);
+        }
+        if (!valid) {
+          offset.clear();
+          return false;
+        }
+        indexed=head[2];
+        return true;
+      }
+
+      bool saveIndex(const string &idx) const {
+        std::ofstream f(idx.c_str(), std::ios::binary);
+        int64_t head[5] = { INDEXVERSION, natoms, indexed, int64_t(offset.size()), fileSize() };
+        f.write((const char*)head, sizeof(head));
+        if (!offset.empty())
+          f.write((const char*)&offset[0], offset.size()*sizeof(int64_t));
+        return bool(f);
+      }
+
+    public:
+      /**
+       * @param trajectory Name of xtc file
+       * @param useIndexFile Load and save frame index from/to disk
+       */
+      TrajectoryXTC(const string &trajectory, bool useIndexFile=true) : file(trajectory), natoms(0), indexed(0) {
+        if (read_xtc_natoms(&file[0], &natoms)!=exdrOK) {
+          std::cerr << "# ioxtc error: xtc file could not be opened." << endl;
+          return;
+        }
+        string idx = file + ".idx";
+        bool loaded = useIndexFile && loadIndex(idx);
+        int64_t n = offset.size();
+        scan(indexed);
+        if (useIndexFile && (!loaded || int64_t(offset.size())!=n))
+          saveIndex(idx);
+        xd.assign(threads(), nullptr);
+        xbuf.resize(threads());
+      }
+
+      ~TrajectoryXTC() {
+        for (auto f : xd)
+          if (f!=nullptr)
+            xdrfile_close(f);
+      }
+
+      size_t size() const { return offset.size(); } //!< Number of frames
+      int atoms() const { return natoms; }          //!< Number of atoms in each frame
+
+      /**
+       * @brief Load frame `i` into `Space` or `Frame`
+       *
+       * Box and particle positions are set; other particle properties
+       * are untouched. This is thread safe for different threads.
+       * When loading into a `Space`, `Space::trial` is not updated.
+       */
+      template<class Tspace>
+        bool load(size_t i, Tspace &c, int *step=nullptr, float *time=nullptr) {
+          static_assert(
+              std::is_base_of<Geometry::Cuboid, typename std::decay<decltype(c.geo)>::type>::value,
+              "Geometry must be derived from Cuboid");
+          int t=thread();
+          if (i>=offset.size() || natoms!=(int)c.p.size() || t>=(int)xd.size()) {
+            std::cerr << "# ioxtc load error: frame or xtcfile-container particle mismatch!" << endl;
+            return false;
+          }
+          if (xd[t]==nullptr)
+            xd[t] = xdrfile_open(file.c_str(), "r");
+          if (xd[t]==nullptr || xdr_seek(xd[t], offset[i], SEEK_SET)!=0)
+            return false;
+          std::vector<float> &x = xbuf[t];
+          x.resize(3*natoms);
+          matrix box;
+          int s;
+          float tm, prec;
+          if (read_xtc(xd[t], natoms, &s, &tm, box, (rvec*)&x[0], &prec)!=exdrOK)
+            return false;
+          c.geo.setlen( Point( box[0][0], box[1][1], box[2][2] )*10 );
+          const Point &h = c.geo.len_half;
+          for (int j=0; j<natoms; j++) {
+            c.p[j].x() = x[3*j]*10 - h.x();
+            c.p[j].y() = x[3*j+1]*10 - h.y();
+            c.p[j].z() = x[3*j+2]*10 - h.z();
+          }
+          if (step!=nullptr)
+            *step=s;
+          if (time!=nullptr)
+            *time=tm;
+          return true;
+        }
+
+      /** @brief Load frame `i` into `Frame` */
+      template<class Tspace>
+        bool load(size_t i, Frame<Tspace> &f) {
+          f.index=i;
+          return load<Frame<Tspace> >(i, f, &f.step, &f.time);
+        }
+
+      /**
+       * @brief Parallel analysis of frames
+       *
+       * @param spc Space from which particle properties and geometry are copied
+       * @param prototype Analysis object copied to each thread (usually empty)
+       * @param sample Function, `f(Tanalysis&, Frame<Tspace>&)`, called for each frame
+       * @param first First frame
+       * @param last One past the last frame (default: all frames)
+       * @param stride Analyse every stride'th frame
+       * @param batch Number of consecutive frames handed to a thread at a time
+       * @return Merged analysis object
+       */
+      template<class Tspace, class Tanalysis, class Tfunction>
+        Tanalysis analyze(const Tspace &spc, const Tanalysis &prototype, Tfunction sample,
+            size_t first=0, size_t last=-1, size_t stride=1, int batch=4) {
+          last = std::min(last, size());
+          long n = (last>first && stride>0) ? (last-first+stride-1)/stride : 0;
+          std::vector<Tanalysis> result(threads(), prototype);
+          std::vector<Frame<Tspace> > frame(threads(), Frame<Tspace>(spc));
+          long failed=0;
+#pragma omp parallel for schedule(dynamic,batch) reduction(+:failed)
+          for (long k=0; k<n; k++) {
+            int t=thread();
+            if (load(first+k*stride, frame[t]))
+              sample(result[t], frame[t]);
+            else
+              failed++;
+          }
+          if (failed>0)
+            std::cerr << "# ioxtc load error: " << failed << " frames could not be read!" << endl;
+          for (size_t t=1; t<result.size(); t++)
+            result[0] += result[t];
+          return result[0];
+        }
+  };
+
   class FormatTopology {
     private:
       int rescnt;
@@ -94,6 +94,7 @@ namespace Faunus {
       string timing();             //!< Show macrostep middle time and ETA.
       bool macroCnt();             //!< Increase and test macro loop counter
       bool microCnt();             //!< Increase and test micro loop counter
+      void stop();                 //!< End loop after current macro step
 
       inline unsigned int getMacroCnt() const {
         return cnt_macro;
@@ -157,6 +158,19 @@ namespace Faunus {
     return false;
   }
 
+  /*!
+   * Makes the next call to MCLoop::macroCnt() return false. Use this to end
+   * a run early, for example when an error estimate has converged:
+   *
+   * @code
+   * if ( energy.converged(0.1) )
+   *   mc.stop();
+   * @endcode
+   */
+  void MCLoop::stop() {
+    macro=cnt_macro;
+  }
+
   /*!
    * Returns the number of completed steps
    */
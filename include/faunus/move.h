@@ -14,6 +14,10 @@
 #include <faunus/mpi.h>
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #endif
 
 namespace Faunus {
@@ -160,6 +164,94 @@ namespace Faunus {
               }
       };
 
+    /**
+     * @brief Force biased trial displacements
+     *
+     * Generates a displacement vector, @f$\mathbf{d}@f$, biased along a force
+     * (or torque), @f$\mathbf{F}@f$ (kT/angstrom), and evaluates the log
+     * of the proposal density needed for the acceptance correction,
+     * @f$ \ln P(-\mathbf{d}|\mathbf{F}^{\prime}) - \ln P(\mathbf{d}|\mathbf{F}) @f$.
+     * Two schemes are available, both reducing to the usual
+     * unbiased moves for zero force:
+     *
+     * - `SMART`: smart Monte Carlo (doi:10.1063/1.436415) with Gaussian displacements,
+     *   @f$ \mathbf{d} = A\mathbf{F} + \sqrt{2A}\boldsymbol{\eta} @f$, where
+     *   @f$ A=dp^2/24 @f$ gives the random part the same variance as a uniform
+     *   step in @f$[-dp/2,dp/2]@f$.
+     * - `FORCE`: force bias (doi:10.1016/0009-2614(78)84003-2) where each component is drawn in
+     *   @f$[-dp/2,dp/2]@f$ with density proportional to @f$ \exp(\lambda F d) @f$.
+     *
+     * Components with zero `dir` are left untouched.
+     */
+    class ForceBias {
+      public:
+        enum biastype {SMART, FORCE};
+        biastype type;
+        double lambda;   //!< Force bias strength (FORCE only, default 0.5)
+
+        ForceBias(biastype t=SMART, double l=0.5) : type(t), lambda(l) {}
+
+        /** @brief Construct from InputMap keys `pfx_forcebias` (`smart` or `force`) and `pfx_lambda` */
+        ForceBias(InputMap &in, const string &pfx) {
+          type = (in.get<string>(pfx+"_forcebias", "smart", "Force bias scheme (smart/force)")=="force")
+            ? FORCE : SMART;
+          lambda = in.get<double>(pfx+"_lambda", 0.5, "Force bias strength");
+        }
+
+        /** @brief Draw displacement with width `dp` along directions `dir` */
+        Point propose(const Point &F, double dp, const Point &dir) const {
+          Point d(0,0,0);
+          for (int k=0; k<3; k++)
+            if (dir[k]!=0) {
+              if (type==SMART) {
+                double A=dp*dp/24;
+                d[k] = A*F[k] + std::sqrt(2*A)*slp_global.randNormal();
+              } else {
+                double a=std::fabs(lambda*F[k]), u=slp_global();
+                if (a*dp<1e-8)
+                  d[k] = dp*(u-0.5);
+                else {
+                  d[k] = 0.5*dp + std::log( u + (1-u)*std::exp(-a*dp) ) / a;
+                  if (F[k]<0)
+                    d[k] = -d[k];
+                }
+              }
+            }
+          return d;
+        }
+
+        /** @brief Log of proposal density (up to a constant independent of `F`) */
+        double lnProposal(const Point &d, const Point &F, double dp, const Point &dir) const {
+          double lnp=0;
+          for (int k=0; k<3; k++)
+            if (dir[k]!=0) {
+              if (type==SMART) {
+                double A=dp*dp/24;
+                lnp -= std::pow(d[k]-A*F[k], 2) / (4*A);
+              } else {
+                if (std::fabs(d[k])>0.5*dp)
+                  return -pc::infty;
+                double f=lambda*F[k], a=std::fabs(f);
+                if (a*dp>=1e-8)     // log of normalized exp(f*d) on [-dp/2,dp/2]
+                  lnp += f*d[k] - (0.5*a*dp + std::log1p(-std::exp(-a*dp)) - std::log(a));
+                else
+                  lnp -= std::log(dp);
+              }
+            }
+          return lnp;
+        }
+
+        string info(char w) const {
+          using namespace textio;
+          std::ostringstream o;
+          o << pad(SUB,w,"Force bias") << ((type==SMART) ? "smart MC" : "force biased");
+          if (type==FORCE)
+            o << " (lambda=" << lambda << ")";
+          o << endl;
+          return o.str();
+        }
+    };
+
     /**
      * @brief Base class for Monte Carlo moves
      *
@@ -213,6 +305,11 @@ namespace Faunus {
           bool useAlternateReturnEnergy;   //!< Return a different energy than returned by _energyChange(). [false]
           double alternateReturnEnergy;    //!< Alternative return energy
 
+          bool earlyRejection;             //!< Draw Metropolis threshold before _energyChange(). [false]
+          double duMax;                    //!< Pre-drawn threshold: move is rejected if dU exceeds this (kT)
+
+          std::vector<int> moved;          //!< Particles changed by `_trialMove()`; empty if unknown (see `Energybase::setMoved()`)
+
         public:
           Movebase(Energy::Energybase<Tspace>&, Tspace&, string);//!< Constructor
           virtual ~Movebase();
@@ -234,6 +331,8 @@ namespace Faunus {
         w=22;
         runfraction=1;
         useAlternateReturnEnergy=false; //this has no influence on metropolis sampling!
+        earlyRejection=false;
+        duMax=pc::infty;
       }
 
     template<class Tspace>
@@ -242,18 +341,23 @@ namespace Faunus {
     template<class Tspace>
       void Movebase<Tspace>::trialMove() {
         cnt++;
+        moved.clear();
+        pot->setMoved(moved);
         _trialMove();
+        pot->setMoved(moved);
       }
 
     template<class Tspace>
       void Movebase<Tspace>::acceptMove() {
         cnt_accepted++;
         _acceptMove();
+        pot->update(true);
       }
 
     template<class Tspace>
       void Movebase<Tspace>::rejectMove() {
         _rejectMove();
+        pot->update(false);
       }
 
     /** @return Energy change in units of kT */
@@ -277,6 +381,13 @@ namespace Faunus {
      * - Accept with probability \f$ \min(1,e^{-\beta\Delta U}) \f$
      * - Call either `_acceptMove()` or `_rejectMove()`
      *
+     * If `earlyRejection` is set, the uniform random number, \f$\xi\f$, is
+     * drawn *before* the energy change and converted to the threshold
+     * `duMax` \f$=-\ln\xi\f$ so that the move is accepted if
+     * \f$\beta\Delta U \leq\f$ `duMax`. This is identical to the usual
+     * criterion but lets `_energyChange()` abandon partial energy sums
+     * as soon as rejection is certain (see `Energybase::i2all_bound()`).
+     *
      * @note Do not override this function in derived classes.
      * @param n Perform move `n` times (default=1)
      */
@@ -286,8 +397,17 @@ namespace Faunus {
         if (run()) {
           while (n-->0) {
             trialMove();
-            double du=energyChange();
-            if ( !metropolis(du) )
+            double du;
+            bool accept;
+            if (earlyRejection) {
+              duMax = -std::log( slp_global() );
+              du=energyChange();
+              accept = (du<=duMax);
+            } else {
+              du=energyChange();
+              accept = metropolis(du);
+            }
+            if ( !accept )
               rejectMove();
             else {
               acceptMove();
@@ -426,6 +546,7 @@ namespace Faunus {
      * :------------------- | :-------------------------------------------------------------
      * `prefix_runfraction` | Chance of running (default=1)
      * `prefix_genericdp`   | Fallback displacement paraemter if `dp` is defined in AtomData.
+     * `prefix_earlyreject` | Pre-draw Metropolis threshold and truncate energy sums (default: no)
      *
      * The standard prefix is `mv_particle`.
      */
@@ -439,6 +560,7 @@ namespace Faunus {
         this->w=30; //width of output
         this->runfraction = in.get<double>(pfx+"_runfraction",1.);
         setGenericDisplacement( in.get<double>(pfx+"_genericdp",0) );
+        base::earlyRejection = in.get<bool>(pfx+"_earlyreject",false);
       }
 
     /**
@@ -485,6 +607,7 @@ namespace Faunus {
           t.y() *= slp_global()-0.5;
           t.z() *= slp_global()-0.5;
           spc->trial[iparticle].translate(spc->geo, t);
+          base::moved.assign(1, iparticle);
 
           // make sure trial mass center is updated for molecular groups
           // (certain energy functions may rely on up-to-date mass centra)
@@ -534,6 +657,15 @@ namespace Faunus {
           if ( spc->geo.collision(
                 spc->trial[iparticle], Geometry::Geometrybase::BOUNDARY ) )
             return pc::infty;
+          if (base::earlyRejection) {
+            double uold = base::pot->i_total(spc->p, iparticle)
+              + base::pot->external(spc->p);
+            double unew = base::pot->i_external(spc->trial, iparticle)
+              + base::pot->i_internal(spc->trial, iparticle)
+              + base::pot->external(spc->trial);
+            return unew + base::pot->i2all_bound(spc->trial, iparticle,
+                uold + base::duMax - unew) - uold;
+          }
           return
             (base::pot->i_total(spc->trial, iparticle)
              + base::pot->external(spc->trial))
@@ -577,6 +709,492 @@ namespace Faunus {
         return o.str();
       }
 
+    /**
+     * @brief Parallel single particle translation using checkerboard domain decomposition
+     *
+     * Each sweep divides the box into an even number, @f$n\geq 4@f$, of cells in each
+     * direction with side lengths no smaller than the interaction range, `cutoff`.
+     * The cells are colored in a 2x2x2 checkerboard so that cells of equal color
+     * never touch. For each of the eight colors, in random order, all cells of
+     * that color are processed in parallel: a cell performs as many trial
+     * displacements as it holds mobile particles and displacements out of the
+     * cell are rejected. Particles moved by different threads are thus always
+     * more than `cutoff` apart and their energy changes are independent. The grid
+     * is randomly shifted before every sweep which keeps the move ergodic and,
+     * as each trial displacement is symmetric, detailed balance is obeyed.
+     *
+     * The energy of a particle is summed over `i2i()` with particles in the 27
+     * surrounding cells plus `i_external()` and `i_internal()`. This requires a
+     * pair additive Hamiltonian with a range shorter than `cutoff`. Each thread
+     * has its own random number generator, seeded from `slp_global`. Only
+     * atomic groups can be moved and the geometry must be a `Geometry::Cuboid`.
+     * If the box holds less than four cells in any direction, sweeps are
+     * done serially using the full particle energy.
+     *
+     * One call to `move()` performs one sweep, i.e. on average one trial
+     * displacement per particle in the group. In addition to the keywords of
+     * `AtomicTranslation` the following is read:
+     *
+     * Key             | Description
+     * :-------------- | :----------------------------------------------
+     * `prefix_cutoff` | Interaction range defining the cell size (angstrom)
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class ParallelAtomicTranslation : public AtomicTranslation<Tspace> {
+        private:
+          typedef AtomicTranslation<Tspace> base;
+          typedef typename Tspace::p_vec Tpvec;
+          typedef Eigen::Vector3i Tcell;
+          using base::spc;
+          using base::pot;
+          using base::igroup;
+          using base::dir;
+          using base::genericdp;
+          using base::accmap;
+          using base::sqrmap;
+
+          double cutoff;
+          Tcell n;                          // number of cells in each direction
+          Point clen, offset;               // cell side lengths; random grid offset
+          vector<vector<int> > all, mobile; // all and mobile particles in each cell
+          vector<std::mt19937> engines;     // random number generator for each thread
+          Average<double> acc;              // acceptance
+          unsigned long int cntSerial;      // number of serial sweeps
+
+          static int threadNum() {
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+          }
+
+          bool setGrid() {
+            for (int d=0; d<3; d++) {
+              n[d] = 2*int( spc->geo.len[d]/(2*cutoff) );
+              if (n[d]<4)
+                return false;
+              clen[d] = spc->geo.len[d]/n[d];
+            }
+            return true;
+          }
+
+          int cellIndex(Tcell c) const {
+            for (int d=0; d<3; d++)
+              c[d] = (c[d]+n[d]) % n[d];
+            return (c[0]*n[1] + c[1])*n[2] + c[2];
+          }
+
+          Tcell coord(const Point &a) const {
+            Tcell c;
+            for (int d=0; d<3; d++) {
+              double x = a[d] + spc->geo.len_half[d] - offset[d];
+              x -= spc->geo.len[d]*std::floor( x/spc->geo.len[d] );
+              c[d] = std::min( int(x/clen[d]), n[d]-1 );
+            }
+            return c;
+          }
+
+          /** @brief Energy of particle i in cell c with neighbors and external potentials */
+          double energy(Tpvec &p, int i, const Tcell &c) {
+            double u = pot->i_external(p,i) + pot->i_internal(p,i);
+            for (int dx=-1; dx<=1; dx++)
+              for (int dy=-1; dy<=1; dy++)
+                for (int dz=-1; dz<=1; dz++)
+                  for (auto j : all[ cellIndex( c+Tcell(dx,dy,dz) ) ])
+                    if (j!=i)
+                      u += pot->i2i(p,i,j);
+            return u;
+          }
+
+          /** @brief Random displacement of particle i in trial vector */
+          template<class Trandom>
+            void displace(int i, Trandom &rand) {
+              double dp = atom[ spc->p[i].id ].dp;
+              if (dp<1e-6)
+                dp = genericdp;
+              Point t = dir*dp;
+              t.x() *= rand()-0.5;
+              t.y() *= rand()-0.5;
+              t.z() *= rand()-0.5;
+              spc->trial[i].translate(spc->geo, t);
+            }
+
+          double sweepSerial() {
+            double du=0;
+            std::uniform_real_distribution<double> dist(0,1);
+            auto rand = [&]() { return dist(engines[0]); };
+            for (int k=0; k<igroup->size(); k++) {
+              int i = igroup->front() + int( rand()*igroup->size() );
+              displace(i, rand);
+              double dui = pc::infty;
+              if ( !spc->geo.collision( spc->trial[i], Geometry::Geometrybase::BOUNDARY ) )
+                dui = pot->i_total(spc->trial,i) - pot->i_total(spc->p,i);
+              double r2 = spc->geo.sqdist( spc->p[i], spc->trial[i] );
+              auto id = spc->p[i].id;
+              if ( rand() < std::exp(-dui) ) {
+                spc->p[i] = spc->trial[i];
+                du += dui;
+                acc += 1;
+                accmap[id] += 1;
+                sqrmap[id] += r2;
+              } else {
+                spc->trial[i] = spc->p[i];
+                acc += 0;
+                accmap[id] += 0;
+                sqrmap[id] += 0;
+              }
+            }
+            return du;
+          }
+
+          double sweepParallel() {
+            double du=0;
+            std::uniform_real_distribution<double> dist(0,1);
+            for (int d=0; d<3; d++)
+              offset[d] = clen[d]*dist(engines[0]);
+
+            int ncells = n[0]*n[1]*n[2];
+            all.assign(ncells, vector<int>());
+            mobile.assign(ncells, vector<int>());
+            for (size_t i=0; i<spc->p.size(); i++)
+              all[ cellIndex(coord(spc->p[i])) ].push_back(i);
+            for (auto i : *igroup)
+              mobile[ cellIndex(coord(spc->p[i])) ].push_back(i);
+
+            vector<int> colors = {0,1,2,3,4,5,6,7};
+            std::shuffle(colors.begin(), colors.end(), engines[0]);
+
+            for (auto color : colors) {
+              vector<Tcell> cells;
+              for (int x=color%2; x<n[0]; x+=2)
+                for (int y=(color/2)%2; y<n[1]; y+=2)
+                  for (int z=color/4; z<n[2]; z+=2)
+                    cells.push_back( Tcell(x,y,z) );
+
+#pragma omp parallel
+              {
+                std::map<short, Average<double> > accl, sqrl; // thread local statistics
+                Average<double> accthread;
+#pragma omp for schedule (dynamic) reduction (+:du)
+                for (int k=0; k<(int)cells.size(); k++) {
+                  auto &eng = engines[ threadNum() ];
+                  std::uniform_real_distribution<double> dist(0,1);
+                  auto rand = [&]() { return dist(eng); };
+                  const Tcell &c = cells[k];
+                  const vector<int> &m = mobile[ cellIndex(c) ];
+                  for (size_t t=0; t<m.size(); t++) {
+                    int i = m[ int( rand()*m.size() ) ];
+                    auto id = spc->p[i].id;
+                    displace(i, rand);
+                    double dui = pc::infty;
+                    if ( cellIndex(coord(spc->trial[i])) == cellIndex(c) )
+                      if ( !spc->geo.collision( spc->trial[i], Geometry::Geometrybase::BOUNDARY ) )
+                        dui = energy(spc->trial,i,c) - energy(spc->p,i,c);
+                    if ( rand() < std::exp(-dui) ) {
+                      sqrl[id] += spc->geo.sqdist( spc->p[i], spc->trial[i] );
+                      accl[id] += 1;
+                      accthread += 1;
+                      spc->p[i] = spc->trial[i];
+                      du += dui;
+                    } else {
+                      sqrl[id] += 0;
+                      accl[id] += 0;
+                      accthread += 0;
+                      spc->trial[i] = spc->p[i];
+                    }
+                  }
+                }
+#pragma omp critical
+                {
+                  for (auto &a : accl)
+                    accmap[a.first] = accmap[a.first] + a.second;
+                  for (auto &a : sqrl)
+                    sqrmap[a.first] = sqrmap[a.first] + a.second;
+                  acc = acc + accthread;
+                }
+              }
+            }
+            return du;
+          }
+
+          void _trialMove() FOVERRIDE {
+            assert(igroup!=nullptr && "Set group to move");
+            assert(igroup->isAtomic() && "Only atomic groups can be moved");
+            if (setGrid())
+              base::alternateReturnEnergy = sweepParallel();
+            else {
+              cntSerial++;
+              base::alternateReturnEnergy = sweepSerial();
+            }
+          }
+
+          double _energyChange() FOVERRIDE { return 0; }
+
+          void _acceptMove() FOVERRIDE {}
+
+          void _rejectMove() FOVERRIDE {}
+
+          string _info() FOVERRIDE {
+            using namespace textio;
+            std::ostringstream o;
+            o << pad(SUB,base::w,"Cell cutoff") << cutoff << _angstrom << endl
+              << pad(SUB,base::w,"Threads") << engines.size() << endl;
+            if (base::cnt>0) {
+              o << pad(SUB,base::w,"Sweeps (serial)") << base::cnt << " (" << cntSerial << ")" << endl
+                << pad(SUB,base::w,"Cells") << n.transpose() << endl
+                << pad(SUB,base::w,"Acceptance") << acc.avg()*100 << percent << endl;
+            }
+            return o.str() + base::_info();
+          }
+
+        public:
+          ParallelAtomicTranslation(InputMap &in, Energy::Energybase<Tspace> &e,
+              Tspace &s, string pfx="mv_particle") : base(in,e,s,pfx), cntSerial(0) {
+            static_assert(
+                std::is_base_of<Geometry::Cuboid, typename Tspace::GeometryType>::value,
+                "Parallel translation requires a Cuboid geometry" );
+            base::title="Parallel Single Particle Translation";
+            base::useAlternateReturnEnergy=true;
+            cutoff = in.get<double>(pfx+"_cutoff", pc::infty, "Interaction range for cells (angstrom)");
+            n.setZero();
+#ifdef _OPENMP
+            engines.resize( omp_get_max_threads() );
+#else
+            engines.resize(1);
+#endif
+            for (auto &eng : engines)
+              eng.seed( slp_global.rand() );
+          }
+      };
+
+    /**
+     * @brief Single particle translation biased by the pair force
+     *
+     * Works as `AtomicTranslation` but displacements are drawn along the
+     * force from all other particles, evaluated with `Energybase::f_p2p()`,
+     * using `ForceBias`. The asymmetric proposal is corrected for in the
+     * acceptance so that any force - also approximate or partial - gives
+     * exact sampling. In addition to the keywords of `AtomicTranslation`:
+     *
+     * Key                | Description
+     * :----------------- | :------------------------------------------------
+     * `prefix_forcebias` | `smart` (default) or `force`
+     * `prefix_lambda`    | Bias strength for `force` (default: 0.5)
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class ForceBiasedTranslation : public AtomicTranslation<Tspace> {
+        private:
+          typedef AtomicTranslation<Tspace> base;
+          typedef typename Tspace::ParticleVector Tpvec;
+          ForceBias bias;
+          Point d;      // trial displacement
+          double dp;    // displacement parameter of current particle
+          double lnPfwd;// log forward proposal density
+
+          /** @brief Pair force on particle `i` from all other particles (kT/A) */
+          Point force(const Tpvec &p, int i) {
+            Point f(0,0,0);
+            for (int j=0; j<(int)p.size(); j++)
+              if (j!=i)
+                f += base::pot->f_p2p(p[i], p[j]);
+            return f;
+          }
+
+          string _info() FOVERRIDE {
+            return bias.info(base::w) + base::_info();
+          }
+
+          void _trialMove() FOVERRIDE {
+            if (base::igroup!=nullptr) {
+              base::iparticle=base::igroup->random();
+              base::gsize += base::igroup->size();
+            }
+            int i=base::iparticle;
+            if (i>-1) {
+              dp = atom[ base::spc->p[i].id ].dp;
+              if (dp<1e-6) dp = base::genericdp;
+              Point F = force(base::spc->p, i);
+              d = bias.propose(F, dp, base::dir);
+              lnPfwd = bias.lnProposal(d, F, dp, base::dir);
+              base::spc->trial[i].translate(base::spc->geo, d);
+              auto gi = base::spc->findGroup(i);
+              assert(gi!=nullptr);
+              if (gi->isMolecular())
+                gi->cm_trial = Geometry::massCenter(base::spc->geo, base::spc->trial, *gi);
+            }
+          }
+
+          double _energyChange() FOVERRIDE {
+            double du = base::_energyChange();
+            base::alternateReturnEnergy = du;
+            if (base::iparticle<0 || du==pc::infty)
+              return du;
+            Point F = force(base::spc->trial, base::iparticle);
+            return du - ( bias.lnProposal(-d, F, dp, base::dir) - lnPfwd );
+          }
+
+        public:
+          ForceBiasedTranslation(InputMap &in, Energy::Energybase<Tspace> &e, Tspace &s,
+              string pfx="mv_particle") : base(in,e,s,pfx), bias(in,pfx), dp(0), lnPfwd(0) {
+            base::title="Force Biased Single Particle Translation";
+            base::useAlternateReturnEnergy=true; // return energy without bias correction
+          }
+      };
+
+    /**
+     * @brief Event-chain Monte Carlo for hard spheres
+     *
+     * Rejection-free, irreversible event-chain move (doi:10.1103/PhysRevE.80.056704).
+     * A random particle in the group is pushed along a random positive Cartesian
+     * direction until it hits another sphere, which then continues along the
+     * same direction, and so on until the total displacement equals the chain
+     * length, `ell`. The move obeys global balance and has no
+     * rejections. Collisions are found with a `Geometry::CellList` and
+     * minimum image distances so the geometry must be a `Geometry::Cuboid`.
+     *
+     * All particles in Space are treated as hard spheres with contact
+     * distance @f$ a_i+a_j @f$ (`radius`) and may be hit and pushed.
+     * Use only for systems where this is the full Hamiltonian: no other
+     * energy terms are evaluated and `move()` always returns zero.
+     * One call to `move(n)` performs `n` chains.
+     *
+     * Key              | Description
+     * :--------------- | :-----------------------------------------------
+     * `prefix_length`  | Chain length, `ell` (angstrom)
+     * `prefix_runfraction` | Chance of running (default: 1)
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class EventChain : public Movebase<Tspace> {
+        private:
+          typedef Movebase<Tspace> base;
+          typedef typename Tspace::GeometryType Tgeometry;
+          using base::spc;
+          using base::w;
+          Geometry::CellList<Tgeometry> cells;
+          Group* igroup;
+          double ell;             // chain length
+          double sigmax;          // largest contact distance
+          double volume;          // box volume when cell list was set
+          bool valid;             // cell grid could be set
+          std::vector<Point> home; // positions in cell list
+          Average<double> events; // number of lifts per chain
+
+          string _info() FOVERRIDE {
+            using namespace textio;
+            std::ostringstream o;
+            o << pad(SUB,w,"Chain length") << ell << _angstrom << endl;
+            if (events.cnt>0)
+              o << pad(SUB,w,"Average events/chain") << events.avg() << endl;
+            return o.str();
+          }
+
+          /** @brief Distance along axis `k` before `i` hits `j`; infinite if never */
+          double collision(int i, int j, int k) const {
+            Point r = spc->geo.vdist(spc->p[j], spc->p[i]);
+            if (r[k]<=0)
+              return pc::infty;
+            double s = spc->p[i].radius + spc->p[j].radius;
+            double b2 = r.squaredNorm() - r[k]*r[k];
+            if (b2>=s*s)
+              return pc::infty;
+            return std::max(0.0, r[k]-std::sqrt(s*s-b2));
+          }
+
+          /** @brief Set cell grid and sort all particles into it */
+          bool setGrid() {
+            sigmax=0;
+            for (auto &a : spc->p)
+              sigmax = std::max(sigmax, 2.0*a.radius);
+            volume = spc->geo.getVolume();
+            home.assign(spc->p.begin(), spc->p.end());
+            valid = cells.setGrid(spc->geo, 2*sigmax);
+            if (!valid) {
+              std::cerr << "# Event chain: box too small for cell list.\n";
+              base::runfraction=0;
+              return false;
+            }
+            cells.build(spc->p, Group(0, int(spc->p.size())-1));
+            return true;
+          }
+
+          /** @brief Bring cell list up to date with particles changed by other moves */
+          bool sync() {
+            if (spc->geo.getVolume()!=volume || home.size()!=spc->p.size())
+              return setGrid();
+            if (!valid)
+              return false;
+            for (size_t i=0; i<home.size(); i++)
+              if (home[i]!=spc->p[i]) {
+                cells.update(i, home[i], spc->p[i]);
+                home[i]=spc->p[i];
+              }
+            return true;
+          }
+
+          void _trialMove() FOVERRIDE {
+            if (!sync())
+              return; // no valid grid
+            double smax = cells.cellLength() - sigmax; // safe step for 27-cell search
+            int k = slp_global.rand() % 3;             // direction
+            int i = igroup->random();
+            double left=ell;
+            int n=0;
+            while (left>0) {
+              double s=std::min(left, smax), tmin=pc::infty;
+              int jmin=-1;
+              cells.forNeighbors(spc->p[i], [&](int j) {
+                  if (j!=i) {
+                    double t=collision(i,j,k);
+                    if (t<tmin) {
+                      tmin=t;
+                      jmin=j;
+                    }
+                  }
+                  });
+              bool hit = (tmin<s);
+              if (hit)
+                s=tmin;
+              Point old=spc->p[i];
+              spc->p[i][k] += s;
+              spc->geo.boundary(spc->p[i]);
+              spc->trial[i] = spc->p[i];
+              cells.update(i, old, spc->p[i]);
+              home[i] = spc->p[i];
+              left-=s;
+              if (hit) {
+                i=jmin;
+                n++;
+              }
+            }
+            events+=n;
+          }
+
+          double _energyChange() FOVERRIDE { return 0; }
+          void _acceptMove() FOVERRIDE {}
+          void _rejectMove() FOVERRIDE {}
+
+        public:
+          EventChain(InputMap &in, Energy::Energybase<Tspace> &e, Tspace &s, string pfx="mv_eventchain") :
+            base(e,s,pfx), igroup(nullptr), volume(0), valid(false) {
+              static_assert(
+                  std::is_base_of<Geometry::Cuboid, Tgeometry>::value,
+                  "Event chain requires a Cuboid geometry" );
+              base::title="Event Chain (hard spheres)";
+              ell = in.get<double>(pfx+"_length", 10, "Event chain length (angstrom)");
+              base::runfraction = in.get<double>(pfx+"_runfraction", 1.0);
+            }
+
+          /** @brief Group to pick initial particles from */
+          void setGroup(Group &g) { igroup=&g; }
+      };
+
     /**
      * @brief Rotate single particles
      *
@@ -594,7 +1212,7 @@ namespace Faunus {
           using base::w;
           using base::gsize;
           using base::genericdp;
-          Geometry::QuaternionRotate rot;
+          Geometry::QuaternionRotateBase<typename Tspace::GeometryType> rot;
           string _info();
           void _trialMove();
         public:
@@ -672,6 +1290,15 @@ namespace Faunus {
      * tr.setGroup(g);              // specify which group to move
      * tr.move();                   // do the move
      * ~~~
+     *
+     * In rigid body mode (`pfx_rigid`) each group is stored as a `RigidBody`
+     * template with a mass center and orientation. A trial move then only
+     * changes the pose, and the trial coordinates are written from the
+     * template in a single pass when the energy is evaluated, instead of
+     * rotating and translating the existing coordinates. A rejected move
+     * that never reached the energy evaluation costs no particle copies.
+     * The template is rebuilt whenever the group has been changed by
+     * other moves.
      */
     template<class Tspace>
       class TranslateRotate : public Movebase<Tspace> {
@@ -698,6 +1325,11 @@ namespace Faunus {
           double dp_trans;   //!< Translational displacement parameter
           double angle;      //!< Temporary storage for current angle
           Point dir;         //!< Translation directions (default: x=y=z=1). This will be set by setGroup()
+          bool rigid;        //!< Use rigid body templates for groups
+          std::map<int, RigidBody> bodies; //!< Rigid body template for each group (key: first particle)
+          RigidBody* body;   //!< Body of current rigid trial move, if any
+          bool materialized; //!< Trial coordinates written for `body`
+          void materialize();
         public:
           TranslateRotate(InputMap&, Energy::Energybase<Tspace>&, Tspace&, string="transrot");
           void setGroup(Group&); //!< Select Group to move
@@ -715,6 +1347,8 @@ namespace Faunus {
      * :---------------- | :-------------------------------------
      * `pfx_transdp`     | Translational displacement [angstrom]
      * `pfx_rotdp`       | Rotational displacement [radians]
+     * `pfx_earlyreject` | Pre-draw Metropolis threshold and truncate energy sums (default: no)
+     * `pfx_rigid`       | Move groups as rigid bodies from body frame templates (default: no)
      */
     template<class Tspace>
       TranslateRotate<Tspace>::TranslateRotate(InputMap &in,Energy::Energybase<Tspace> &e, Tspace &s, string pfx) : base(e,s,pfx) {
@@ -732,6 +1366,10 @@ namespace Faunus {
         this->runfraction = in.get<double>(base::prefix+"_runfraction",1.0);
         if (dp_rot<1e-6 && dp_trans<1e-6)
           this->runfraction=0;
+        base::earlyRejection = in.get<bool>(base::prefix+"_earlyreject",false);
+        rigid = in.get<bool>(base::prefix+"_rigid",false);
+        body=nullptr;
+        materialized=false;
 #ifdef ENABLE_MPI
         mpi=nullptr;
 #endif
@@ -754,6 +1392,27 @@ namespace Faunus {
       void TranslateRotate<Tspace>::_trialMove() {
         assert(igroup!=nullptr);
         Point p;
+        for (auto i : *igroup)
+          base::moved.push_back(i);
+        if (rigid) {
+          body = &bodies[igroup->front()];
+          if (!body->uptodate(spc->p, *igroup))
+            body->setTemplate(spc->geo, spc->p, *igroup); // new or changed by other moves
+          materialized=false;
+          angle=0;
+          if (dp_rot>1e-6) {
+            p.ranunit(slp_global);
+            angle=dp_rot*slp_global.randHalf();
+            body->rotate(p, angle);
+          }
+          if (dp_trans>1e-6) {
+            p.x()=dir.x() * dp_trans * slp_global.randHalf();
+            p.y()=dir.y() * dp_trans * slp_global.randHalf();
+            p.z()=dir.z() * dp_trans * slp_global.randHalf();
+            igroup->cm_trial.translate(spc->geo, p);
+          }
+          return; // coordinates are written by materialize()
+        }
         if (dp_rot>1e-6) {
           p.ranunit(slp_global);             // random unit vector
           p=igroup->cm+p;                    // set endpoint for rotation
@@ -768,13 +1427,33 @@ namespace Faunus {
         }
       }
 
+    /** @brief Write trial coordinates of the rigid body pose */
+    template<class Tspace>
+      void TranslateRotate<Tspace>::materialize() {
+        assert(body!=nullptr);
+        body->materialize(spc->geo, *igroup, igroup->cm_trial, spc->trial);
+        if (angle!=0) {
+          auto aa = body->trialRotation();
+          Geometry::QuaternionRotateBase<typename Tspace::GeometryType> vrot;
+          vrot.setAxis(spc->geo, Point(0,0,0), aa.axis(), aa.angle());
+          for (auto i : *igroup)
+            spc->trial[i].rotate(vrot);     // rotate internal coordinates
+        }
+        materialized=true;
+      }
+
     template<class Tspace>
       void TranslateRotate<Tspace>::_acceptMove() {
         double r2 = spc->geo.sqdist( igroup->cm, igroup->cm_trial );
         sqrmap_t[ igroup->name ] += r2;
         sqrmap_r[ igroup->name ] += pow(angle*180/pc::pi, 2);
         accmap[ igroup->name ] += 1;
+        if (body!=nullptr && !materialized)
+          materialize();
         igroup->accept(*spc);
+        if (body!=nullptr)
+          body->accept(spc->p, *igroup);
+        body=nullptr;
       }
 
     template<class Tspace>
@@ -782,6 +1461,15 @@ namespace Faunus {
         sqrmap_t[ igroup->name ] += 0;
         sqrmap_r[ igroup->name ] += 0;
         accmap[ igroup->name ] += 0;
+        if (body!=nullptr) {
+          body->undo();
+          if (!materialized) {
+            igroup->cm_trial = igroup->cm; // trial coordinates untouched
+            body=nullptr;
+            return;
+          }
+        }
+        body=nullptr;
         igroup->undo(*spc);
       }
 
@@ -790,6 +1478,9 @@ namespace Faunus {
         if (dp_rot<1e-6 && dp_trans<1e-6)
           return 0;
 
+        if (body!=nullptr && !materialized)
+          materialize();
+
         for (auto i : *igroup)
           if ( spc->geo.collision( spc->trial[i], Geometry::Geometrybase::BOUNDARY ) )
             return pc::infty;
@@ -812,6 +1503,12 @@ namespace Faunus {
         }
 #endif
 
+        if (base::earlyRejection) {
+          uold += pot->g2all_bound(spc->p, *igroup, pc::infty);
+          return unew + pot->g2all_bound(spc->trial, *igroup,
+              uold + base::duMax - unew) - uold;
+        }
+
         for (auto g : spc->groupList()) {
           if (g!=igroup) {
             unew += pot->g2g(spc->trial, *g, *igroup);
@@ -829,6 +1526,8 @@ namespace Faunus {
         std::ostringstream o;
         o << pad(SUB,w,"Max. translation") << pm << dp_trans/2 << textio::_angstrom << endl
           << pad(SUB,w,"Max. rotation") << pm << dp_rot/2*180/pc::pi << textio::degrees << endl;
+        if (rigid)
+          o << pad(SUB,w,"Rigid bodies") << bodies.size() << endl;
         if ( !directions.empty() ) {
           o << indent(SUB) << "Group Move directions:" << endl;
           for (auto &m : directions)
@@ -865,6 +1564,91 @@ namespace Faunus {
         }
       }
 
+    /**
+     * @brief Molecular translation and rotation biased by force and torque
+     *
+     * Works as `TranslateRotate` but the rotation vector and the
+     * translation are drawn by `ForceBias` along the torque (about the
+     * mass center) and net force on the group from all other particles,
+     * evaluated with `Energybase::f_p2p()`. The reverse move, evaluated with
+     * the forces of the trial configuration, is the negated rotation and
+     * translation and the acceptance is corrected accordingly. The keywords
+     * are those of `TranslateRotate` plus `pfx_forcebias` and `pfx_lambda`
+     * (see `ForceBiasedTranslation`).
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class ForceBiasedTranslateRotate : public TranslateRotate<Tspace> {
+        private:
+          typedef TranslateRotate<Tspace> base;
+          typedef typename Tspace::ParticleVector Tpvec;
+          ForceBias bias;
+          Point dt, dr;    // trial translation and rotation vector
+          double lnPfwd;   // log forward proposal density
+
+          /** @brief Net force and torque on group from all other particles */
+          void forceTorque(const Tpvec &p, const Point &cm, Point &F, Point &T) {
+            Group &g = *base::igroup;
+            F.setZero();
+            T.setZero();
+            for (auto i : g) {
+              Point f(0,0,0);
+              for (int j=0; j<(int)p.size(); j++)
+                if (!g.find(j))
+                  f += base::pot->f_p2p(p[i], p[j]);
+              F += f;
+              T += base::spc->geo.vdist(p[i], cm).cross(f);
+            }
+          }
+
+          double lnProposal(const Point &t, const Point &r, const Point &F, const Point &T) {
+            return bias.lnProposal(t, F, base::dp_trans, base::dir)
+              + bias.lnProposal(r, T, base::dp_rot, Point(1,1,1));
+          }
+
+          string _info() FOVERRIDE {
+            return bias.info(base::w) + base::_info();
+          }
+
+          void _trialMove() FOVERRIDE {
+            assert(base::igroup!=nullptr);
+            Point F, T;
+            forceTorque(base::spc->p, base::igroup->cm, F, T);
+            dr.setZero();
+            dt.setZero();
+            base::angle=0;
+            if (base::dp_rot>1e-6) {
+              dr = bias.propose(T, base::dp_rot, Point(1,1,1));
+              base::angle = dr.norm();
+              if (base::angle>0)
+                base::igroup->rotate(*base::spc, base::igroup->cm + dr/base::angle, base::angle);
+            }
+            if (base::dp_trans>1e-6) {
+              dt = bias.propose(F, base::dp_trans, base::dir);
+              base::igroup->translate(*base::spc, dt);
+            }
+            lnPfwd = lnProposal(dt, dr, F, T);
+          }
+
+          double _energyChange() FOVERRIDE {
+            double du = base::_energyChange();
+            base::alternateReturnEnergy = du;
+            if (du==pc::infty || (base::dp_rot<1e-6 && base::dp_trans<1e-6))
+              return du;
+            Point F, T;
+            forceTorque(base::spc->trial, base::igroup->cm_trial, F, T);
+            return du - ( lnProposal(-dt, -dr, F, T) - lnPfwd );
+          }
+
+        public:
+          ForceBiasedTranslateRotate(InputMap &in, Energy::Energybase<Tspace> &e, Tspace &s,
+              string pfx="transrot") : base(in,e,s,pfx), bias(in,pfx), lnPfwd(0) {
+            base::title="Force Biased Group Rotation/Translation";
+            base::useAlternateReturnEnergy=true; // return energy without bias correction
+          }
+      };
+
     /**
       @brief Translates/rotates many groups simultaneously
       */
@@ -935,6 +1719,7 @@ namespace Faunus {
           double _energyChange() FOVERRIDE {
             int N=(int)base::spc->groupList().size();
             double du=0;
+            double uext = base::pot->external(base::spc->trial) - base::pot->external(base::spc->p);
 
 #ifdef ENABLE_MPI
             if (!pairlist.empty()) {
@@ -952,7 +1737,7 @@ namespace Faunus {
                 du += base::pot->g_external(base::spc->trial, *gi) - base::pot->g_external(base::spc->p, *gi);
               }
 
-              return Faunus::MPI::reduceDouble(*mpi, du);
+              return Faunus::MPI::reduceDouble(*mpi, du) + uext;
             }
 #endif
 
@@ -963,7 +1748,7 @@ namespace Faunus {
                   - base::pot->g2g(base::spc->p,*pairlist[i].first,*pairlist[i].second);
               for (auto g : base::spc->groupList())
                 du += base::pot->g_external(base::spc->trial, *g) - base::pot->g_external(base::spc->p, *g);
-              return du;
+              return du + uext;
             }
 
             if (!gVec.empty()) {
@@ -977,7 +1762,7 @@ namespace Faunus {
               for (auto g : base::spc->groupList())
                 du += base::pot->g_external(base::spc->trial, *g) - base::pot->g_external(base::spc->p, *g);
             }
-            return du;
+            return du + uext;
           }
           void setGroup(std::vector<Group*> &v) {
             gVec.clear();
@@ -1034,7 +1819,7 @@ namespace Faunus {
           using base::dp_trans;
           using base::dp_rot;
           using base::dir;
-          Geometry::QuaternionRotate vrot;
+          Geometry::QuaternionRotateBase<typename Tspace::GeometryType> vrot;
           vector<int> cindex; //!< index of mobile ions to move with group
           void _trialMove();
           void _acceptMove();
@@ -1172,6 +1957,8 @@ namespace Faunus {
           uold += pot->i_external(spc->p, i);
           unew += pot->i_external(spc->trial, i);
         }
+        unew += pot->external(spc->trial);
+        uold += pot->external(spc->p);
 
         // pair energy between static and moved particles
         double du=0;
@@ -1379,7 +2166,7 @@ namespace Faunus {
           double angle;      //!< Current rotation angle
           vector<int> index; //!< Index of particles to rotate
           //Geometry::VectorRotate vrot;
-          Geometry::QuaternionRotate vrot;
+          Geometry::QuaternionRotateBase<typename Tspace::GeometryType> vrot;
           AcceptanceMap<string> accmap;
         public:
           CrankShaft(InputMap&, Energy::Energybase<Tspace>&, Tspace&, string="crank");
@@ -1456,7 +2243,8 @@ namespace Faunus {
         for (auto i : index)
           if ( spc->geo.collision( spc->trial[i], Geometry::Geometrybase::BOUNDARY ) )
             return pc::infty;
-        du=pot->g_internal(spc->trial, *gPtr) - pot->g_internal(spc->p, *gPtr);
+        du=pot->g_internal(spc->trial, *gPtr) - pot->g_internal(spc->p, *gPtr)
+          + pot->external(spc->trial) - pot->external(spc->p);
         for (auto i : index)
           du+=pot->i_external(spc->trial,i) - pot->i_external(spc->p,i);
         for (auto g : spc->groupList())
@@ -1681,6 +2469,8 @@ namespace Faunus {
         if (unew==pc::infty)
           return pc::infty;       // early rejection
         double uold = pot->g_external(spc->p, *gPtr) + pot->g_internal(spc->p, *gPtr);
+        unew += pot->external(spc->trial);
+        uold += pot->external(spc->p);
 
         for (auto g : spc->groupList()) {
           if (g!=gPtr) {
@@ -1703,128 +2493,230 @@ namespace Faunus {
         return o.str();
       }
 
-    /** 
-     * @brief Grand canonical move for molecular species
-     * @warning Under construction!
+    /**
+     * @brief Grand canonical insertion and deletion of flexible chains
      * @date Lund, 2014
+     *
+     * Linear molecules are grown bead by bead using configurational-bias
+     * Monte Carlo (doi:10.1080/00268979200100061). For each bead, `K` trial
+     * positions are generated - the first bead uniformly in the container,
+     * the following on a sphere of radius equal to the bond length around
+     * the previous bead - and one is picked with probability
+     * \f$ e^{-\beta u_j}/w \f$ where \f$ w=\sum_j e^{-\beta u_j} \f$. The
+     * Rosenbluth weight, \f$ W=\prod w/K \f$, enters the acceptance,
+     *
+     * \f[
+     *   acc(N\rightarrow N+1) = \frac{zV}{N+1}W_{new}, \quad
+     *   acc(N\rightarrow N-1) = \frac{N}{zV}\frac{1}{W_{old}}
+     * \f]
+     *
+     * where the old weight is obtained by retracing the chain to be
+     * deleted with the actual positions as the first trial. The activity, `z`,
+     * refers to an ideal, freely jointed chain. Trial energies are evaluated
+     * in parallel using OpenMP.
+     *
+     * All molecules must be in a single Group with molecule size set
+     * (`Group::setMolSize()`) and the atom sequence is taken from the first
+     * molecule. At least one molecule is always kept. Bonds are rigid so
+     * any bond potential should be left out of the Hamiltonian
+     * for these molecules. Only particle based energies are used, i.e.
+     * `all2p()`, `p2p()` and `p_external()`.
+     *
+     * Key               | Description
+     * :---------------- | :---------------------------------------------------
+     * `pfx_activity`    | Molecular activity (mol/l)
+     * `pfx_bondlength`  | Bond length (default: -1 = from first molecule)
+     * `pfx_trials`      | Number of trial positions per bead, `K` (default: 10)
+     * `pfx_runfraction` | Chance of running (default: 1)
      */
     template<class Tspace>
-    class GCMolecular : public Movebase<Tspace> {
-    private:
-      typedef Movebase<Tspace> base;
-      typedef std::map<short, Average<double> > map_type;
-      bool use2D;
-      Point dir;
-      int inmol; // molecule to be inserted
-      int outmol; // molecule to be deleted
-      int imol;
-      int idel;
-      
-      // structure for molecular data
-      struct MolData {
-        string name;
-        double activity; // in 1/angstrom^3 (3D) or 1/angstrom^2 (2D)
-        typename Tspace::ParticleVector p;
+      class GCMolecular : public Movebase<Tspace> {
+        private:
+          typedef Movebase<Tspace> base;
+          typedef typename Tspace::ParticleType Tparticle;
+          typedef typename Tspace::ParticleVector Tpvec;
+          using base::spc;
+          using base::pot;
+          using base::w;
+
+          Group* gPtr;         // GC molecules *must* be in this group
+          Tpvec chain;         // chain being grown or retraced
+          Tpvec env;           // particles excluding molecule to be deleted
+          int K;               // number of trial positions
+          int idel;            // molecule to delete (-1 if insertion)
+          double bond;         // bond length (A)
+          double lnz;          // log activity (1/A^3)
+          double lnW;          // log Rosenbluth weight
+          double uchain;       // interaction energy of chain (kT)
+          Average<double> Nmol;// average number of molecules
+
+          double grow(const Tpvec&, bool);
+          string _info();
+          void _trialMove();
+          void _acceptMove();
+          void _rejectMove();
+          double _energyChange();
+
+          void _test(UnitTest &t) {
+            t(base::prefix+"_conc", Nmol.avg()/spc->geo.getVolume()/pc::Nav/1e-27);
+          }
+
+        public:
+          GCMolecular(InputMap&, Energy::Energybase<Tspace>&, Tspace&, Group&, string="gcmol");
       };
-      
-      std::vector<MolData> molvec;
-      
-      template<typename pvec>
-      void randomRotate(pvec &p) {
-        Geometry::QuaternionRotate rot;
-      }
-      
-      template<typename pvec>
-      void randomState(pvec &p) {
-        Point a;
-        base::spc->randomPos(a);
-        a=a*dir+offset;
-        auto dp = a-Geometry::massCenter(base::spc->geo, p);
-        for (auto i : &p) {
-          i=i+dp;
-          base::spc->geo.boundary(i);
-        }
-      }
-      
-      int randomMol() {
-        return slp_global.rand() % molvec.size();
+
+    template<class Tspace>
+      GCMolecular<Tspace>::GCMolecular(InputMap &in, Energy::Energybase<Tspace> &e,
+          Tspace &s, Group &g, string pfx) : base(e,s,pfx) {
+        base::title="Grand Canonical Chain Insertion (CBMC)";
+        base::useAlternateReturnEnergy=true;
+        w=30;
+        gPtr=&g;
+        assert(!g.empty() && g.numMolecules()>0 && "Group must contain at least one molecule");
+        int n=g.size()/g.numMolecules();
+        chain.assign(spc->p.begin()+g.front(), spc->p.begin()+g.front()+n);
+        lnz = std::log( in.get<double>(pfx+"_activity", 0, "Molecular activity (mol/l)")*pc::Nav*1e-27 );
+        K = std::max(1, in.get<int>(pfx+"_trials", 10, "CBMC trial positions per bead"));
+        bond = in.get<double>(pfx+"_bondlength", -1, "CBMC bond length (A)");
+        if (bond<0 && n>1)
+          bond = spc->geo.dist(chain[0], chain[1]);
+        base::runfraction = in.get<double>(pfx+"_runfraction", 1.0);
+        idel=-1;
+        lnW=uchain=0;
       }
-      
-      bool insert() {
-        inmol = randomMol();
-        randomState( molvec[inmol] );
-        return true;
+
+    /**
+     * @param p Particles to interact with (excluding the chain)
+     * @param retrace If true, the current positions in `chain` are used
+     *        as the first trial for each bead (deletion)
+     * @return Logarithm of Rosenbluth weight, -infinity if all trials fail
+     */
+    template<class Tspace>
+      double GCMolecular<Tspace>::grow(const Tpvec &p, bool retrace) {
+        double lnw=0;
+        Tpvec trial(K);
+        vector<double> u(K);
+        uchain=0;
+        for (size_t n=0; n<chain.size(); n++) {
+          for (int j=0; j<K; j++) {
+            trial[j]=chain[n];
+            if (retrace && j==0)
+              continue;
+            if (n==0)
+              spc->geo.randompos(trial[j]);
+            else {
+              Point v;
+              v.ranunit(slp_global);
+              trial[j] = chain[n-1] + bond*v;
+              spc->geo.boundary(trial[j]);
+            }
+          }
+#pragma omp parallel for if (K*p.size()>10000)
+          for (int j=0; j<K; j++) {
+            if (spc->geo.collision(trial[j], Geometry::Geometrybase::BOUNDARY))
+              u[j]=pc::infty;
+            else {
+              u[j] = pot->all2p(p, trial[j]) + pot->p_external(trial[j]);
+              for (size_t m=0; m<n; m++)
+                u[j] += pot->p2p(trial[j], chain[m]);
+            }
+          }
+          double wsum=0;
+          for (auto ui : u)
+            wsum+=std::exp(-ui);
+          if (wsum<=0)
+            return -pc::infty;
+          int j=0;
+          if (!retrace) {      // pick trial according to Boltzmann weight
+            double r=slp_global()*wsum, c=std::exp(-u[0]);
+            while (c<r && j<K-1)
+              c+=std::exp(-u[++j]);
+          }
+          chain[n]=trial[j];
+          uchain+=u[j];
+          lnw+=std::log(wsum/K);
+        }
+        return lnw;
       }
-      
-    protected:
-      bool deleteBool;
-      string _info();
-      void _acceptMove() FOVERRIDE;
-      void _rejectMove() FOVERRIDE;
-      
-      double _energyChange() FOVERRIDE {
-        double uold=0;//, unew=0;
-        
-        // count molecules
-        int N=0;
-        for (auto g : base::spc->groupList())
-          if (g->isMolecular())
-            if ( g->name==molvec[imol] )
-              N++;
-        
-        // calc. volume or area
-        double V = base::spc->geo.getVolume();
-        if (use2D)
-          V = V / base::spc->geo.len.z();
-        
-        // in case of deletion
-        if (deleteBool) {
-          auto gi = base::spc->findGroup(idel);
-          for (auto gj : base::spc->groupList())
-            if (gi!=gj)
-              uold += base::pot->g2g( base::spc->p, *gi, *gj )
-                + base::pot->g_external( base::spc->p, *gi );
+
+    template<class Tspace>
+      void GCMolecular<Tspace>::_trialMove() {
+        int n=chain.size();
+        if (slp_global()<0.5) {
+          idel=-1;
+          lnW=grow(spc->p, false);
         } else {
-          // in case of insertion
-          
+          idel=slp_global.rand() % gPtr->numMolecules();
+          int f=gPtr->front()+idel*n;
+          std::copy(spc->p.begin()+f, spc->p.begin()+f+n, chain.begin());
+          env.clear();
+          env.insert(env.end(), spc->p.begin(), spc->p.begin()+f);
+          env.insert(env.end(), spc->p.begin()+f+n, spc->p.end());
+          lnW=grow(env, true);
         }
+      }
 
-        return 0;
-          
-      }
-      
-      void _trialMove() {
-        
-        // insert
-        if (slp_global()>0.5) {
-          inmol = randomMol();
-          outmol=-1;
-          randomState( molvec[inmol] );
+    template<class Tspace>
+      double GCMolecular<Tspace>::_energyChange() {
+        double V=spc->geo.getVolume();
+        int N=gPtr->numMolecules();
+        base::alternateReturnEnergy=0;
+        if (idel<0) {
+          if (lnW==-pc::infty)
+            return pc::infty;
+          base::alternateReturnEnergy=uchain;
+          return -( lnz + std::log(V/(N+1)) + lnW );
         }
-        // delete
-        else {
-          inmol=-1;
-          outmol=randomMol();
-          //for (auto i : base::spc->groupList())
-          //  if ()
-          
+        if (N<=1)
+          return pc::infty;  // keep at least one molecule
+        base::alternateReturnEnergy=-uchain;
+        return -( std::log(N/V) - lnz - lnW );
+      }
+
+    /**
+     * Inserted chains are appended to the end of the group and deleted
+     * chains are replaced by the last chain in the group.
+     */
+    template<class Tspace>
+      void GCMolecular<Tspace>::_acceptMove() {
+        int n=chain.size();
+        if (idel<0) {
+          int b=gPtr->back();
+          for (auto &a : chain)
+            spc->insert(a, gPtr->back()); // expands group; old last particle pushed to end
+          std::rotate(spc->p.begin()+b, spc->p.begin()+b+n, spc->p.begin()+b+n+1);
+          std::rotate(spc->trial.begin()+b, spc->trial.begin()+b+n, spc->trial.begin()+b+n+1);
+        } else {
+          int f=gPtr->front()+idel*n, l=gPtr->back()-n+1;
+          if (f!=l)
+            for (int i=0; i<n; i++)
+              spc->p[f+i] = spc->trial[f+i] = spc->p[l+i];
+          for (int i=0; i<n; i++)
+            spc->erase(gPtr->back());
         }
-        
-      }
-      using base::spc;
-      map_type accmap; //!< acceptance map
-      
-    public:
-      Point offset;
-      GCMolecular(InputMap &in, Energy::Energybase<Tspace> &e, Tspace &s, string pfx="gcmol_") : base(e,s,pfx) {
-        dir=Point(1,1,1);
-        offset=Point(0,0,0);
-        use2D=in(pfx+"2d", true);
-        if (use2D)
-          dir.z()=1;
+        Nmol += gPtr->numMolecules();
       }
-    };
-    
+
+    template<class Tspace>
+      void GCMolecular<Tspace>::_rejectMove() {
+        Nmol += gPtr->numMolecules();
+      }
+
+    template<class Tspace>
+      string GCMolecular<Tspace>::_info() {
+        using namespace textio;
+        std::ostringstream o;
+        double V=spc->geo.getVolume();
+        o << pad(SUB,w,"Activity") << std::exp(lnz)/pc::Nav/1e-27 << " mol/l" << endl
+          << pad(SUB,w,"Chain length") << chain.size() << endl
+          << pad(SUB,w,"Bond length") << bond << _angstrom << endl
+          << pad(SUB,w,"Trial positions per bead") << K << endl;
+        if (Nmol.cnt>0)
+          o << pad(SUB,w,"Average molecules") << Nmol.avg() << endl
+            << pad(SUB,w,"Average concentration") << Nmol.avg()/V/pc::Nav/1e-27 << " mol/l" << endl;
+        return o.str();
+      }
+
     /**
      * @brief Isobaric volume move
      *
@@ -1845,7 +2737,7 @@ namespace Faunus {
      */
     template<class Tspace>
       class Isobaric : public Movebase<Tspace> {
-        private:
+        protected:
           typedef Movebase<Tspace> base;
           using base::spc;
           using base::pot;
@@ -2008,20 +2900,277 @@ namespace Faunus {
       }
 
 
+    /**
+     * @brief Isobaric volume move with scaling-decomposed energies
+     *
+     * @details For an isotropic volume change, \f$V\rightarrow V^{\prime}\f$,
+     * atomic coordinates are scaled by \f$s=(V^{\prime}/V)^{1/3}\f$ and
+     * any energy term that is a homogeneous function of the pair distance,
+     * \f$u(sr)=s^{-n}u(r)\f$, can be obtained from its old value by
+     * a single multiplication. Examples are `Potential::Coulomb` (n=1)
+     * and `Potential::R12Repulsion` (n=12). This move keeps the atom-atom
+     * part of such terms in a cache and evaluates only the following exactly:
+     *
+     * - interactions involving molecular groups (mass center scaling is not homogeneous)
+     * - the non-scalable remainder of the Hamiltonian (pressure, cut-off potentials etc.)
+     *
+     * Intra-molecular energies are unaffected by mass center scaling and are
+     * skipped. Before each trial the cache is checked against a snapshot of the
+     * atomic particles so that displacements made by other moves are folded
+     * in at O(N) cost per displaced particle rather than O(N^2).
+     * Example:
+     *
+     * ~~~
+     * auto pot = Energy::Nonbonded<Tspace,Potential::Coulomb>(in)
+     *   + Energy::ExternalPressure<Tspace>(in);
+     * Move::IsobaricScaled<Tspace> npt(in,pot,spc);
+     * npt.addScalable(pot.first, 1);  // Coulomb ~ 1/r
+     * npt.setRemainder(pot.second);   // evaluated exactly
+     * ~~~
+     *
+     * The scalable terms must implement `p2p()` and together with the remainder
+     * they must add up to the full Hamiltonian. For non-isotropic scaling
+     * (i.e. `cuboid_scaledir XY`) the move falls back to `Isobaric`.
+     *
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class IsobaricScaled : public Isobaric<Tspace> {
+        private:
+          typedef Isobaric<Tspace> base;
+          typedef Energy::Energybase<Tspace> Tenergybase;
+          typedef typename Tspace::p_vec Tpvec;
+          using base::spc;
+          using base::pot;
+          using base::w;
+          using base::oldV;
+          using base::newV;
+
+          struct ScalableTerm {
+            Tenergybase* pot; //!< Energy term
+            double n;         //!< Scaling exponent, u(s*r) = s^-n u(r)
+            double u;         //!< Cached atom-atom energy at current volume
+          };
+
+          vector<ScalableTerm> terms; //!< Scalable energy terms
+          Tenergybase* rest;          //!< Non-scalable remainder (nullptr=none)
+          vector<int> atomic;         //!< Particle index in atomic groups
+          Tpvec ref;                  //!< Atomic particles for which the cache is valid
+          bool cacheValid;
+          bool isotropic;             //!< True if current trial is an isotropic scaling
+          double s;                   //!< Linear scaling factor of current trial
+          Average<double> fracUpdated;//!< Fraction of cached particles updated before trial
+          unsigned long int cntFallback; //!< Number of trials evaluated with Isobaric
+
+          void setSpaceAll() {
+            for (auto &t : terms)
+              t.pot->setSpace(*spc);
+            if (rest!=nullptr)
+              rest->setSpace(*spc);
+          }
+
+          vector<int> atomicIndex() const {
+            vector<int> v;
+            for (auto g : spc->groupList())
+              if (g->isAtomic())
+                for (auto i : *g)
+                  v.push_back(i);
+            return v;
+          }
+
+          static bool changed(const typename Tspace::ParticleType &a,
+              const typename Tspace::ParticleType &b) {
+            return (a.x()!=b.x() || a.y()!=b.y() || a.z()!=b.z()
+                || a.charge!=b.charge || a.id!=b.id);
+          }
+
+          /** @brief Atom-atom energy from scratch */
+          double atomicEnergy(Tenergybase &e, const Tpvec &p) {
+            double u=0;
+            auto &g = spc->groupList();
+            for (size_t i=0; i<g.size(); i++)
+              if (g[i]->isAtomic()) {
+                u += e.g_internal(p, *g[i]);
+                for (size_t j=i+1; j<g.size(); j++)
+                  if (g[j]->isAtomic())
+                    u += e.g2g(p, *g[i], *g[j]);
+              }
+            return u;
+          }
+
+          /**
+           * Bring cached energies in sync with `Space::p`. Particles
+           * displaced since the last call are updated one by one so that
+           * each pair is counted with the correct old and new positions.
+           */
+          void syncCache() {
+            vector<int> index = atomicIndex();
+            if (cacheValid && index==atomic && ref.size()==atomic.size()) {
+              vector<size_t> moved;
+              for (size_t k=0; k<atomic.size(); k++)
+                if (changed(ref[k], spc->p[atomic[k]]))
+                  moved.push_back(k);
+              if (!atomic.empty())
+                fracUpdated += double(moved.size()) / atomic.size();
+              if (4*moved.size() < atomic.size()) {
+                for (auto k : moved) {
+                  auto &pnew = spc->p[ atomic[k] ];
+                  for (auto &t : terms) {
+                    double du=0;
+                    for (size_t l=0; l<ref.size(); l++)
+                      if (l!=k)
+                        du += t.pot->p2p(pnew, ref[l]) - t.pot->p2p(ref[k], ref[l]);
+                    t.u += du;
+                  }
+                  ref[k] = pnew;
+                }
+                return;
+              }
+            }
+            atomic = index;
+            ref.resize(atomic.size());
+            for (size_t k=0; k<atomic.size(); k++)
+              ref[k] = spc->p[ atomic[k] ];
+            for (auto &t : terms)
+              t.u = atomicEnergy(*t.pot, spc->p);
+            cacheValid=true;
+            fracUpdated += 1;
+          }
+
+          /** @brief Energy of all terms that must be evaluated exactly */
+          double exactEnergy(const Tpvec &p) {
+            double u=0;
+            auto &g = spc->groupList();
+            for (auto &t : terms) {
+              for (size_t i=0; i<g.size(); i++) {
+                if (g[i]->isRange())
+                  u += t.pot->g_internal(p, *g[i]);
+                for (size_t j=i+1; j<g.size(); j++)
+                  if ( !(g[i]->isAtomic() && g[j]->isAtomic()) )
+                    u += t.pot->g2g(p, *g[i], *g[j]);
+              }
+            }
+            if (rest!=nullptr) {
+              for (size_t i=0; i<g.size(); i++) {
+                u += rest->g_external(p, *g[i]);
+                if (g[i]->numMolecules()>1)
+                  u += rest->g_internal(p, *g[i]);
+                for (size_t j=i+1; j<g.size(); j++)
+                  u += rest->g2g(p, *g[i], *g[j]);
+              }
+              u += rest->external(p);
+            }
+            return u;
+          }
+
+          double _energyChange() FOVERRIDE {
+            if (base::dV<1e-6)
+              return 0;
+            s = cbrt(newV/oldV);
+            Point probe(1,1,1);
+            spc->geo.scale(probe, newV);
+            isotropic = (!terms.empty() && (probe-Point(s,s,s)).squaredNorm()<1e-12);
+            if (!isotropic) {
+              cntFallback++;
+              cacheValid=false;
+              double du = base::_energyChange();
+              setSpaceAll();
+              return du;
+            }
+
+            syncCache();
+            double uold = exactEnergy(spc->p);
+
+            spc->geo.setVolume(newV);
+            pot->setSpace(*spc);
+            setSpaceAll();
+
+            for (auto g : spc->groupList())
+              for (auto i : *g)
+                if ( spc->geo.collision( spc->trial[i], Geometry::Geometrybase::BOUNDARY ) )
+                  return pc::infty;
+
+            double unew = exactEnergy(spc->trial);
+            for (auto &t : terms)
+              unew += t.u * (std::pow(s,-t.n) - 1);
+            return unew-uold;
+          }
+
+          void _acceptMove() FOVERRIDE {
+            base::_acceptMove();
+            setSpaceAll();
+            if (isotropic && cacheValid) {
+              for (auto &t : terms)
+                t.u *= std::pow(s,-t.n);
+              for (size_t k=0; k<atomic.size(); k++)
+                ref[k] = spc->p[ atomic[k] ];
+            }
+          }
+
+          void _rejectMove() FOVERRIDE {
+            base::_rejectMove();
+            setSpaceAll();
+          }
+
+          string _info() FOVERRIDE {
+            using namespace textio;
+            std::ostringstream o;
+            o << base::_info()
+              << pad(SUB,w,"Scalable terms") << terms.size() << endl;
+            for (auto &t : terms)
+              o << pad(SUBSUB,w-2,t.pot->name) << "n = " << t.n << endl;
+            o << pad(SUB,w,"Exact remainder") << ((rest!=nullptr) ? rest->name : "none") << endl;
+            if (base::cnt>0)
+              o << pad(SUB,w,"Cache updates/trial") << fracUpdated.avg()*100 << percent << endl
+                << pad(SUB,w,"Non-isotropic fallbacks") << cntFallback << endl;
+            return o.str();
+          }
+
+        public:
+          template<class Tenergy>
+            IsobaricScaled(InputMap &in, Tenergy &e, Tspace &s, string pfx="npt") :
+              base(in,e,s,pfx), rest(nullptr), cacheValid(false), isotropic(false), cntFallback(0) {
+                this->title+=" (scaled energies)";
+              }
+
+          /**
+           * @brief Add energy term that is homogeneous in the pair distance
+           * @param e Energy term implementing `p2p()`, `g2g()` and `g_internal()`
+           * @param n Exponent so that \f$u(sr)=s^{-n}u(r)\f$
+           */
+          void addScalable(Tenergybase &e, double n) {
+            e.setSpace(*spc);
+            terms.push_back( {&e, n, 0} );
+            cacheValid=false;
+          }
+
+          /** @brief Set energy term(s) that cannot be scaled and must be evaluated exactly */
+          void setRemainder(Tenergybase &e) {
+            e.setSpace(*spc);
+            rest=&e;
+          }
+      };
+
     /**
      * @brief Auxillary class for tracking atomic species
      * @date Malmo 2011
      *
      * This class keeps track of individual particle positions based on particle type (id).
-     * It contains functions to insert and erase particles while automatically moving particles
-     * above the deletion or insertion point in sync.
+     * All tracked particles must belong to the same Group which is passed to `insert()`
+     * and `erase()`. Particles are appended to the end of the group and removed by
+     * moving the last particle of the group into the vacated slot ("swap-remove").
+     * Tracked indices are therefore never shifted and, together with a reverse
+     * lookup table, all operations are constant time. Particles *beyond* the group
+     * are shifted by Space as usual, but are not tracked.
      *
      * Example:
      *
      *     AtomTracker track(myspace);
-     *     track.insert( myparticle, 20 );        // insert particle into Space at position 20
+     *     track.add( 20 );                       // track existing particle 20 in Space
+     *     track.insert( myparticle, mygroup );   // insert particle at end of mygroup
      *     ...
      *     int i=track[ myparticle.id ].random(); // pick a random particle of type myparticle.id
+     *     track.erase(i, mygroup);
      */
     template<class Tspace>
       class AtomTracker {
@@ -2035,11 +3184,15 @@ namespace Faunus {
               Tindex random();                  //!< Pick random particle index
           };
           std::map<particle::Tid,data> map;
+          vector<particle::Tid> ids;            // tracked atom types
+          vector<int> slot;                     // position of particle index in data::index (-1 if untracked)
+          void setSlot(Tindex, int);
         public:
           AtomTracker(Tspace&);
           particle::Tid randomAtomType() const; //!< Select a random atomtype from the list
-          bool insert(const particle&, Tindex); //!< Insert particle into Space and track position
-          bool erase(Tindex);                   //!< Delete particle from Space at specific particle index
+          void add(Tindex);                     //!< Track existing particle in Space
+          bool insert(const particle&, Group&); //!< Insert particle at end of Group and track position
+          bool erase(Tindex, Group&);           //!< Delete particle from Space and Group at specific particle index
           data& operator[] (particle::Tid);     //!< Access operator to atomtype data
           void clear();                         //!< Clear all atom lists (does not touch Space)
           bool empty();                         //!< Test if atom list is empty
@@ -2052,18 +3205,15 @@ namespace Faunus {
 
     template<class Tspace>
       particle::Tid AtomTracker<Tspace>::randomAtomType() const {
-        assert(!map.empty() && "No atom types have been added yet");
-        vector<particle::Tid> vid;
-        vid.reserve( map.size() );
-        for (auto &m : map)
-          vid.push_back(m.first);
-        std::random_shuffle(vid.begin(), vid.end());
-        return vid.front();
+        assert(!ids.empty() && "No atom types have been added yet");
+        return ids[ slp_global.rand() % ids.size() ];
       }
 
     template<class Tspace>
       void AtomTracker<Tspace>::clear() {
         map.clear();
+        ids.clear();
+        slot.clear();
       }
 
     template<class Tspace>
@@ -2071,8 +3221,8 @@ namespace Faunus {
 
     template<class Tspace>
       typename AtomTracker<Tspace>::Tindex AtomTracker<Tspace>::data::random() {
-        std::random_shuffle( index.begin(), index.end() );
-        return index.back();
+        assert(!index.empty());
+        return index[ slp_global.rand() % index.size() ];
       }
 
     template<class Tspace>
@@ -2080,46 +3230,75 @@ namespace Faunus {
         return map[id];
       }
 
+    template<class Tspace>
+      void AtomTracker<Tspace>::setSlot(Tindex i, int s) {
+        if (i>=(int)slot.size())
+          slot.resize(i+1, -1);
+        slot[i]=s;
+      }
+
+    template<class Tspace>
+      void AtomTracker<Tspace>::add(Tindex i) {
+        auto id=spc->p[i].id;
+        if (map.find(id)==map.end())
+          ids.push_back(id);
+        auto &v=map[id].index;
+        setSlot(i, v.size());
+        v.push_back(i);
+      }
+
     /**
-     * This will insert a particle into Space and at the same time make sure
-     * that all other particles are correctly tracked.
+     * This will insert a particle at the end of the Group, `g`, and track it.
+     * The Space insertion is done just before the last group particle
+     * (which expands the group) whereafter the two are swapped so that
+     * no tracked index changes.
      */
     template<class Tspace>
-      bool AtomTracker<Tspace>::insert(const particle &a, Tindex index) {
-        assert( a.id == spc->p[ map[a.id].index.back() ].id && "Id mismatch");
-        spc->insert(a, index); // insert into Space
-        for (auto &m : map)    // loop over all maps
-          for (auto &i : m.second.index) // and their particle index
-            if (i>=index) i++; // push forward particles beyond inserted particle
-        map[a.id].index.push_back(index); // finally, add particle to appripriate map
+      bool AtomTracker<Tspace>::insert(const particle &a, Group &g) {
+        assert(!g.empty() && "Group must contain at least one particle");
+        Tindex b=g.back();
+        spc->insert(a, b);     // a at b; old last particle at b+1
+        std::swap(spc->p[b], spc->p[b+1]);
+        std::swap(spc->trial[b], spc->trial[b+1]);
+        assert(g.back()==b+1);
+        add(b+1);
         return true;
       }
 
+    /**
+     * The last particle in the Group, `g`, is moved into the slot of the
+     * deleted particle and the (now redundant) last slot is erased from Space.
+     */
     template<class Tspace>
-      bool AtomTracker<Tspace>::erase(AtomTracker<Tspace>::Tindex index) {
-        spc->erase(index);
-        bool deleted=false;
-        for (auto &m : map) {
-          auto f=std::find(m.second.index.begin(), m.second.index.end(), index);
-          if (f!=m.second.index.end()) {
-            m.second.index.erase(f);
-            deleted=true;
-            break;
+      bool AtomTracker<Tspace>::erase(Tindex i, Group &g) {
+        assert(g.find(i) && "Particle must be in group");
+        if (i>=(int)slot.size() || slot[i]<0)
+          return false;
+        auto &v=map[spc->p[i].id].index;
+        int s=slot[i];
+        v[s]=v.back();         // swap-remove from type list
+        slot[v[s]]=s;
+        v.pop_back();
+        slot[i]=-1;
+
+        Tindex b=g.back();
+        if (i!=b) {
+          spc->p[i]=spc->p[b];
+          spc->trial[i]=spc->trial[b];
+          if (b<(int)slot.size() && slot[b]>=0) {
+            map[spc->p[i].id].index[ slot[b] ]=i;
+            slot[i]=slot[b];
+            slot[b]=-1;
           }
         }
-        if (deleted)
-          for (auto &m : map)
-            for (auto &i : m.second.index)
-              if (i>index) i--;
+        spc->erase(b);
 
 #ifndef NDEBUG
-        assert(deleted && "Could not delete specified index");
-        for (auto &m : map) {
-          for (auto &i : m.second.index)
-            assert( m.first == spc->p[i].id && "Particle id mismatch");
-        }
+        for (auto &m : map)
+          for (auto &j : m.second.index)
+            assert( m.first == spc->p[j].id && "Particle id mismatch");
 #endif
-        return deleted;
+        return true;
       }
 
     /**
@@ -2127,6 +3306,19 @@ namespace Faunus {
      * @author Bjorn Persson and Mikael Lund
      * @date Lund 2010-2011
      * @warning Untested for asymmetric salt in this branch
+     *
+     * Optionally, ions can be inserted only into cavities, i.e. empty cells
+     * of a coarse occupancy grid spanning the container (Sphere or Cuboid).
+     * The ideal volume in the acceptance criterion is then replaced by the
+     * cavity volume, \f$V_c\f$, before insertion and after deletion,
+     * respectively; deletions that do not leave the removed ions in
+     * empty cells are rejected as the reverse insertion is impossible.
+     *
+     * Key                  | Description
+     * :------------------- | :------------------------------------------------
+     * `pfx_runfraction`    | Chance of running (default: 1)
+     * `pfx_cavitybias`     | Insert into empty grid cells only (default: no)
+     * `pfx_cavitygrid`     | Cavity grid spacing (default: 2 A)
      */
     template<class Tspace>
       class GrandCanonicalSalt : public Movebase<Tspace> {
@@ -2156,6 +3348,27 @@ namespace Faunus {
 
           Group* saltPtr;  // GC ions *must* be in this group
 
+          struct cavitygrid {
+            bool enabled;
+            double spacing, volume;     // requested spacing and container volume when set
+            int n[3];                   // number of cells in each direction
+            Point lo, h;                // lower corner and cell size
+            double vcell;               // cell volume (A^3)
+            vector<bool> inside;        // cell overlaps container
+            vector<int> cnt;            // number of particles in cell
+            vector<int> empty;          // empty cells inside container
+            int cell(const Point &a) const {
+              int c[3];
+              for (int d=0; d<3; d++)
+                c[d] = std::min(n[d]-1, std::max(0, int(std::floor((a[d]-lo[d])/h[d]))));
+              return (c[0]*n[1]+c[1])*n[2]+c[2];
+            }
+          } cavity;
+          double Vins, Vdel;           // (cavity) volume for insertion and deletion
+          Average<double> cavfrac;     // average cavity volume fraction
+          void setCavityGrid(double);
+          void updateCavities();
+
           // unit testing
           void _test(UnitTest &t) {
             for (auto &m : map) {
@@ -2179,8 +3392,68 @@ namespace Faunus {
           base::runfraction = in.get<double>(pfx+"_runfraction",1.0);
           saltPtr=&g;
           add(*saltPtr);
+          Vins=Vdel=0;
+          cavity.enabled = in.get<bool>(pfx+"_cavitybias", false,
+              "Cavity biased salt insertion");
+          if (cavity.enabled)
+            setCavityGrid( in.get<double>(pfx+"_cavitygrid", 2.0,
+                  "Cavity grid spacing (A)") );
         }
 
+    template<class Tspace>
+      void GrandCanonicalSalt<Tspace>::setCavityGrid(double spacing) {
+        const Geometry::Geometrybase *g = &spc->geo;
+        double V = spc->geo.getVolume(), r=-1;
+        Point len;
+        if (dynamic_cast<const Geometry::Cuboid*>(g)!=nullptr)
+          len = dynamic_cast<const Geometry::Cuboid*>(g)->len;
+        else if (dynamic_cast<const Geometry::Sphere*>(g)!=nullptr
+#ifdef HYPERSPHERE
+            && dynamic_cast<const Geometry::hyperSphere*>(g)==nullptr
+#endif
+            ) {
+          r = std::cbrt( 3*V/(4*pc::pi) );
+          len = Point(2*r,2*r,2*r);
+        } else {
+          std::cerr << "# Cavity bias requires Sphere or Cuboid geometry - disabled.\n";
+          cavity.enabled=false;
+          return;
+        }
+        cavity.spacing=spacing;
+        cavity.volume=V;
+        cavity.lo = -0.5*len;
+        for (int d=0; d<3; d++) {
+          cavity.n[d] = std::max(1, int(len[d]/spacing));
+          cavity.h[d] = len[d]/cavity.n[d];
+        }
+        cavity.vcell = cavity.h.x()*cavity.h.y()*cavity.h.z();
+        int N=cavity.n[0]*cavity.n[1]*cavity.n[2];
+        cavity.cnt.resize(N);
+        cavity.inside.assign(N, true);
+        if (r>0)     // exclude cells entirely outside sphere
+          for (int i=0; i<cavity.n[0]; i++)
+            for (int j=0; j<cavity.n[1]; j++)
+              for (int k=0; k<cavity.n[2]; k++) {
+                Point a = cavity.lo + Point(i,j,k).cwiseProduct(cavity.h);
+                Point b = a + cavity.h;
+                Point c = Point(0,0,0).cwiseMax(a).cwiseMin(b); // nearest point to origin
+                cavity.inside[(i*cavity.n[1]+j)*cavity.n[2]+k] = (c.squaredNorm()<r*r);
+              }
+      }
+
+    template<class Tspace>
+      void GrandCanonicalSalt<Tspace>::updateCavities() {
+        if (spc->geo.getVolume()!=cavity.volume)
+          setCavityGrid(cavity.spacing);
+        std::fill(cavity.cnt.begin(), cavity.cnt.end(), 0);
+        for (auto &a : spc->p)
+          cavity.cnt[ cavity.cell(a) ]++;
+        cavity.empty.clear();
+        for (size_t c=0; c<cavity.cnt.size(); c++)
+          if (cavity.inside[c] && cavity.cnt[c]==0)
+            cavity.empty.push_back(c);
+      }
+
     template<class Tspace>
       void GrandCanonicalSalt<Tspace>::add(Group &g) {
         assert( g.isAtomic() && "Salt group must be atomic" );
@@ -2191,7 +3464,7 @@ namespace Faunus {
           if ( atom[id].activity>1e-10 && abs(atom[id].charge)>1e-10 ) {
             map[id].p=atom[id];
             map[id].chempot=log( atom[id].activity*pc::Nav*1e-27); // beta mu
-            tracker[id].index.push_back(i);
+            tracker.add(i);
           }
         }
         assert(!tracker.empty() && "No GC ions found!");
@@ -2219,8 +3492,21 @@ namespace Faunus {
             trial_insert.reserve(Na+Nb);
             do trial_insert.push_back( map[ida].p ); while (--Na>0);
             do trial_insert.push_back( map[idb].p ); while (--Nb>0);
-            for (auto &p : trial_insert)
-              spc->geo.randompos(p);
+            Vins = spc->geo.getVolume();
+            if (cavity.enabled) {
+              updateCavities();
+              Vins = cavity.empty.size()*cavity.vcell;
+              cavfrac += Vins / spc->geo.getVolume();
+              if (!cavity.empty.empty())
+                for (auto &p : trial_insert) {
+                  int c = cavity.empty[ slp_global.rand() % cavity.empty.size() ];
+                  int k = c % cavity.n[2], j = (c/cavity.n[2]) % cavity.n[1], i = c/(cavity.n[1]*cavity.n[2]);
+                  Point x( i+slp_global(), j+slp_global(), k+slp_global() );
+                  p = cavity.lo + x.cwiseProduct(cavity.h);
+                }
+            } else
+              for (auto &p : trial_insert)
+                spc->geo.randompos(p);
             break;
           case 1:
             trial_delete.reserve(Na+Nb);
@@ -2237,6 +3523,22 @@ namespace Faunus {
                 trial_delete.push_back(i);
             }
             assert( (int)trial_delete.size()==Na+Nb );
+            Vdel = spc->geo.getVolume();
+            if (cavity.enabled) {
+              updateCavities();
+              vector<int> cells;
+              for (auto i : trial_delete) {
+                cells.push_back( cavity.cell(spc->p[i]) );
+                cavity.cnt[ cells.back() ]--;
+              }
+              std::sort(cells.begin(), cells.end());
+              cells.erase( std::unique(cells.begin(), cells.end()), cells.end() );
+              int nempty = cavity.empty.size() + cells.size();
+              for (auto c : cells)
+                if (cavity.cnt[c]!=0)
+                  nempty=0;    // removed ions not in cavity - reverse move impossible
+              Vdel = nempty*cavity.vcell;
+            }
             break;
         }
       }
@@ -2245,8 +3547,11 @@ namespace Faunus {
       double GrandCanonicalSalt<Tspace>::_energyChange() {
         int Na=0, Nb=0;            // number of added or deleted ions
         double idfactor=1;
-        double uold=0, unew=0, V=spc->geo.getVolume();
+        double uold=0, unew=0, V=trial_insert.empty() ? Vdel : Vins;
         double potold=0, potnew=0; // energy change due to interactions
+        base::alternateReturnEnergy=0;
+        if (V<=0)
+          return pc::infty;        // no cavities available
         if ( !trial_insert.empty() ) {
           for (auto &t : trial_insert)     // count added ions
             if (t.id==map[ida].p.id) Na++; else Nb++;
@@ -2295,12 +3600,12 @@ namespace Faunus {
       void GrandCanonicalSalt<Tspace>::_acceptMove() {
         if ( !trial_insert.empty() ) {
           for (auto &p : trial_insert)
-            tracker.insert(p, saltPtr->back());
+            tracker.insert(p, *saltPtr);
         }
         else if ( !trial_delete.empty() ) {
           std::sort(trial_delete.rbegin(), trial_delete.rend()); //reverse sort
           for (auto i : trial_delete)
-            tracker.erase(i);
+            tracker.erase(i, *saltPtr);
         }
         double V = spc->geo.getVolume();
         map[ida].rho += tracker[ida].index.size() / V;
@@ -2319,7 +3624,12 @@ namespace Faunus {
         char s=10;
         using namespace textio;
         std::ostringstream o;
-        o << pad(SUB,w,"Number of GC species") << endl << endl;
+        o << pad(SUB,w,"Number of GC species") << map.size() << endl;
+        if (cavity.enabled)
+          o << pad(SUB,w,"Cavity grid") << cavity.n[0] << "x" << cavity.n[1]
+            << "x" << cavity.n[2] << " (" << cavity.h.x() << _angstrom << ")" << endl
+            << pad(SUB,w,"Average cavity fraction") << cavfrac.avg() << endl;
+        o << endl;
         o << setw(4) << "" << std::left
           << setw(s) << "Ion" << setw(s) << "activity"
           << setw(s+4) << bracket("c/M") << setw(s+6) << bracket( gamma+pm )
@@ -2630,7 +3940,8 @@ namespace Faunus {
     template<class Tspace>
       double SwapCharge<Tspace>::_energyChange() {
         return base::pot->i_total(spc->trial, jp) + base::pot->i_total(spc->trial, ip) 
-          - base::pot->i_total(spc->p, jp) - base::pot->i_total(spc->p, ip);
+          - base::pot->i_total(spc->p, jp) - base::pot->i_total(spc->p, ip)
+          + base::pot->external(spc->trial) - base::pot->external(spc->p);
       }
     template<class Tspace>
       void SwapCharge<Tspace>::_acceptMove() {
@@ -2740,7 +4051,7 @@ namespace Faunus {
         endpoint.y()=-(x2-x1)/(y2-y1)+y2;
         endpoint.z()=startpoint.z();
         double angle=pc::pi;
-        Geometry::QuaternionRotate vrot;
+        Geometry::QuaternionRotateBase<typename Tspace::GeometryType> vrot;
         vrot.setAxis(spc->geo, startpoint, endpoint, angle); //rot around startpoint->endpoint vec
         for (auto i : *igroup)
           spc->trial[i] = vrot(spc->trial[i]);
@@ -2770,6 +4081,8 @@ namespace Faunus {
         if (unew==pc::infty)
           return pc::infty;       // early rejection
         double uold = pot->g_external(spc->p, *igroup);
+        unew += pot->external(spc->trial);
+        uold += pot->external(spc->p);
 
         for (auto g : spc->groupList()) {
           if (g!=igroup) {
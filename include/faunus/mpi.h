@@ -1,5 +1,3 @@
-#ifdef ENABLE_MPI
-
 #ifndef FAU_MPI_H
 #define FAU_MPI_H
 
@@ -8,14 +6,58 @@
 #include <faunus/point.h>
 #include <faunus/slump.h>
 #include <faunus/textio.h>
+#include <faunus/energy.h>
+#ifdef ENABLE_MPI
 #include <mpi.h>
 #endif
+#endif
 
 namespace Faunus {
 
   /**
    * @brief Namespace for Message Parsing Interface (MPI) functionality
    */
+  namespace MPI {
+
+    /**
+     * @brief Split N items into nproc parts
+     *
+     * This returns a pair with the first and last
+     * item for the given rank.
+     */
+    template<class T=int>
+      std::pair<T,T> splitEven(int rank, int nproc, T N) {
+        T M = nproc;
+        T i = rank;
+        T beg=(N*i)/M;
+        T end=(N*i+N)/M-1;
+        return std::pair<T,T>(beg,end);
+      }
+
+    /**
+     * @brief Split the upper pair triangle of N items into nproc parts
+     *
+     * Row `i` holds the `N-1-i` pairs `(i,j>i)`. This returns the first and
+     * last row for the given rank, chosen such that all ranks get
+     * roughly the same number of *pairs* rather than rows.
+     */
+    template<class T=int>
+      std::pair<T,T> splitTriangle(int rank, int nproc, T N) {
+        auto row = [&](int r) -> T { // first row with r/nproc of pairs before it
+          if (r>=nproc)
+            return N;
+          double b=2.0*N-1, t=0.5*double(N)*(N-1)*r/nproc;
+          return std::max( T(0), std::min( N, T( std::ceil( 0.5*(b-std::sqrt(b*b-8*t)) ) ) ) );
+        };
+        return std::pair<T,T>( row(rank), row(rank+1)-1 );
+      }
+
+  }//namespace
+}//namespace
+
+#ifdef ENABLE_MPI
+namespace Faunus {
+
   namespace MPI {
 
     /**
@@ -64,19 +106,16 @@ namespace Faunus {
         int _master;       //!< Rank number of the master
     };
 
-    /**
-     * @brief Split N items into nproc parts
-     *
-     * This returns a pair with the first and last
-     * item for the current rank.
-     */
+    /** @brief Split N items into parts for the current rank, see `splitEven(int,int,T)` */
     template<class T=int>
       std::pair<T,T> splitEven(MPIController &mpi, T N) {
-        T M = mpi.nproc();
-        T i = mpi.rank();
-        T beg=(N*i)/M;
-        T end=(N*i+N)/M-1;
-        return std::pair<T,T>(beg,end);
+        return splitEven<T>(mpi.rank(), mpi.nproc(), N);
+      }
+
+    /** @brief Split pair triangle for the current rank, see `splitTriangle(int,int,T)` */
+    template<class T=int>
+      std::pair<T,T> splitTriangle(MPIController &mpi, T N) {
+        return splitTriangle<T>(mpi.rank(), mpi.nproc(), N);
       }
 
     /**
@@ -91,6 +130,32 @@ namespace Faunus {
       return sum;
     }
 
+    /**
+     * @brief Element-wise reduced sum of vector, in place
+     *
+     * All ranks must pass vectors of equal length.
+     */
+    inline void reduceVector(MPIController &mpi, std::vector<double> &v, MPI_Op op=MPI_SUM) {
+      MPI_Allreduce(MPI_IN_PLACE,v.data(),(int)v.size(),MPI_DOUBLE,op,mpi.comm);
+    }
+
+    /**
+     * @brief Merge penalty function of all ranks (collective call)
+     *
+     * Sums bias and histogram changes since the last merge over all ranks
+     * and synchronizes the penalty increment to the smallest.
+     * See `Analysis::PenaltyGrid`.
+     */
+    template<class Tpenalty>
+      void mergePenalty(MPIController &mpi, Tpenalty &pen) {
+        std::vector<double> sb, sh, f(1,pen.penalty());
+        pen.getChanges(sb,sh);
+        reduceVector(mpi, sb);
+        reduceVector(mpi, sh);
+        reduceVector(mpi, f, MPI_MIN);
+        pen.addRemote(sb, sh, f[0]);
+      }
+
     /*!
      * \brief Class for transmitting floating point arrays over MPI
      * \note If you change the floatp typedef, remember also to change to change to/from
@@ -319,6 +384,152 @@ namespace Faunus {
         cout << "!!!!!!!!!!!\n";
     }
 
+    /**
+     * @brief Distributes pair energy evaluations over the ranks of a communicator
+     *
+     * This energy class derives from a pair additive energy class, `Tenergy`
+     * (typically `Energy::Nonbonded`), and splits `i2all()`, `g2g()`,
+     * `g_internal()` as well as `g2all()` and `all2all()` over all ranks.
+     * Work is divided by the number of particle pairs, not by groups, so that
+     * a single large group is shared equally. Each call ends with one
+     * `MPI_Allreduce`. Calls involving less than `mpi_minpairs` pairs are
+     * evaluated in full on every rank without communication.
+     *
+     * Because the energy is replicated via collective calls, all ranks must
+     * perform identical Monte Carlo moves, i.e. use the same random number
+     * seed. `Tenergy` must derive from `Energy::Nonbonded` or
+     * `Energy::NonbondedVector`. If it specializes `i2all()`, `g2g()` or
+     * `g_internal()` (a cell list, for example) these are used as they are
+     * on every rank, i.e. not distributed, as they may no longer be plain
+     * sums of `i2i()`. Non-pair terms should be added outside, for example
+     *
+     *     MPI::MPIController mpi;
+     *     auto pot = MPI::EnergySplit<Energy::Nonbonded<Tspace,Tpairpot> >(in,mpi)
+     *       + Energy::ExternalPressure<Tspace>(in);
+     *
+     * Do not combine with moves that distribute work themselves (the `mpi`
+     * pointer in `Move::TranslateRotate`), as collective calls would then
+     * no longer be matched across ranks.
+     *
+     * Keyword        | Description
+     * :------------- | :-------------------------------------------------
+     * `mpi_minpairs` | Minimum number of pairs to distribute (default: 1000)
+     *
+     * @date Lund 2014
+     */
+    template<class Tenergy>
+      class EnergySplit : public Tenergy {
+        private:
+          typedef Tenergy base;
+          typedef typename Tenergy::SpaceType Tspace;
+          typedef typename Energy::Energybase<Tspace>::Tpvec Tpvec;
+          typedef typename std::remove_reference<decltype(std::declval<Tenergy&>().pairpot)>::type Tpairpot;
+          typedef Energy::Nonbonded<Tspace,Tpairpot> Tplain;
+          typedef Energy::NonbondedVector<Tspace,Tpairpot> Tplainvec;
+
+          // true if member is the plain pair loop of `Nonbonded` or `NonbondedVector`
+          template<class T, class T1, class T2>
+            struct isPlain {
+              static const bool value = std::is_same<T,T1>::value || std::is_same<T,T2>::value;
+            };
+
+          static const bool plain_i2all = isPlain<decltype(&Tenergy::i2all),
+                 decltype(&Tplain::i2all), decltype(&Tplainvec::i2all)>::value;
+          static const bool plain_g2g = isPlain<decltype(&Tenergy::g2g),
+                 decltype(&Tplain::g2g), decltype(&Tplainvec::g2g)>::value;
+          static const bool plain_g_internal = isPlain<decltype(&Tenergy::g_internal),
+                 decltype(&Tplain::g_internal), decltype(&Tplainvec::g_internal)>::value;
+
+          MPIController *mpiPtr;
+          long minpairs;
+
+          bool distribute(long npairs) const {
+            return (mpiPtr->nproc()>1 && npairs>=minpairs);
+          }
+
+          /** @brief Sum `f(k)` over a flattened range of `n` pairs, distributed */
+          template<class Tfunction>
+            double splitSum(long n, Tfunction f) {
+              double u=0;
+              if (!distribute(n)) {
+                for (long k=0; k<n; k++)
+                  u+=f(k);
+                return u;
+              }
+              auto s = splitEven(*mpiPtr, n);
+              for (long k=s.first; k<=s.second; k++)
+                u+=f(k);
+              return reduceDouble(*mpiPtr, u);
+            }
+
+        public:
+          EnergySplit(InputMap &in, MPIController &mpi) : base(in), mpiPtr(&mpi) {
+            minpairs = in.get<long>("mpi_minpairs", 1000, "Minimum pairs to distribute over MPI ranks");
+            base::name+=" (MPI split)";
+          }
+
+          double i2all(Tpvec &p, int i) FOVERRIDE {
+            if (!plain_i2all || !distribute( long(p.size())-1 ))
+              return base::i2all(p,i);
+            return splitSum( long(p.size())-1, [&](long k) {
+                int j = (k<i) ? k : k+1;
+                return base::i2i(p,i,j); } );
+          }
+
+          double g2g(const Tpvec &p, Group &g1, Group &g2) FOVERRIDE {
+            if (g1.empty() || g2.empty())
+              return 0;
+            if (g1.find(g2.front()) || g1.find(g2.back()) || g2.find(g1.front()))
+              return base::g2g(p,g1,g2); // overlapping groups
+            long n2=g2.size();
+            if (!plain_g2g || !distribute( g1.size()*n2 ))
+              return base::g2g(p,g1,g2);
+            return splitSum( g1.size()*n2, [&](long k) {
+                return base::i2i(p, g1.front()+k/n2, g2.front()+k%n2); } );
+          }
+
+          double g_internal(const Tpvec &p, Group &g) FOVERRIDE {
+            int n=g.size();
+            if (!plain_g_internal || !distribute( long(n)*(n-1)/2 ))
+              return base::g_internal(p,g);
+            double u=0;
+            auto s = splitTriangle(*mpiPtr, n);
+            for (int i=g.front()+s.first; i<=g.front()+s.second; i++)
+              for (int j=i+1; j<=g.back(); j++)
+                u+=base::i2i(p,i,j);
+            return reduceDouble(*mpiPtr, u);
+          }
+
+          /** @brief Energy of group with all particles outside it */
+          double g2all(const Tpvec &p, Group &g) {
+            if (g.empty())
+              return 0;
+            long m=long(p.size())-g.size();
+            return splitSum( g.size()*m, [&](long k) {
+                long j=k%m;
+                if (j>=g.front())
+                  j+=g.size();
+                return base::i2i(p, g.front()+k/m, j); } );
+          }
+
+          /** @brief Sum of all pair energies in particle vector */
+          double all2all(const Tpvec &p) {
+            int n=p.size();
+            double u=0;
+            if (!distribute( long(n)*(n-1)/2 )) {
+              for (int i=0; i<n-1; i++)
+                for (int j=i+1; j<n; j++)
+                  u+=base::i2i(p,i,j);
+              return u;
+            }
+            auto s = splitTriangle(*mpiPtr, n);
+            for (int i=s.first; i<=s.second; i++)
+              for (int j=i+1; j<n; j++)
+                u+=base::i2i(p,i,j);
+            return reduceDouble(*mpiPtr, u);
+          }
+      };
+
   } //end of mpi namespace
 }//end of faunus namespace
 
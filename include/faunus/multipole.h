@@ -263,56 +263,191 @@ namespace Faunus {
       double r1i = sqrt(r2i);
       double r3i = r1i*r2i;
       double r5i = r3i*r2i;
-      double WAB = r.transpose()*quadB*r;
+      Eigen::Vector3d rd = r.template cast<double>(); // mixed precision
+      double WAB = rd.dot( quadB.template cast<double>()*rd );
       WAB = 3*WAB*r5i - quadB.trace()*r3i;
-      double WBA = r.transpose()*quadA*r;
+      double WBA = rd.dot( quadA.template cast<double>()*rd );
       WBA = 3*WBA*r5i - quadA.trace()*r3i;
       return (qA*WAB + qB*WBA);
     }
 
+  /**
+   * @brief Cubic Hermite interpolation of `M` functions on a shared uniform grid
+   *
+   * The interval is found by direct indexing, so evaluating all `M`
+   * functions costs a single index calculation followed by `M` cubic
+   * polynomials stored next to each other. The grid is refined until the
+   * absolute error is below the requested tolerance.
+   */
+  template<int M>
+    class HermiteTable {
+      private:
+        double xmin, ih;
+        int n;                   // number of intervals
+        std::vector<double> c;   // 4*M coefficients per interval
+
+        inline const double* coeff(double x, double &t) const {
+          t = (x-xmin)*ih;
+          int i = std::min( int(t), n-1 );
+          t -= i;
+          return &c[4*M*i];
+        }
+
+      public:
+        HermiteTable() : xmin(0), ih(0), n(0) {}
+
+        bool empty() const { return c.empty(); }
+
+        /**
+         * @brief Tabulate in `[x0,x1]`
+         * @param f Function filling the `M` values at `x`, `f(x,u)`
+         * @param tol Absolute tolerance
+         * @return False if not converged
+         */
+        bool generate(std::function<void(double,double*)> f, double x0, double x1, double tol) {
+          xmin = x0;
+          for (n=16; n<(1<<22); n*=2) {
+            double h = (x1-x0)/n, dx = 1e-3*h;
+            std::vector<double> u((n+1)*M), du((n+1)*M);
+            double a[M], b[M];
+            for (int i=0; i<=n; i++) {
+              double x = x0+i*h;
+              f(x, &u[i*M]);
+              f(x+dx, a);
+              f(x-dx, b);
+              for (int k=0; k<M; k++)
+                du[i*M+k] = h*(a[k]-b[k])/(2*dx);
+            }
+            c.resize(4*M*n);
+            for (int i=0; i<n; i++)
+              for (int k=0; k<M; k++) {
+                double *ci = &c[4*(M*i+k)];
+                double u0=u[i*M+k], u1=u[(i+1)*M+k], d0=du[i*M+k], d1=du[(i+1)*M+k];
+                ci[0] = u0;
+                ci[1] = d0;
+                ci[2] = 3*(u1-u0) - 2*d0 - d1;
+                ci[3] = 2*(u0-u1) + d0 + d1;
+              }
+            ih = 1/h;
+            double err=0;
+            for (int i=0; i<n; i++)
+              for (double s : {0.25, 0.5, 0.75}) {
+                double x = x0+(i+s)*h, v[M];
+                f(x, a);
+                eval(x, v);
+                for (int k=0; k<M; k++)
+                  err = std::max(err, std::fabs(v[k]-a[k]));
+              }
+            if (err<tol)
+              return true;
+          }
+          return false;
+        }
+
+        /** @brief All `M` functions at `x` */
+        inline void eval(double x, double *u) const {
+          double t;
+          const double *ci = coeff(x,t);
+          for (int k=0; k<M; k++, ci+=4)
+            u[k] = ci[0]+t*(ci[1]+t*(ci[2]+t*ci[3]));
+        }
+
+        /** @brief Function `k` at `x` */
+        inline double eval(double x, int k) const {
+          double t;
+          const double *ci = coeff(x,t) + 4*k;
+          return ci[0]+t*(ci[1]+t*(ci[2]+t*ci[3]));
+        }
+    };
+
   /**
    * @brief Base class for Wolf based interactions
    *
    * The idea is that this class has no dependencies and is
    * to be used as a helper class for other classes.
+   *
+   * All kernels are `const` and keep per-pair intermediates in a
+   * `wdata` structure owned by the caller, so that a single instance can
+   * be shared between threads. Evaluating several kernels for the same
+   * pair, call `calcWolfData()` once and pass the result to each kernel.
+   * For finite cutoffs the radial damping functions are interpolated from
+   * a `HermiteTable` in @f$r^2@f$ built at construction. The tables hold the damping
+   * factors, i.e. the kernels times @f$r^{2n+1}@f$, to an absolute tolerance
+   * of @f$10^{-9}@f$ which is below the error of `erfc_x()`. Separations
+   * below the table range are evaluated directly.
    */
   class WolfBase {
-      
-    struct wdata {
+    public:
+      /** @brief Per-pair intermediates */
+      struct wdata {
         double r1i_d, r2i, der_dT0c, T1, T1c_r1i, der_dT1c_r1i, T21, T22, T2c2_r2i, der_dT2c1, der_dT2c2_r2i;
       };
+
     private:
       double rc1, rc1i, rc1i_d, rc2i, kappa, kappa2, constant;
       double dT0c, T1c_rc1, dT1c_rc1, T2c1, T2c2_rc2, dT2c1, dT2c2_rc2;
-      wdata data;
+      double tabmin2;             // lower bound of table (r^2)
+      HermiteTable<3> tab;        // r*T0, r^3*T1 and r^5*T22 as functions of r^2
+      bool tabulated;
+
+      /** @brief Damped radial functions, erfc(kr)/r, T1 and T22, evaluated directly */
+      void radial(double r2, double &T0, double &T1, double &T22) const {
+        double r2i = 1/r2;
+        double r1i = sqrt(r2i);
+        double expK = constant*exp(-kappa2*r2);
+        T0 = erfc_x(kappa/r1i)*r1i;
+        T1 = (expK + T0)*r2i;
+        T22 = (3.*T0*r2i + (3.*r2i + 2.*kappa2)*expK)*r2i;
+      }
+
+      void radial(double r2, double &T0) const {
+        double r1i = 1/sqrt(r2);
+        T0 = erfc_x(kappa/r1i)*r1i;
+      }
 
     public:
-        void calcWolfData(const Point &r) {
-          data.r2i = 1/r.squaredNorm();
-          double r1i = sqrt(data.r2i);
-          data.r1i_d = erfc_x(kappa/r1i)*r1i;
-          double der = (1/r1i) - rc1;
-          der = 0;
-          double expK = constant*exp(-kappa2/data.r2i);
-          data.der_dT0c = der*dT0c;
-          data.T1 = (expK + data.r1i_d)*data.r2i;
-          data.T1c_r1i = T1c_rc1*r1i;
-          data.der_dT1c_r1i = der*dT1c_rc1*r1i;
-          data.T21 = -(data.r1i_d + expK)*data.r2i;
-          data.T22 = (3.*data.r1i_d*data.r2i + (3.*data.r2i + 2.*kappa2)*expK)*data.r2i;
-          data.T2c2_r2i = T2c2_rc2*data.r2i;
-          data.der_dT2c1 = der*dT2c1;
-          data.der_dT2c2_r2i = der*dT2c2_rc2*data.r2i;
-          data.T2c2_r2i = 0.0; // No Energy
-          data.der_dT2c2_r2i = 0.0; // No Force
+      /**
+       * @brief Radial intermediates for separation `r`
+       * @param r Direction @f$ r_A - r_B @f$
+       * @param d Destination
+       * @param forceShift Also shift the force to zero at the cutoff. If false,
+       *        as used by `MultipoleWolf`, only the potential is shifted and the
+       *        dipole-dipole @f$ r^{-5} @f$ term is not.
+       * @return False if beyond the cutoff
+       */
+      template<class Tvec>
+        bool calcWolfData(const Tvec &r, wdata &d, bool forceShift=true) const {
+          double r2 = r.squaredNorm();
+          d.r2i = 1/r2;
+          if (d.r2i < rc2i)
+            return false;
+          double r1i = sqrt(d.r2i);
+          if (tabulated && r2>tabmin2) {
+            double r3i = r1i*d.r2i, u[3];
+            tab.eval(r2, u);
+            d.r1i_d = u[0]*r1i;
+            d.T1 = u[1]*r3i;
+            d.T22 = u[2]*r3i*d.r2i;
+          } else
+            radial(r2, d.r1i_d, d.T1, d.T22);
+          double der = forceShift ? (1/r1i) - rc1 : 0;
+          d.der_dT0c = der*dT0c;
+          d.T1c_r1i = T1c_rc1*r1i;
+          d.der_dT1c_r1i = der*dT1c_rc1*r1i;
+          d.T21 = -d.T1;
+          d.der_dT2c1 = der*dT2c1;
+          d.T2c2_r2i = forceShift ? T2c2_rc2*d.r2i : 0;
+          d.der_dT2c2_r2i = der*dT2c2_rc2*d.r2i;
+          return true;
         }
-      
+
       /**
        * @brief Constructor
        * @param alpha Dampening factor (inverse angstrom)
        * @param rcut Cutoff distance (angstrom)
+       * @param rmin Lower bound for tabulated radial functions (angstrom)
        */
-      WolfBase(double alpha, double rcut) {
+      WolfBase(double alpha, double rcut, double rmin=1.0) {
         kappa = alpha;
         kappa2 = kappa*kappa;
         constant = 2*kappa/sqrt(pc::pi);
@@ -336,6 +471,17 @@ namespace Faunus {
         dT1c_rc1 = dT1c_rc1*rc1;
         T2c2_rc2 = T2c2_rc2*rc2;
         dT2c2_rc2 = dT2c2_rc2*rc2;
+
+        tabmin2 = rmin*rmin;
+        tabulated = (rc1<1e4 && rmin<rc1);
+        if (tabulated) {
+          tabulated = tab.generate( [&](double r2, double *u) {
+              double r1 = sqrt(r2);
+              radial(r2, u[0], u[1], u[2]);
+              u[0] *= r1;
+              u[1] *= r2*r1;
+              u[2] *= r2*r2*r1; }, tabmin2, rc1*rc1, 1e-9 );
+        }
       }
       
       /**
@@ -344,19 +490,22 @@ namespace Faunus {
        * @param qB Charge of ion B
        * @param r Direction \f$ r_A - r_B \f$
        */
-      template<bool useWdata=false, class Tvec>
+      template<class Tvec>
         double q2q(double qA, double qB, const Tvec &r) const {
-          /* Code to use if calcWolfData is not called */
-          if (useWdata==false) {
-            double r2i = 1/r.squaredNorm();
-            if (r2i < rc2i)
-              return 0;
-            double r1i = sqrt(r2i);
-            double der = (1/r1i) - rc1;
-            double r1i_d = erfc_x(kappa/r1i)*r1i;
-            return (qA*qB*(r1i_d - rc1i_d - der*dT0c));
-          }
-          return (qA*qB*(data.r1i_d - rc1i_d - data.der_dT0c));
+          double r2 = r.squaredNorm();
+          if (1/r2 < rc2i)
+            return 0;
+          double r1 = sqrt(r2), r1i_d;
+          if (tabulated && r2>tabmin2)
+            r1i_d = tab.eval(r2, 0)/r1;
+          else
+            radial(r2, r1i_d);
+          return (qA*qB*(r1i_d - rc1i_d - (r1-rc1)*dT0c));
+        }
+
+      /** @brief Ion-ion interaction from pair intermediates */
+      double q2q(const wdata &d, double qA, double qB) const {
+        return (qA*qB*(d.r1i_d - rc1i_d - d.der_dT0c));
       }
 
       /**
@@ -367,24 +516,22 @@ namespace Faunus {
        * @param muB Unit dipole moment vector of particel B
        * @param r Direction \f$ r_A - r_B \f$
        */
-      template<bool useWdata=false, class Tvec>
+      template<class Tvec>
         double q2mu(double QBxMuA, const Tvec &muA, double QAxMuB, const Tvec &muB, const Tvec &r) const {
-          /* Code to use if calcWolfData is not called */
-          if (useWdata==false) {
-            double r2i = 1/r.squaredNorm();
-            if (r2i < rc2i)
-              return 0;
-            double r1i = sqrt(r2i);
-            double T1 = (constant*exp(-kappa2/r2i) + erfc_x(kappa/r1i)*r1i)*r2i;
-            double der = (1/r1i) - rc1;
-            double W1 = QBxMuA*muA.dot(r)*(T1 - T1c_rc1*r1i - der*dT1c_rc1*r1i);
-            double W2 = QAxMuB*muB.dot(-r)*(T1 - T1c_rc1*r1i - der*dT1c_rc1*r1i);
-            return (W1 + W2);
-          }
-          double W1 = QBxMuA*muA.dot(r)*(data.T1 - data.T1c_r1i - data.der_dT1c_r1i);
-          double W2 = QAxMuB*muB.dot(-r)*(data.T1 - data.T1c_r1i - data.der_dT1c_r1i);
+          wdata d;
+          if (!calcWolfData(r,d))
+            return 0;
+          return q2mu(d,QBxMuA,muA,QAxMuB,muB,r);
+        }
+
+      /** @brief Ion-dipole interaction from pair intermediates */
+      template<class Tvec>
+        double q2mu(const wdata &d, double QBxMuA, const Tvec &muA, double QAxMuB, const Tvec &muB, const Tvec &r) const {
+          double T = d.T1 - d.T1c_r1i - d.der_dT1c_r1i;
+          double W1 = QBxMuA*muA.dot(r)*T;
+          double W2 = QAxMuB*muB.dot(-r)*T;
           return (W1 + W2);
-      }
+        }
 
       /**
        * @brief Dipole-dipole energy
@@ -393,25 +540,19 @@ namespace Faunus {
        * @param muAxmuB Product of dipole moment scalars, |A|*|B|
        * @param r Direction \f$ r_A - r_B \f$
        */
-      template<bool useWdata=false, class Tvec>
+      template<class Tvec>
         double mu2mu(const Tvec &muA, const Tvec &muB, double muAxmuB, const Tvec &r) const {
-          /* Code to use if calcWolfData is not called */
-          if (useWdata==false) {
-            double r2i = 1.0/r.squaredNorm();
-            if (r2i < rc2i)
-              return 0;
-            double r1i = sqrt(r2i);
-            double r1i_d = erfc_x(kappa/r1i)*r1i;
-            double expK = constant*exp(-kappa2/r2i);
-            double T2_1 = -(r1i_d + expK)*r2i;
-            double T2_2 = (3.*r1i_d*r2i + (3.*r2i + 2.*kappa2)*expK)*r2i;
-            double der = (1/r1i) - rc1;
-            double t3 = muA.dot(muB)*(T2_1 - T2c1 - der*dT2c1);
-            double t5 = muA.dot(r)*muB.dot(r)*(T2_2 - T2c2_rc2*r2i - der*dT2c2_rc2*r2i);
-            return -(t5 + t3)*muAxmuB;
-          }
-          double t3 = muA.dot(muB)*(data.T21 - T2c1 - data.der_dT2c1);
-          double t5 = muA.dot(r)*muB.dot(r)*(data.T22 - data.T2c2_r2i - data.der_dT2c2_r2i);
+          wdata d;
+          if (!calcWolfData(r,d))
+            return 0;
+          return mu2mu(d,muA,muB,muAxmuB,r);
+        }
+
+      /** @brief Dipole-dipole energy from pair intermediates */
+      template<class Tvec>
+        double mu2mu(const wdata &d, const Tvec &muA, const Tvec &muB, double muAxmuB, const Tvec &r) const {
+          double t3 = muA.dot(muB)*(d.T21 - T2c1 - d.der_dT2c1);
+          double t5 = muA.dot(r)*muB.dot(r)*(d.T22 - d.T2c2_r2i - d.der_dT2c2_r2i);
           return -(t5 + t3)*muAxmuB;
         }
 
@@ -423,29 +564,24 @@ namespace Faunus {
        * @param quadA Quadrupole moment of particle A
        * @param r Direction @f$ r_A - r_B @f$
        */
-      template<bool useWdata=false, class Tvec, class Tmat>
+      template<class Tvec, class Tmat>
         double q2quad(double qA, const Tmat &quadB,double qB, const Tmat &quadA, const Tvec &r) const {
-          /* Code to use if calcWolfData is not called */
-          if (useWdata==false) {
-            double r2i = 1/r.squaredNorm();
-            if (r2i < rc2i)
-              return 0;
-            double r1i = sqrt(r2i);
-            double r1i_d = erfc_x(kappa/r1i)*r1i;
-            double expK = constant*exp(-kappa2/r2i);
-            double T2_1 = -(r1i_d + expK)*r2i;
-            double T2_2 = (3.*r1i_d*r2i + (3.*r2i + 2.*kappa2)*expK)*r2i;
-            double der = (1/r1i) - rc1;
-            double WAB = r.transpose()*quadB*r;
-            WAB = WAB*(T2_2 - T2c2_rc2*r2i - der*dT2c2_rc2*r2i) + quadB.trace()*(T2_1 - T2c1 - der*dT2c1);
-            double WBA = r.transpose()*quadA*r;
-            WBA = WBA*(T2_2 - T2c2_rc2*r2i - der*dT2c2_rc2*r2i) + quadA.trace()*(T2_1 - T2c1 - der*dT2c1);
-            return (qA*WAB + qB*WBA);
-          }
-          double WAB = r.transpose()*quadB*r;
-          WAB = WAB*(data.T22 - data.T2c2_r2i - data.der_dT2c2_r2i) + quadB.trace()*(data.T21 - T2c1 - data.der_dT2c1);
-          double WBA = r.transpose()*quadA*r;
-          WBA = WBA*(data.T22 - data.T2c2_r2i - data.der_dT2c2_r2i) + quadA.trace()*(data.T21 - T2c1 - data.der_dT2c1);
+          wdata d;
+          if (!calcWolfData(r,d))
+            return 0;
+          return q2quad(d,qA,quadB,qB,quadA,r);
+        }
+
+      /** @brief Ion-quadrupole energy from pair intermediates */
+      template<class Tvec, class Tmat>
+        double q2quad(const wdata &d, double qA, const Tmat &quadB,double qB, const Tmat &quadA, const Tvec &r) const {
+          double T2 = d.T22 - d.T2c2_r2i - d.der_dT2c2_r2i;
+          double T1 = d.T21 - T2c1 - d.der_dT2c1;
+          Eigen::Vector3d rd = r.template cast<double>(); // mixed precision
+          double WAB = rd.dot( quadB.template cast<double>()*rd );
+          WAB = WAB*T2 + quadB.trace()*T1;
+          double WBA = rd.dot( quadA.template cast<double>()*rd );
+          WBA = WBA*T2 + quadA.trace()*T1;
           return (qA*WAB + qB*WBA);
         }
         
@@ -454,19 +590,18 @@ namespace Faunus {
        * @param p Particles from which field arises
        * @param r Direction @f$ r_A - r_B @f$
        */
-      template<bool useWdata=false, class Tparticle>
+      template<class Tparticle>
         Point fieldCharge(const Tparticle &p, const Point &r) const {
-          /* Code to use if calcWolfData is not called */
-          if (useWdata==false) {
-            double r2i = 1/r.squaredNorm();
-            if (r2i < rc2i)
-              return Point(0,0,0);
-            double r1i = sqrt(r2i);
-            double T1 = (constant*exp(-kappa2/r2i) + erfc_x(kappa/r1i)*r1i)*r2i;
-            double der = (1/r1i) - rc1;
-            return (T1 - T1c_rc1*r1i - der*dT1c_rc1*r1i)*r*p.charge;
-          }
-          return (data.T1 - data.T1c_r1i - data.der_dT1c_r1i)*r*p.charge;
+          wdata d;
+          if (!calcWolfData(r,d))
+            return Point(0,0,0);
+          return fieldCharge(d,p,r);
+        }
+
+      /** @brief Field due to charge from pair intermediates */
+      template<class Tparticle>
+        Point fieldCharge(const wdata &d, const Tparticle &p, const Point &r) const {
+          return (d.T1 - d.T1c_r1i - d.der_dT1c_r1i)*r*p.charge;
         }
         
       /** 
@@ -474,32 +609,25 @@ namespace Faunus {
        * @param p Particles from which field arises
        * @param r Direction @f$ r_A - r_B @f$
        */
-      template<bool useWdata=false, class Tparticle>
+      template<class Tparticle>
         Point fieldDipole(const Tparticle &p, const Point &r) const {
-          /* Code to use if calcWolfData is not called */
-          if (useWdata==false) {
-            double r2i = 1.0/r.squaredNorm();
-            if (r2i < rc2i)
-              return Point(0,0,0);
-            double r1i = sqrt(r2i);
-            double r1i_d = erfc_x(kappa/r1i)*r1i;
-            double expK = constant*exp(-kappa2/r2i);
-            double T2_1 = -(r1i_d + expK)*r2i;
-            double T2_2 = (3.*r1i_d*r2i + (3.*r2i + 2.*kappa2)*expK)*r2i;
-            double der = (1/r1i) - rc1;
-            Point t3 = p.mu*(T2_1 - T2c1 - der*dT2c1);
-            Point t5 = r*p.mu.dot(r)*(T2_2 - T2c2_rc2*r2i - der*dT2c2_rc2*r2i);
-            return (t5 + t3)*p.muscalar;
-          }
-          Point t3 = p.mu*(data.T21 - T2c1 - data.der_dT2c1);
-          Point t5 = r*p.mu.dot(r)*(data.T22 - data.T2c2_r2i - data.der_dT2c2_r2i);
+          wdata d;
+          if (!calcWolfData(r,d))
+            return Point(0,0,0);
+          return fieldDipole(d,p,r);
+        }
+
+      /** @brief Field due to dipole from pair intermediates */
+      template<class Tparticle>
+        Point fieldDipole(const wdata &d, const Tparticle &p, const Point &r) const {
+          Point t3 = p.mu*(d.T21 - T2c1 - d.der_dT2c1);
+          Point t5 = r*p.mu.dot(r)*(d.T22 - d.T2c2_r2i - d.der_dT2c2_r2i);
           return (t5 + t3)*p.muscalar;
         }
         
       double getRc2i() const { return rc2i; }
-      double getR2i() const { return data.r2i; }
-      double getKappa() { return kappa; }
-      double getCutoff() { return rc1; }
+      double getKappa() const { return kappa; }
+      double getCutoff() const { return rc1; }
   };
   
   
@@ -508,14 +636,83 @@ namespace Faunus {
    *
    * The idea is that this class has no dependencies and is
    * to be used as a helper class for other classes.
+   *
+   * The damping parameters of each ordered pair of atom types are stored
+   * together in one `Tpair` record. The damping functions depend only on
+   * the reduced separation @f$ x=\beta r @f$ and are interpolated from
+   * a `HermiteTable` in @f$ x^2 @f$ shared by all pairs. The tables hold
+   * @f$ B_n(x)(1+x^2)^{n+1/2} @f$ which is of order unity for all @f$ x @f$,
+   * to an absolute tolerance of @f$10^{-9}@f$. Below @f$ x=0.05 @f$ the
+   * functions are evaluated directly and above @f$ x=6 @f$, where
+   * @f$ \mbox{erf}(x)=1 @f$ to double precision, asymptotically.
+   * All kernels are `const` and reentrant.
    */
   class GaussianDampingBase {
     private:
+      /** @brief Damping parameters of one atom type */
+      struct Tsingle {
+        double C, C3, D, D2, D3;
+      };
+
+      /** @brief Damping parameters of an ordered pair of atom types */
+      struct Tpair {
+        double CC, CC2, CC3, CD, CD2, CD3, CQ, CQ2, CQ3, DD, DD2, DD3;
+      };
+
+      static constexpr double xmin=0.05, xmax=6;
+      int N;
       double constant;
-      Eigen::VectorXd betaC, betaD, betaQ, betaC3, betaD2, betaD3;
-      Eigen::MatrixXd betaCC, betaCD, betaCQ, betaDD;
-      Eigen::MatrixXd betaCC2, betaCD2, betaCQ2, betaDD2;
-      Eigen::MatrixXd betaCC3, betaCD3, betaCQ3, betaDD3;
+      std::vector<Tsingle> single;
+      std::vector<Tpair> pair;
+      HermiteTable<3> tab;  // erf(x)/x, B1(x) and B2(x) times (1+x^2)^(n+1/2) as functions of x^2
+
+      const Tpair& pp(int ida, int idb) const { return pair[(ida-1)*N + idb-1]; }
+
+      /** @brief erf(x)/x, B1(x) and B2(x) evaluated directly */
+      void radial(double x2, double &E0, double &B1, double &B2) const {
+        double x = sqrt(x2);
+        E0 = std::erf(x)/x;
+        double expX = constant * exp(-x2);
+        B1 = ( E0 - expX ) / x2;
+        B2 = ( 3*E0 - (3 + 2*x2) * expX ) / ( x2 * x2 );
+      }
+
+      /** @brief erf(x)/x as a function of x^2 */
+      double E0(double x2) const {
+        if (x2>=xmax*xmax)
+          return 1/sqrt(x2);
+        if (x2>xmin*xmin)
+          return tab.eval(x2, 0)/sqrt(1+x2);
+        double u0,u1,u2;
+        radial(x2,u0,u1,u2);
+        return u0;
+      }
+
+      /** @brief @f$ (\mbox{erf}(x)/x - 2e^{-x^2}/\sqrt{\pi})/x^2 @f$ as a function of x^2 */
+      double B1(double x2) const {
+        if (x2>=xmax*xmax)
+          return 1/(x2*sqrt(x2));
+        if (x2>xmin*xmin) {
+          double s2 = 1+x2;
+          return tab.eval(x2, 1)/(s2*sqrt(s2));
+        }
+        double u0,u1,u2;
+        radial(x2,u0,u1,u2);
+        return u1;
+      }
+
+      /** @brief @f$ (3\mbox{erf}(x)/x - (3+2x^2)2e^{-x^2}/\sqrt{\pi})/x^4 @f$ as a function of x^2 */
+      double B2(double x2) const {
+        if (x2>=xmax*xmax)
+          return 3/(x2*x2*sqrt(x2));
+        if (x2>xmin*xmin) {
+          double s2 = 1+x2;
+          return tab.eval(x2, 2)/(s2*s2*sqrt(s2));
+        }
+        double u0,u1,u2;
+        radial(x2,u0,u1,u2);
+        return u2;
+      }
 
     public:
       /**
@@ -523,7 +720,7 @@ namespace Faunus {
        */
       GaussianDampingBase() {
         constant = 2/sqrt(pc::pi);
-        int N = atom.size() - 1;
+        N = atom.size() - 1;
         
         double alpha;
         double pre_factor = pow(3*sqrt(8*pc::pi)/4,1.0/3.0);
@@ -536,65 +733,44 @@ namespace Faunus {
             atom[i+1].betaD = 0.75*pre_factor*pow(alpha,-1.0/3.0);
           }
           if(atom[i+1].betaQ == pc::infty) {
-            atom[i+1].betaC = 0.75*pre_factor*pow(alpha,-1.0/3.0);
+            atom[i+1].betaQ = 0.75*pre_factor*pow(alpha,-1.0/3.0);
           }
         }
-        
-        betaC.resize(N);
-        betaD.resize(N);
-        betaQ.resize(N);
-        betaC3.resize(N);
-        betaD2.resize(N);
-        betaD3.resize(N);
-        betaCC.resize(N,N);
-        betaCD.resize(N,N);
-        betaCQ.resize(N,N);
-        betaDD.resize(N,N);
-        betaCC2.resize(N,N);
-        betaCD2.resize(N,N);
-        betaCQ2.resize(N,N);
-        betaDD2.resize(N,N);
-        betaCC3.resize(N,N);
-        betaCD3.resize(N,N);
-        betaCQ3.resize(N,N);
-        betaDD3.resize(N,N);
-        
+
+        auto mix = [](double a, double b) { return a*b/sqrt(a*a + b*b); };
+        single.resize(N);
+        pair.resize(N*N);
         for(int i = 0; i < N; i++) {
-          betaC(i) = atom[i+1].betaC;
-          betaC3(i) = betaC(i)*betaC(i)*betaC(i);
-          betaD(i) = atom[i+1].betaD;
-          betaD2(i) = betaD(i)*betaD(i);
-          betaD3(i) = betaD2(i)*betaD(i);
-          betaQ(i) = atom[i+1].betaQ;
+          Tsingle &s = single[i];
+          s.C = atom[i+1].betaC;
+          s.C3 = s.C*s.C*s.C;
+          s.D = atom[i+1].betaD;
+          s.D2 = s.D*s.D;
+          s.D3 = s.D2*s.D;
         }
-        for(int i = 0; i < N; i++) {
-          for(int j = i; j < N; j++) {
-            betaCC(i,j) = betaC(i)*betaC(j)/sqrt(betaC(i)*betaC(i) + betaC(j)*betaC(j));
-            betaCD(i,j) = betaC(i)*betaD(j)/sqrt(betaC(i)*betaC(i) + betaD(j)*betaD(j));
-            betaCQ(i,j) = betaC(i)*betaQ(j)/sqrt(betaC(i)*betaC(i) + betaQ(j)*betaQ(j));
-            betaDD(i,j) = betaD(i)*betaD(j)/sqrt(betaD(i)*betaD(i) + betaD(j)*betaD(j));
-            betaCC(j,i) = betaCC(i,j);
-            betaCD(j,i) = betaD(i)*betaC(j)/sqrt(betaD(i)*betaD(i) + betaC(j)*betaC(j));
-            betaCQ(j,i) = betaQ(i)*betaC(j)/sqrt(betaQ(i)*betaQ(i) + betaC(j)*betaC(j));
-            betaDD(j,i) = betaDD(i,j);
-            betaCC2(i,j) = betaCC(i,j)*betaCC(i,j);
-            betaCD2(i,j) = betaCD(i,j)*betaCD(i,j);
-            betaCQ2(i,j) = betaCQ(i,j)*betaCQ(i,j);
-            betaDD2(i,j) = betaDD(i,j)*betaDD(i,j);
-            betaCC2(j,i) = betaCC2(i,j);
-            betaCD2(j,i) = betaCD(j,i)*betaCD(j,i);
-            betaCQ2(j,i) = betaCQ(j,i)*betaCQ(j,i);
-            betaDD2(j,i) = betaDD2(i,j);
-            betaCC3(i,j) = betaCC2(i,j)*betaCC(i,j);
-            betaCD3(i,j) = betaCD2(i,j)*betaCD(i,j);
-            betaCQ3(i,j) = betaCQ2(i,j)*betaCQ(i,j);
-            betaDD3(i,j) = betaDD2(i,j)*betaDD(i,j);
-            betaCC3(j,i) = betaCC3(i,j);
-            betaCD3(j,i) = betaCD2(j,i)*betaCD(j,i);
-            betaCQ3(j,i) = betaCQ2(j,i)*betaCQ(j,i);
-            betaDD3(j,i) = betaDD3(i,j);
+        for(int i = 0; i < N; i++)
+          for(int j = 0; j < N; j++) {
+            Tpair &p = pair[i*N + j];
+            p.CC = mix(atom[i+1].betaC, atom[j+1].betaC);
+            p.CD = mix(atom[i+1].betaC, atom[j+1].betaD);
+            p.CQ = mix(atom[i+1].betaC, atom[j+1].betaQ);
+            p.DD = mix(atom[i+1].betaD, atom[j+1].betaD);
+            p.CC2 = p.CC*p.CC;
+            p.CD2 = p.CD*p.CD;
+            p.CQ2 = p.CQ*p.CQ;
+            p.DD2 = p.DD*p.DD;
+            p.CC3 = p.CC2*p.CC;
+            p.CD3 = p.CD2*p.CD;
+            p.CQ3 = p.CQ2*p.CQ;
+            p.DD3 = p.DD2*p.DD;
           }
-        }
+
+        tab.generate( [&](double x2, double *u) {
+            double s = sqrt(1+x2);
+            radial(x2, u[0], u[1], u[2]);
+            u[0] *= s;
+            u[1] *= s*s*s;
+            u[2] *= s*s*s*s*s; }, xmin*xmin, xmax*xmax, 1e-9 );
       }
       
       /**
@@ -607,8 +783,8 @@ namespace Faunus {
        */
       template<class Tvec>
         double q2q(double qA, double qB, int ida, int idb, const Tvec &r) const {
-          double r1 = r.norm();
-          return (qA*qB*erf_x(betaCC(ida-1,idb-1)*r1)/r1);
+          double b = pp(ida,idb).CC;
+          return (qA*qB*b*E0(b*b*r.squaredNorm()));
       }
 
       /**
@@ -624,9 +800,9 @@ namespace Faunus {
       template<class Tvec>
         double q2mu(double QBxMuA, const Tvec &muA, double QAxMuB, const Tvec &muB, int ida, int idb, const Tvec &r) const {
           double r2 = r.squaredNorm();
-          double r1 = sqrt(r2);
-          double B1_BA = ( (erf_x( betaCD(ida-1,idb-1) * r1 )/r1) - betaCD(ida-1,idb-1) * constant * exp(-betaCD2(ida-1,idb-1)*r2) ) / r2;
-          double B1_AB = ( (erf_x( betaCD(idb-1,ida-1) * r1 )/r1) - betaCD(idb-1,ida-1) * constant * exp(-betaCD2(idb-1,ida-1)*r2) ) / r2;
+          const Tpair &ab = pp(ida,idb), &ba = pp(idb,ida);
+          double B1_BA = ab.CD3 * B1(ab.CD2*r2);
+          double B1_AB = ba.CD3 * B1(ba.CD2*r2);
           double W_BA = ( QBxMuA * muA.dot(r) * B1_BA);
           double W_AB = ( QAxMuB * muB.dot(-r) * B1_AB);
           return ( W_BA + W_AB );
@@ -643,13 +819,9 @@ namespace Faunus {
        */
       template<class Tvec>
         double mu2mu(const Tvec &muA, const Tvec &muB, double muAxmuB, int ida, int idb, const Tvec &r) const {
-          double x = betaDD(ida-1,idb-1)*r.norm();
-          double x2 = x*x;
-          double erfX = erf_x(x)/x;
-          double expX = constant * exp(-x2);
-          double B1 = ( erfX - expX ) / x2;
-          double B2 = ( 3*erfX - (3 + 2*x2) * expX ) / ( x2 * x2 );
-          double W = ( muA.dot(muB) * B1 - betaDD2(ida-1,idb-1) * ( muA.dot(r) ) * ( muB.dot(r) ) * B2 ) * betaDD3(ida-1,idb-1);
+          const Tpair &ab = pp(ida,idb);
+          double x2 = ab.DD2*r.squaredNorm();
+          double W = ( muA.dot(muB) * B1(x2) - ab.DD2 * ( muA.dot(r) ) * ( muB.dot(r) ) * B2(x2) ) * ab.DD3;
           return ( muAxmuB * W );
         }
 
@@ -665,24 +837,16 @@ namespace Faunus {
        */
       template<class Tvec, class Tmat>
         double q2quad(double qA, const Tmat &quadB,double qB, const Tmat &quadA, int ida, int idb, const Tvec &r) const {
-          double r1 = r.norm();
-          double x_AB = betaCQ(ida-1,idb-1)*r1;
-          double x2_AB = x_AB*x_AB;
-          double erfX_AB = erf_x(x_AB)/x_AB;
-          double expX_AB = constant * exp(-x2_AB);
-          double B1_AB = ( erfX_AB - expX_AB ) / x2_AB;
-          double B2_AB = betaCQ2(ida-1,idb-1) * ( 3*erfX_AB - (3 + 2*x2_AB) * expX_AB ) / ( x2_AB * x2_AB );
-          double W_AB = r.transpose()*quadB*r;
-          W_AB = W_AB * B2_AB - quadB.trace() * B1_AB;
-          double x_BA = betaCQ(idb-1,ida-1)*r1;
-          double x2_BA = x_BA*x_BA;
-          double erfX_BA = erf_x(x_BA)/x_BA;
-          double expX_BA = constant * exp(-x2_BA);
-          double B1_BA = ( erfX_BA - expX_BA ) / x2_BA;
-          double B2_BA = betaCQ2(idb-1,ida-1) * ( 3*erfX_BA - (3 + 2*x2_BA) * expX_BA ) / ( x2_BA * x2_BA );
-          double W_BA = r.transpose()*quadA*r;
-          W_BA = W_BA * B2_BA - quadA.trace() * B1_BA;
-          return ( qA * W_AB * betaCQ3(ida-1,idb-1) + qB * W_BA * betaCQ3(idb-1,ida-1) );
+          double r2 = r.squaredNorm();
+          const Tpair &ab = pp(ida,idb), &ba = pp(idb,ida);
+          double x2_AB = ab.CQ2*r2;
+          Eigen::Vector3d rd = r.template cast<double>(); // mixed precision
+          double W_AB = rd.dot( quadB.template cast<double>()*rd );
+          W_AB = W_AB * ab.CQ2 * B2(x2_AB) - quadB.trace() * B1(x2_AB);
+          double x2_BA = ba.CQ2*r2;
+          double W_BA = rd.dot( quadA.template cast<double>()*rd );
+          W_BA = W_BA * ba.CQ2 * B2(x2_BA) - quadA.trace() * B1(x2_BA);
+          return ( qA * W_AB * ab.CQ3 + qB * W_BA * ba.CQ3 );
         }
 
       /** 
@@ -693,17 +857,17 @@ namespace Faunus {
        */
       template<class Tparticle>
         Point fieldCharge(const Tparticle &p, const Point &r, int ida=-1) const {
-          Point E(0,0,0);
+          double b2, b3;
           if(ida != -1) {
-            double x = betaCC(ida-1,p.id-1)*r.norm();
-            double x2 = x*x;
-            E = (p.charge * betaCC3(ida-1,p.id-1) * ( ( erf_x(x) / x ) - constant * exp(-x2) ) / x2)*r;
+            const Tpair &ab = pp(ida,p.id);
+            b2 = ab.CC2;
+            b3 = ab.CC3;
           } else {
-            double x = betaC(p.id-1)*r.norm();
-            double x2 = x*x;
-            E = (p.charge * betaC3(p.id-1)* ( ( erf_x(x) / x ) - constant * exp(-x2) ) / x2) *r;
+            const Tsingle &s = single[p.id-1];
+            b2 = s.C*s.C;
+            b3 = s.C3;
           }
-          return E;
+          return (p.charge * b3 * B1(b2*r.squaredNorm())) * r;
         }
         
       /** 
@@ -714,25 +878,18 @@ namespace Faunus {
        */
       template<class Tparticle>
         Point fieldDipole(const Tparticle &p, const Point &r, int ida=-1) const {
-          Point E(0,0,0);
+          double b2, b3;
           if(ida != -1) {
-            double x = betaDD(ida-1,p.id-1)*r.norm();
-            double x2 = x*x;
-            double erfX = erf_x(x)/x;
-            double expX = constant * exp(-x2);
-            double B1 = ( erfX - expX ) / x2;
-            double B2 = ( 3*erfX - (3 + 2*x2) * expX ) / ( x2 * x2 );
-            E = -p.muscalar*( B1 * p.mu - betaDD2(ida-1,p.id-1) * p.mu.dot(r) * B2 *r ) * betaDD3(ida-1,p.id-1);
+            const Tpair &ab = pp(ida,p.id);
+            b2 = ab.DD2;
+            b3 = ab.DD3;
           } else {
-            double x = betaD(p.id-1)*r.norm();
-            double x2 = x*x;
-            double erfX = erf_x(x)/x;
-            double expX = constant * exp(-x2);
-            double B1 = ( erfX - expX ) / x2;
-            double B2 = ( 3*erfX - (3 + 2*x2) * expX ) / ( x2 * x2 );
-            E = -p.muscalar*( B1 * p.mu - betaD2(p.id-1) * p.mu.dot(r) * B2 *r ) * betaD3(p.id-1);
+            const Tsingle &s = single[p.id-1];
+            b2 = s.D2;
+            b3 = s.D3;
           }
-          return E;
+          double x2 = b2*r.squaredNorm();
+          return -p.muscalar*( B1(x2) * p.mu - b2 * p.mu.dot(r) * B2(x2) * r ) * b3;
         }
   };
   
@@ -963,16 +1120,16 @@ namespace Faunus {
                 _lB = pc::lB(epsilon_r);
               }
               template<class Tparticle>
-                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) {
+                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) const {
                   double U_total = 0;
                   if((useIonIon? 1:0) + (useIonDipole? 1:0) + (useDipoleDipole? 1:0) + (useIonQuadrupole? 1:0) > 1) {
-                    wolf.calcWolfData(r);
-                    if (wolf.getR2i() < wolf.getRc2i())
+                    WolfBase::wdata d;
+                    if (!wolf.calcWolfData(r,d,false))
                       return 0;
-                    if(useIonIon == true) U_total += wolf.q2q<true>(a.charge,b.charge,r);
-                    if(useIonDipole == true) U_total += wolf.q2mu<true>(a.charge*b.muscalar,b.mu,b.charge*a.muscalar,a.mu,r);
-                    if(useDipoleDipole == true) U_total += wolf.mu2mu<true>(a.mu,b.mu, a.muscalar*b.muscalar, r);
-                    if(useIonQuadrupole == true) U_total += wolf.q2quad<true>(a.charge, b.theta,b.charge, a.theta,r);
+                    if(useIonIon == true) U_total += wolf.q2q(d,a.charge,b.charge);
+                    if(useIonDipole == true) U_total += wolf.q2mu(d,a.charge*b.muscalar,b.mu,b.charge*a.muscalar,a.mu,r);
+                    if(useDipoleDipole == true) U_total += wolf.mu2mu(d,a.mu,b.mu, a.muscalar*b.muscalar, r);
+                    if(useIonQuadrupole == true) U_total += wolf.q2quad(d,a.charge, b.theta,b.charge, a.theta,r);
                     return _lB*U_total;
                   }
                   if(useIonIon == true) U_total += wolf.q2q(a.charge,b.charge,r);
@@ -983,13 +1140,13 @@ namespace Faunus {
                 }
 
               template<bool useIon=true, bool useDipole=true, class Tparticle>
-                Point field(const Tparticle &p, const Point &r) {
+                Point field(const Tparticle &p, const Point &r) const {
                   if(useIon && useDipole) {
-                    wolf.calcWolfData(r);
-                    if (wolf.getR2i() < wolf.getRc2i())
+                    WolfBase::wdata d;
+                    if (!wolf.calcWolfData(r,d,false))
                       return Point(0,0,0);
-                    Point E = wolf.fieldCharge<true>(p,r);
-                    E += wolf.fieldDipole<true>(p,r);
+                    Point E = wolf.fieldCharge(d,p,r);
+                    E += wolf.fieldDipole(d,p,r);
                     return _lB*E;
                   }
                   if(useIon == true) return _lB*wolf.fieldCharge(p,r);
@@ -1142,7 +1299,7 @@ namespace Faunus {
               gdb() { name+=" Gaussian Damping"; }
 
               template<class Tparticle>
-                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) {
+                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) const {
                   return lB*gdb.q2q(a.charge,b.charge,a.id,b.id,r);
                 }
                 
@@ -1161,7 +1318,7 @@ namespace Faunus {
               gdb() { name+=" Gaussian Damping"; }
 
               template<class Tparticle>
-                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) {
+                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) const {
                   return _lB*gdb.q2mu(a.charge*b.muscalar,b.mu,b.charge*a.muscalar,a.mu,a.id,b.id,r);
                 }
           };
@@ -1175,7 +1332,7 @@ namespace Faunus {
               gdb() { name+=" Gaussian Damping"; }
 
               template<class Tparticle>
-                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) {
+                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) const {
                   return _lB*gdb.mu2mu(a.mu,b.mu, a.muscalar*b.muscalar,a.id,b.id,r);
                 }
                 
@@ -1194,7 +1351,7 @@ namespace Faunus {
               gdb() { name+=" Gaussian Damping"; }
 
               template<class Tparticle>
-                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) {
+                double operator()(const Tparticle &a, const Tparticle &b, const Point &r) const {
                   return _lB*gdb.q2quad(a.charge, b.theta,b.charge, a.theta,a.id,b.id,r);
                 }
           };
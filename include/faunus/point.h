@@ -36,21 +36,28 @@ namespace Faunus {
    *
    * @date 2002-2007
    */
+#ifdef FAU_MIXEDPRECISION
+  struct PointBase : public Eigen::Vector3f {
+    typedef float Tcoord;         //!< Floating point type for Point coordinates
+    typedef Eigen::Vector3f Tvec; //!< 3D vector from Eigen
+#else
   struct PointBase : public Eigen::Vector3d {
     typedef double Tcoord;        //!< Floating point type for Point coordinates
     typedef Eigen::Vector3d Tvec; //!< 3D vector from Eigen
+#endif
 
     /** @brief Default constructor. Data is *not* zeroed */
     inline PointBase() {}
 
     PointBase(Tcoord x, Tcoord y, Tcoord z) : Tvec(x,y,z) {}
 
+    /** @brief Construct from Eigen expression; the scalar type is converted if needed */
     template<typename OtherDerived>
-      PointBase(const Eigen::MatrixBase<OtherDerived>& other) : Tvec(other) {}
+      PointBase(const Eigen::MatrixBase<OtherDerived>& other) : Tvec(other.template cast<Tcoord>()) {}
 
     template<typename OtherDerived>
       PointBase& operator=(const Eigen::MatrixBase<OtherDerived> &other) {
-        Tvec::operator=(other);
+        Tvec::operator=(other.template cast<Tcoord>());
         return *this;
       }
 
@@ -81,7 +88,7 @@ namespace Faunus {
           r2=u.squaredNorm();
         } while (r2>1);
         *this = u/std::sqrt(r2);
-        assert(std::abs(norm()-1)<1e-7); // is it really a unit vector?
+        assert(std::abs(norm()-1)<1e-6); // is it really a unit vector?
       }
 
     /**
@@ -147,11 +154,11 @@ namespace Faunus {
       }
 
       template<typename OtherDerived>
-        Tensor(const Eigen::MatrixBase<OtherDerived>& other) : Tmat(other) {}
+        Tensor(const Eigen::MatrixBase<OtherDerived>& other) : Tmat(other.template cast<T>()) {}
 
       template<typename OtherDerived>
         Tensor& operator=(const Eigen::MatrixBase<OtherDerived> &other) {
-          Tmat::operator=(other);
+          Tmat::operator=(other.template cast<T>());
           return *this;
         }
 
@@ -192,14 +199,22 @@ namespace Faunus {
 
   /**
    * @brief Hypersphere particle
+   *
+   * The fourth coordinate follows directly after the three of `PointBase`
+   * so that (z1,z2,z3,z4) form one contiguous vector, accessible without
+   * copying through `vec4()`. Dot products used for angles on the
+   * hypersphere are thereby evaluated as a single 4D vector operation.
+   *
    * @date Lund, 2009-2013
    * @warning Unfinished - need to transfer from jurassic branch
    */
   class HyperPoint : public PointBase {
     private:
-      double w;
+      Tcoord w;
 
     public:
+      typedef Eigen::Matrix<Tcoord,4,1> Tvec4; //!< 4D vector
+
       inline HyperPoint() {}
 
       inline HyperPoint(double z1, double z2, double z3, double w) : PointBase(z1,z2,z3) {
@@ -219,14 +234,14 @@ namespace Faunus {
           return *this;
         }
 
-      inline const double& z1() const { return x(); }
-      inline const double& z2() const { return y(); }
-      inline const double& z3() const { return z(); }
-      inline const double& z4() const { return w; }
-      inline double& z1() { return x(); }
-      inline double& z2() { return y(); }
-      inline double& z3() { return z(); }
-      inline double& z4() { return w; }
+      inline const Tcoord& z1() const { return x(); }
+      inline const Tcoord& z2() const { return y(); }
+      inline const Tcoord& z3() const { return z(); }
+      inline const Tcoord& z4() const { return w; }
+      inline Tcoord& z1() { return x(); }
+      inline Tcoord& z2() { return y(); }
+      inline Tcoord& z3() { return z(); }
+      inline Tcoord& z4() { return w; }
 
       /** @brief Read from stream */
       HyperPoint& operator<<(std::istream &in) {
@@ -235,6 +250,12 @@ namespace Faunus {
         return *this;
       }
 
+      /** @brief Read z1, z2 and z3 from string, e.g. for 3D vectors like dipole moments */
+      HyperPoint& operator<<(const std::string &in) {
+        PointBase::operator<<(in);
+        return *this;
+      }
+
       /** @brief Write to stream */
       friend std::ostream &operator<<(std::ostream &o, const HyperPoint &p) {
         o << PointBase(p) << " " << p.z4();
@@ -264,8 +285,20 @@ namespace Faunus {
           geo.scale(*this, newvol);
         }
 
+      /** @brief Contiguous 4D view of the coordinates */
+      inline Eigen::Map<const Tvec4> vec4() const { return Eigen::Map<const Tvec4>(data()); }
+
+      /** @brief Contiguous 4D view of the coordinates */
+      inline Eigen::Map<Tvec4> vec4() { return Eigen::Map<Tvec4>(data()); }
+
+      /** @brief Cosine of angle to another hyperpoint, i.e. the 4D dot product */
+      inline double cosangle(const HyperPoint &a) const {
+        return vec4().dot(a.vec4());
+      }
+
+      /** @brief 4D dot product (same as `cosangle()`) */
       inline double sqdist(const HyperPoint &a) const {
-        return dot(a) + z4()*a.z4();
+        return cosangle(a);
       }
 
       /**
@@ -273,7 +306,7 @@ namespace Faunus {
        * @return @f[ r_g = \arccos{ (r^2) } @f]
        */
       inline double geodesic(const HyperPoint &a) const {
-        return std::acos( sqdist(a) );
+        return std::acos( std::max(-1., std::min(1., cosangle(a))) );
       }
 
       void move(double du, double dv, double dw) {
@@ -338,6 +371,9 @@ namespace Faunus {
       }
   };
 
+  static_assert( sizeof(HyperPoint)==4*sizeof(HyperPoint::Tcoord),
+      "HyperPoint coordinates must be contiguous" );
+
 #ifdef FAU_HYPERSPHERE
   typedef HyperPoint Point;
 #else
@@ -447,8 +483,8 @@ namespace Faunus {
     Point mu;               //!< Dipole moment unit vector (permanent+induced)
     double muscalar;        //!< Dipole moment scalar (permanent+induced)
     Point mup;              //!< Permanent dipole moment vector
-    Tensor<double> alpha;   //!< Polarization matrix
-    Tensor<double> theta;   //!< Quadrupole matrix
+    Tensor<Tcoord> alpha;   //!< Polarization matrix
+    Tensor<Tcoord> theta;   //!< Quadrupole matrix
 
     inline DipoleParticle() : mu(0,0,0), muscalar(0),mup(0,0,0) {};
 
@@ -857,6 +857,49 @@ namespace Faunus {
         string info(char);
     };
 
+    /**
+     * @brief Real-space part of the Ewald summation
+     * @details The screened Coulomb potential has the form
+     * @f[
+     * \beta u_{ij} = \lambda_B z_i z_j \frac{\mbox{erfc}(\alpha r)}{r}
+     * @f]
+     * for \f$r<R_c\f$ and zero otherwise. The damping parameter and cut-off
+     * are normally tuned and set by `Energy::Ewald`, but are initially read
+     * from the InputMap keys `ewald_alpha` and `ewald_cutoff`.
+     */
+    class CoulombEwald : public Coulomb {
+      private:
+        double alpha, Rc2, c;
+      public:
+        CoulombEwald(InputMap&); //!< Construction from InputMap
+
+        /** @brief Set damping parameter (1/angstrom) and cut-off (angstrom) */
+        void setParameters(double, double);
+
+        template<class Tparticle>
+          double operator() (const Tparticle &a, const Tparticle &b, double r2) {
+            if (r2>Rc2)
+              return 0;
+            double r=sqrt(r2);
+            return lB * a.charge * b.charge * std::erfc(alpha*r) / r;
+          }
+
+        template<class Tparticle>
+          double operator() (const Tparticle &a, const Tparticle &b, const Point &r) {
+            return operator()(a,b,r.squaredNorm());
+          }
+
+        template<typename Tparticle>
+          Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) {
+            if (r2>Rc2) return Point(0,0,0);
+            double r=sqrt(r2);
+            return lB*a.charge*b.charge
+              * ( std::erfc(alpha*r)/r + c*std::exp(-alpha*alpha*r2) ) / r2 * p;
+          }
+
+        string info(char);
+    };
+
     /**
      * @brief Charge-nonpolar pair interaction
      * @details This accounts for polarization of
@@ -1266,10 +1309,13 @@ namespace Faunus {
           string _brief() {
             return first.brief() + " " + second.brief();
           }
+          // the larger of the two cut-offs; zero (no cut-off) if either has none
           void setCutoff() {
             for (size_t i=0; i<atom.list.size(); i++)
               for (size_t j=0; j<atom.list.size(); j++) {
-                if (first.rcut2(i,j) > second.rcut2(i,j))
+                if (first.rcut2(i,j)<=0 || second.rcut2(i,j)<=0)
+                  PairPotentialBase::rcut2.set(i,j,0);
+                else if (first.rcut2(i,j) > second.rcut2(i,j))
                   PairPotentialBase::rcut2.set(i,j,first.rcut2(i,j));
                 else
                   PairPotentialBase::rcut2.set(i,j,second.rcut2(i,j));
@@ -168,6 +168,13 @@ namespace Faunus {
             rc=in.get<double>("sofq_cutoff",1e9);
           }
 
+          /** @brief Merge with I(q) sampled elsewhere, i.e. in another thread */
+          DebyeFormula& operator+=(const DebyeFormula &other) {
+            for (auto &i : other.I)
+              I[i.first] = I[i.first] + i.second;
+            return *this;
+          }
+
           /**
            * @brief Sample I(q) and add to average
            *
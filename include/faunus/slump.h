@@ -4,6 +4,7 @@
 #include <string>
 #include <random>
 #include <cassert>
+#include <cmath>
 
 namespace Faunus {
 
@@ -28,6 +29,12 @@ namespace Faunus {
         return _randone() * max;
       }
 
+      /** @brief Normal distributed random number with zero mean and unit variance (Box-Muller) */
+      inline double randNormal() {
+        double u=1-_randone(); // (0,1]
+        return std::sqrt(-2*std::log(u)) * std::cos(6.283185307179586*_randone());
+      }
+
       /** @brief Random number in range [0,1) */
       inline double operator()() {
         double x=_randone();
@@ -35,7 +35,7 @@ namespace Faunus {
       int cigar_initialize(Tgeometry &geo, CigarParticle &target)
       {
           Point vec;
-          Geometry::QuaternionRotate rot;
+          Geometry::QuaternionRotateBase<Tgeometry> rot;
           
           if ( target.halfl < 1e-6 ) return 0;
           target.pcangl = cos(0.5*target.patchangle);
@@ -662,6 +662,12 @@ namespace Faunus {
 
     /*!
      * \brief Hard pair potential for spherocylinders
+     *
+     * Half lengths are stored per particle type in a dense vector
+     * indexed by the particle id. Pairs whose bounding spheres,
+     * @f$ r_{cm} > l_1/2 + l_2/2 + \sigma_1/2 + \sigma_2/2 @f$,
+     * cannot overlap are rejected before the segment-segment distance
+     * is evaluated.
      */
       class HardSpheroCylinder : public PairPotentialBase {
       private:
@@ -672,16 +678,22 @@ namespace Faunus {
               double halfl;
           };
           
-          std::map<CigarParticle::Tid, prop> m;
+          std::vector<prop> m; //!< Properties indexed by particle type id
           
           HardSpheroCylinder(InputMap &in) {
               name="HardspheroCylinder";
+              m.resize(atom.list.size());
+              for (size_t i=0; i<atom.list.size(); i++)
+                m[i].halfl=atom.list[i].half_len;
           }
           
           inline double operator() (const CigarParticle &p1, const CigarParticle &p2, double r2) {
               Point r_cm = geoPtr->vdist(p1,p2);
-              Point distvec = Geometry::mindist_segment2segment(p1.dir, m[p1.id].halfl, p2.dir, m[p2.id].halfl, r_cm );
               double mindist=p1.radius+p2.radius;
+              double rmax=m[p1.id].halfl+m[p2.id].halfl+mindist;
+              if ( r_cm.squaredNorm() > rmax*rmax )
+                  return 0;
+              Point distvec = Geometry::mindist_segment2segment(p1.dir, m[p1.id].halfl, p2.dir, m[p2.id].halfl, r_cm );
               if ( distvec.dot(distvec) < mindist*mindist)
                   return pc::infty;
               return 0;
@@ -706,10 +718,14 @@ namespace Faunus {
           string _brief() {
             return pairpot.brief();
           }
+        protected:
+          std::vector<short> patchtype; // patch type indexed by particle id
         public:
           Tcigarsphere pairpot;
         
           PatchyCigarSphere(InputMap &in) : pairpot(in) {
+            for (auto &i : atom.list)
+              patchtype.push_back(i.patchtype);
           }
 
           double operator() (const CigarParticle &a, const CigarParticle &b, const Point &r_cm) {
@@ -727,8 +743,8 @@ namespace Faunus {
             }
             Point distvec = -r_cm + (a.dir*contt);
 
-            if (atom.list[a.id].patchtype ==0 ) 
-              if (atom.list[b.id].patchtype == 0) 
+            if (patchtype[a.id] ==0 ) 
+              if (patchtype[b.id] == 0) 
                 return pairpot(a,b,distvec.dot(distvec));
 
             //patchy interaction
@@ -778,16 +794,20 @@ namespace Faunus {
           string _brief() {
             return pairpot.brief();
           }
+        protected:
+          std::vector<short> patchtype; // patch type indexed by particle id
         public:
           Tcigarcigar pairpot;
         
           PatchyCigarCigar(InputMap &in) : pairpot(in) {
+            for (auto &i : atom.list)
+              patchtype.push_back(i.patchtype);
           }
 
           double operator() (const CigarParticle &a, const CigarParticle &b, const Point &r_cm) {
               //0- isotropic, 1-PSC all-way patch,2 -CPSC cylindrical patch
-            if (atom.list[a.id].patchtype >0 ) {
-              if (atom.list[b.id].patchtype > 0) {
+            if (patchtype[a.id] >0 ) {
+              if (patchtype[b.id] > 0) {
                 //patchy sc with patchy sc
                 int i, intrs;
                 //  double rcut=11.2246204831+6.0;
@@ -805,10 +825,10 @@ namespace Faunus {
                   intersections[i]=0;
                 //1- do intersections of spherocylinder2 with patch of spherocylinder1 at.
                 // cut distance C
-                if (atom.list[a.id].patchtype == 1) {
+                if (patchtype[a.id] == 1) {
                   intrs=Geometry::psc_intersect(a,b,r_cm, intersections, rcut2);
                 } else {
-                  if (atom.list[a.id].patchtype == 2) {
+                  if (patchtype[a.id] == 2) {
                     intrs=Geometry::cpsc_intersect(a,b,r_cm, intersections, rcut2);
                   } else {
                     //we dont have anything like this
@@ -823,10 +843,10 @@ namespace Faunus {
                 //2- now do the same oposite way psc1 in patch of psc2
                 for(i=0;i<5;i++)
                   intersections[i]=0;
-                if (atom.list[a.id].patchtype == 1) {
+                if (patchtype[a.id] == 1) {
                   intrs=Geometry::psc_intersect(b,a,-r_cm, intersections, rcut2);
                 } else {
-                  if (atom.list[a.id].patchtype == 2) {
+                  if (patchtype[a.id] == 2) {
                     intrs=Geometry::cpsc_intersect(b,a,-r_cm, intersections, rcut2);
                   } else {
                     assert(!"Patchtype not implemented!");
@@ -877,7 +897,7 @@ namespace Faunus {
                 //patchy sc with isotropic sc - we dont have at the moment
               }
             } else {
-              if (atom.list[b.id].patchtype > 0) {
+              if (patchtype[b.id] > 0) {
                 assert(!"PSC w. isotropic cigar not implemented!");
                 //isotropic sc with patchy sc - we dont have at the moment
               }
@@ -900,6 +920,14 @@ namespace Faunus {
      * This takes three pair potentials that will be called dependent on the
      * nature of the two particles. If the sphero-cylinder has zero length it
      * is assumed to be a spherical, isotropic particle.
+     *
+     * Before any segment distances are evaluated, the pair is tested against
+     * its bounding spheres: if the mass center separation exceeds
+     * @f$ l_a/2 + l_b/2 + r_c @f$ the energy is zero and no further work
+     * is done. The interaction range, @f$ r_c @f$, is tabulated per
+     * pair of particle types from the (squared) cut-offs, `rcut2`, reported
+     * by the three pair potentials. Type pairs for which any of the
+     * potentials reports no cut-off (zero) are never rejected.
      */
     template<typename Tcigarcigar, typename Tspheresphere, typename Tcigarsphere>
       class CigarSphereSplit : public PairPotentialBase {
@@ -910,6 +938,26 @@ namespace Faunus {
               + pairpot_cs.brief();
           }
 
+          PairMatrix<double> rc; // interaction range between segment surfaces
+
+          void setRange() {
+            size_t n=atom.list.size();
+            rc.resize(n);
+            for (size_t i=0; i<n; i++)
+              for (size_t j=i; j<n; j++) {
+                double r2=0;
+                for (double x : { pairpot_ss.rcut2(i,j),
+                    pairpot_cc.pairpot.rcut2(i,j), pairpot_cs.pairpot.rcut2(i,j) }) {
+                  if (x<=0) {
+                    r2=pc::infty;
+                    break;
+                  }
+                  r2=std::max(r2,x);
+                }
+                rc.set(i,j,sqrt(r2));
+              }
+          }
+
         public:
           Tspheresphere pairpot_ss;
           PatchyCigarCigar<Tcigarcigar> pairpot_cc;
@@ -917,6 +965,23 @@ namespace Faunus {
 
           CigarSphereSplit(InputMap &in) : pairpot_ss(in), pairpot_cc(in), pairpot_cs(in){
             name="CigarSphereSplit";
+            setRange();
+          }
+
+          /**
+           * @brief Largest mass center separation with non-zero energy
+           *
+           * Based on the half lengths found in the atom list. Returns
+           * infinity if one or more type pairs have no cut-off.
+           */
+          double maxRange() const {
+            double lmax=0, rmax=0;
+            for (size_t i=0; i<atom.list.size(); i++) {
+              lmax=std::max(lmax, atom.list[i].half_len);
+              for (size_t j=i; j<atom.list.size(); j++)
+                rmax=std::max(rmax, rc(i,j));
+            }
+            return rmax+2*lmax;
           }
 
           double operator() (const CigarParticle &a, const CigarParticle &b, double r2) const {
@@ -926,7 +991,10 @@ namespace Faunus {
 
           double operator() (const CigarParticle &a, const CigarParticle &b, const Point &r_cm)
           {
-              
+            double rmax=a.halfl+b.halfl+rc(a.id,b.id);
+            if (r_cm.squaredNorm()>rmax*rmax)
+              return 0;
+
             if (a.halfl<1e-6) {
               // a sphere - b sphere
               if (b.halfl<1e-6) {
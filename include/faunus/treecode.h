@@ -0,0 +1,337 @@
+#ifndef FAUNUS_TREECODE_H
+#define FAUNUS_TREECODE_H
+
+#ifndef SWIG
+#include <faunus/energy.h>
+#endif
+
+namespace Faunus {
+
+  namespace Energy {
+
+    /**
+     * @brief Octree (Barnes-Hut) electrostatics for non-periodic containers
+     *
+     * The unscreened Coulomb energy,
+     * @f$ \beta U = \lambda_B \sum_{i<j} z_iz_j/r_{ij} @f$,
+     * is evaluated using a hierarchical octree. Each node stores the charge,
+     * dipole and traceless quadrupole moments of its particles with respect
+     * to the node center, and the potential at a point is summed from nodes
+     * for which @f$ s/d<\theta @f$, where @f$s@f$ is the node side length and
+     * @f$d@f$ the distance to the node center. Nearby nodes are opened down
+     * to leaves of at most `treecode_leafsize` particles, where pairs are
+     * summed exactly. The total energy thus costs O(N log N) rather than
+     * O(N^2), with a relative error that decreases as @f$\theta^3@f$.
+     *
+     * The tree is kept for the accepted configuration, `Space::p`. For a trial
+     * configuration only particles that were moved or had their charge changed
+     * are considered: these are flagged in the tree so that nodes holding them
+     * are always opened and their old contributions skipped, and the energy
+     * change is the change in their interaction with the rest of the system,
+     * via the tree, plus their exact mutual energy. Moving a single particle or
+     * a group of n particles therefore costs O(n log N). When accepted, moved
+     * particles are relocated in the tree and the total energy is updated with
+     * the very same energy change so that, if no particle leaves the root cell,
+     * `systemEnergy()` is consistent with the sum of accepted energy changes.
+     * If more than a quarter of the particles change, the particle number
+     * changes, or a particle leaves the root cell, the tree is rebuilt.
+     *
+     * The energy is returned by `external()`, i.e. the pair potential used in
+     * `Energy::Nonbonded` must not include Coulomb interactions:
+     *
+     *     typedef Space<Geometry::Sphere> Tspace;
+     *     auto pot = Energy::Nonbonded<Tspace,Potential::HardSphere>(in)
+     *       + Energy::Treecode<Tspace>(in);
+     *
+     * Keyword              | Description
+     * :------------------- | :----------------------------------------------
+     * `treecode_theta`     | Opening angle, theta (default: 0.3)
+     * `treecode_leafsize`  | Max. particles in a leaf (default: 8)
+     *
+     * The Bjerrum length is read by `Potential::Coulomb`.
+     *
+     * @note Local (FMM) expansions are not used; per-particle evaluation is
+     *       what incremental Monte Carlo moves require.
+     * @date Lund 2014
+     */
+    template<class Tspace>
+      class Treecode : public Energybase<Tspace> {
+        private:
+          typedef Energybase<Tspace> base;
+          typedef typename base::Tparticle Tparticle;
+          typedef typename base::Tpvec Tpvec;
+          typedef typename Tspace::GeometryType Tgeometry;
+
+          struct Node {
+            Point center;            // geometric center of cell
+            double side;             // cell side length
+            double q;                // charge...
+            Eigen::Vector3d mu;      // ...dipole and...
+            Eigen::Matrix3d theta;   // ...quadrupole moment around center
+            int child;               // index of first of eight children, -1 if leaf
+            int flagged;             // number of flagged particles in cell
+            vector<int> index;       // particles in leaf
+            Node(const Point &c, double s) : center(c), side(s), q(0), child(-1), flagged(0) {
+              mu.setZero();
+              theta.setZero();
+            }
+          };
+
+          vector<Node> node;         // node[0] is the root
+          vector<int> leaf;          // leaf of each particle
+          vector<char> flag;         // particles excluded from tree sums
+          Tpvec cache;               // particles in tree
+          Potential::Coulomb coulomb;
+          double lB, theta2, u;      // Bjerrum length, opening angle squared, total energy
+          size_t leafsize;
+          unsigned long long int cnt_rebuild;
+
+          string _info() {
+            using namespace Faunus::textio;
+            std::ostringstream o;
+            o << pad(SUB,25,"Opening angle") << std::sqrt(theta2) << endl
+              << pad(SUB,25,"Max. leaf size") << leafsize << endl
+              << pad(SUB,25,"Bjerrum length") << lB << _angstrom << endl
+              << pad(SUB,25,"Tree nodes") << node.size() << endl
+              << pad(SUB,25,"Tree rebuilds") << cnt_rebuild << endl;
+            return o.str();
+          }
+
+          /** @brief Add (s=1) or remove (s=-1) particle moments from node */
+          static void addMoments(Node &n, const Tparticle &a, double s) {
+            if (a.charge==0)
+              return;
+            Eigen::Vector3d d = (a - n.center).template cast<double>();
+            double q = s*a.charge;
+            n.q += q;
+            n.mu += q*d;
+            n.theta += 0.5*q*( 3*d*d.transpose() - d.squaredNorm()*Eigen::Matrix3d::Identity() );
+          }
+
+          int octant(const Node &n, const Point &a) const {
+            return (a.x()>n.center.x()) + 2*(a.y()>n.center.y()) + 4*(a.z()>n.center.z());
+          }
+
+          bool inside(const Point &a) const {
+            const Node &r=node[0];
+            return (a-r.center).cwiseAbs().maxCoeff() <= r.side/2;
+          }
+
+          void split(int k) {
+            node[k].child = node.size();
+            for (int o=0; o<8; o++) {
+              Point c = node[k].center;
+              double s = node[k].side/2;
+              c.x() += (o&1 ? 0.5 : -0.5)*s;
+              c.y() += (o&2 ? 0.5 : -0.5)*s;
+              c.z() += (o&4 ? 0.5 : -0.5)*s;
+              node.push_back( Node(c,s) );
+            }
+            vector<int> v;
+            std::swap(v, node[k].index);
+            for (auto i : v)
+              insert(i, node[k].child + octant(node[k], cache[i]));
+          }
+
+          /** @brief Insert particle i from `cache` into the tree below node k */
+          void insert(int i, int k=0) {
+            while (true) {
+              addMoments(node[k], cache[i], 1);
+              if (node[k].child<0) {
+                node[k].index.push_back(i);
+                leaf[i]=k;
+                if (node[k].index.size()>leafsize && node[k].side>1e-6)
+                  split(k);
+                return;
+              }
+              k = node[k].child + octant(node[k], cache[i]);
+            }
+          }
+
+          /** @brief Remove particle i from the tree */
+          void remove(int i) {
+            for (int k=0; ; k=node[k].child+octant(node[k],cache[i])) {
+              addMoments(node[k], cache[i], -1);
+              if (k==leaf[i]) {
+                auto &v=node[k].index;
+                v.erase( std::find(v.begin(), v.end(), i) );
+                return;
+              }
+            }
+          }
+
+          /** @brief Flag (s=1) or unflag (s=-1) particle along its path */
+          void setFlag(int i, int s) {
+            flag[i] = (s>0);
+            for (int k=0; ; k=node[k].child+octant(node[k],cache[i])) {
+              node[k].flagged += s;
+              if (k==leaf[i])
+                return;
+            }
+          }
+
+          /** @brief Potential (units of lB) at a, excluding particle `self` and flagged particles */
+          double phi(const Point &a, int self=-1, int k=0) const {
+            const Node &n = node[k];
+            if (n.child<0 && n.index.empty())
+              return 0;
+            Eigen::Vector3d R = (a - n.center).template cast<double>();
+            double r2 = R.squaredNorm();
+            if (n.flagged==0 && n.side*n.side < theta2*r2) {
+              double r1=std::sqrt(r2), r3=r1*r2;
+              return n.q/r1 + n.mu.dot(R)/r3 + R.dot(n.theta*R)/(r3*r2);
+            }
+            double s=0;
+            if (n.child<0) {
+              for (auto j : n.index)
+                if (j!=self && !flag[j] && cache[j].charge!=0)
+                  s += cache[j].charge / (a-cache[j]).norm();
+              return s;
+            }
+            for (int o=0; o<8; o++)
+              s += phi(a, self, n.child+o);
+            return s;
+          }
+
+          /** @brief Build tree from particle vector and return total energy */
+          double rebuild(const Tpvec &p) {
+            cnt_rebuild++;
+            cache = p;
+            node.clear();
+            leaf.assign(p.size(), 0);
+            flag.assign(p.size(), 0);
+            Point lo(pc::infty, pc::infty, pc::infty), hi=-lo;
+            for (auto &a : p) {
+              lo = lo.cwiseMin(a);
+              hi = hi.cwiseMax(a);
+            }
+            if (p.empty())
+              lo=hi=Point(0,0,0);
+            double side = std::max( 1.0, 1.5*(hi-lo).maxCoeff() ); // room for moves
+            node.reserve( 16*p.size()/leafsize+8 );
+            node.push_back( Node( 0.5*(lo+hi), side ) );
+            for (size_t i=0; i<p.size(); i++)
+              insert(i);
+            double s=0;
+            for (size_t i=0; i<p.size(); i++)
+              if (p[i].charge!=0)
+                s += p[i].charge * phi(p[i], i);
+            return 0.5*lB*s;
+          }
+
+          /** @brief True if position or charge differ */
+          static bool changed(const Tparticle &a, const Tparticle &b) {
+            return a.x()!=b.x() || a.y()!=b.y() || a.z()!=b.z() || a.charge!=b.charge;
+          }
+
+          /**
+           * @brief Energy change if particles `moved` are changed from `cache` to `p`
+           *
+           * Returns infinity if the tree cannot be used.
+           */
+          double change(const Tpvec &p, const vector<int> &moved) {
+            for (auto i : moved)
+              if (!inside(p[i]))
+                return pc::infty;
+            for (auto i : moved)
+              setFlag(i,1);
+            double du=0;
+            for (size_t k=0; k<moved.size(); k++) {
+              int i=moved[k];
+              du += p[i].charge*phi(p[i]) - cache[i].charge*phi(cache[i]);
+              for (size_t l=0; l<k; l++) {
+                int j=moved[l];
+                if (p[i].charge!=0 && p[j].charge!=0)
+                  du += p[i].charge*p[j].charge / (p[i]-p[j]).norm();
+                if (cache[i].charge!=0 && cache[j].charge!=0)
+                  du -= cache[i].charge*cache[j].charge / (cache[i]-cache[j]).norm();
+              }
+            }
+            for (auto i : moved)
+              setFlag(i,-1);
+            return lB*du;
+          }
+
+          void diff(const Tpvec &p, vector<int> &moved) const {
+            moved.clear();
+            for (size_t i=0; i<p.size(); i++)
+              if (changed(p[i],cache[i]))
+                moved.push_back(i);
+          }
+
+          /** @brief Bring tree in sync with `Space::p` */
+          void sync() {
+            const Tpvec &p = base::spc->p;
+            vector<int> moved;
+            if (cache.size()==p.size() && !node.empty()) {
+              diff(p,moved);
+              if (moved.empty())
+                return;
+              if (moved.size()<=p.size()/4) {
+                double du=change(p,moved);
+                if (du!=pc::infty) {
+                  for (auto i : moved) {
+                    remove(i);
+                    cache[i]=p[i];
+                    insert(i);
+                  }
+                  u+=du;
+                  return;
+                }
+              }
+            }
+            u=rebuild(p);
+          }
+
+        public:
+          Treecode(InputMap &in) : coulomb(in), u(0), cnt_rebuild(0) {
+            static_assert(
+                !std::is_base_of<Geometry::Cuboid, Tgeometry>::value
+                && !std::is_same<Geometry::PeriodicCylinder, Tgeometry>::value,
+                "Tree code requires a non-periodic geometry" );
+#ifdef HYPERSPHERE
+            static_assert( !std::is_same<Geometry::hyperSphere, Tgeometry>::value,
+                "Tree code requires a Euclidean geometry" );
+#endif
+            base::name="Tree code electrostatics";
+            lB = coulomb.bjerrumLength();
+            setTheta( in.get<double>("treecode_theta", 0.3, "Tree code opening angle") );
+            leafsize = std::max(1, in.get<int>("treecode_leafsize", 8, "Tree code leaf size"));
+          }
+
+          /** @brief Set opening angle; the tree energy is recalculated on next call */
+          void setTheta(double t) {
+            assert(t>=0 && t<1 && "Opening angle must be in [0,1)");
+            theta2=t*t;
+            node.clear();
+          }
+
+          /** @brief Coulomb energy (kT) */
+          double external(const Tpvec &p) FOVERRIDE {
+            assert(base::spc!=nullptr && "Call setSpace() first");
+            sync();
+            if (&p==&base::spc->p)
+              return u;
+            if (p.size()!=cache.size()) {
+              Tpvec keep;
+              std::swap(keep,cache);
+              double ut=rebuild(p);       // temporary tree for p...
+              u=rebuild(keep);            // ...and restore the accepted one
+              return ut;
+            }
+            vector<int> moved;
+            diff(p,moved);
+            double du = (moved.size()<=p.size()/4) ? change(p,moved) : pc::infty;
+            if (du==pc::infty) {
+              Tpvec keep=cache;
+              double ut=rebuild(p);
+              u=rebuild(keep);
+              return ut;
+            }
+            return u+du;
+          }
+      };
+
+  }//namespace Energy
+}//namespace Faunus
+#endif
@@ -61,10 +61,10 @@
  *    three decimals guaranteed accuracy, and reduces the filesize to 1/10th
  *    of normal binary data.
  *
- * We do not support getting or setting positions in XDR files, since it can
- * break in horrible ways for large (64-bit) files, resulting in silent data
- * corruption. Note that it works great to open/read/write 64-bit files if
- * your system supports it; it is just the random access we cannot trust!
+ * Getting and setting positions in XDR files is supported through 64-bit
+ * file offsets only (xdr_tell() and xdr_seek()); the 32-bit XDR stream
+ * positions can break in horrible ways for large files, resulting in silent
+ * data corruption.
  *
  * We also provide wrapper routines so this module can be used from FORTRAN -
  * see the file xdrfile_fortran.txt in the Gromacs distribution for 
@@ -75,6 +75,8 @@
 #ifndef _XDRFILE_H_
 #define _XDRFILE_H_
 
+#include <stdint.h>
+
 
 /*! \brief Abstract datatype for an portable binary file handle 
  *
@@ -140,6 +142,36 @@ int
 xdrfile_close   (XDRFILE *       xfp);
 
 
+/*! \brief Get the current byte position in a portable binary file, like ftell()
+ *
+ *  Positions are 64-bit on all platforms where the C library supports
+ *  large files (fseeko/ftello or _fseeki64/_ftelli64).
+ *
+ *  \param xfp  Pointer to an abstract XDRFILE datatype
+ *
+ *  \return     Byte offset from the start of the file, or -1 on error.
+ */
+int64_t
+xdr_tell        (XDRFILE *       xfp);
+
+
+/*! \brief Set the byte position in a portable binary file, like fseek()
+ *
+ *  Only seek to positions previously obtained with xdr_tell() at the
+ *  beginning of a record, e.g. an xtc frame.
+ *
+ *  \param xfp     Pointer to an abstract XDRFILE datatype
+ *  \param pos     Byte offset relative to \a whence
+ *  \param whence  SEEK_SET, SEEK_CUR or SEEK_END
+ *
+ *  \return        0 on success, non-zero on error.
+ */
+int
+xdr_seek        (XDRFILE *       xfp,
+                 int64_t         pos,
+                 int             whence);
+
+
 
 
 /*! \brief Read one or more \a char type variable(s) 
@@ -15,9 +15,12 @@ namespace Faunus {
     AnalysisBase::~AnalysisBase() {}
 
 
+    thread_local bool AnalysisBase::presampled = false;
+
     bool AnalysisBase::run() {
-      if (slp_global() > runfraction)
-        return false;
+      if (!presampled)
+        if (slp_global() > runfraction)
+          return false;
       cnt++;
       return true;
     }
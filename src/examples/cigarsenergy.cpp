@@ -14,7 +14,8 @@ int main() {
 
   // Energy functions and space
   Tspace spc(mcp);
-  auto pot = Energy::NonbondedVector<Tspace,Tpairpot>(mcp);
+  auto pot = Energy::NonbondedCellList<Tspace,Tpairpot>(mcp);
+  pot.setCutoff( pot.pairpot.maxRange() );
 
   // Load and add cigars to Space
   Group cigars;
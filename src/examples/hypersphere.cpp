@@ -0,0 +1,90 @@
+#include <faunus/faunus.h>
+#include <chrono>
+using namespace Faunus;
+using namespace Faunus::Potential;
+
+typedef CombinedPairPotential<Coulomb,LennardJonesLB> Tpairpot;
+typedef Geometry::hyperSphere Tgeometry;
+typedef Space<Tgeometry,PointParticle> Tspace;
+
+/* wall clock time of `f()` in seconds */
+template<class Tfunc>
+double timing(Tfunc f) {
+  auto t0 = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+}
+
+int main() {
+  cout << textio::splash();
+
+  InputMap mcp("hypersphere.input");
+  Tspace spc(mcp);
+  Group salt;
+  salt.addParticles(spc, mcp);
+
+  Energy::NonbondedHyperSphere<Tspace,Tpairpot> pot(mcp);
+  Energy::Nonbonded<Tspace,Tpairpot> ref(mcp);
+  pot.setSpace(spc);
+  ref.setSpace(spc);
+
+  double utol = mcp.get<double>("hypertab_utol", 1e-6);
+  int repeat = mcp.get<int>("hyper_repeat", 10, "Number of i2all() sweeps to time");
+  int n = spc.p.size(), failed = 0;
+
+  // tabulated pair energies must agree with the exact ones to within utol
+  double maxerr = 0;
+  for (int i=0; i<n; i++)
+    for (int j=i+1; j<n; j++)
+      maxerr = std::max(maxerr,
+          std::fabs( pot.p2p(spc.p[i],spc.p[j]) - pot.p2p_exact(spc.p[i],spc.p[j]) ) );
+  failed += (maxerr > utol);
+
+  // ...and so must particle energies with those from sqdist()
+  double maxierr = 0;
+  for (int i=0; i<n; i++)
+    maxierr = std::max(maxierr, std::fabs( pot.i2all(spc.p,i) - ref.i2all(spc.p,i) ) );
+  failed += (maxierr > n*utol);
+
+  double u1=0, u2=0;
+  double t1 = timing( [&]() {
+      for (int k=0; k<repeat; k++)
+        for (int i=0; i<n; i++)
+          u1 += pot.i2all(spc.p,i); } );
+  double t2 = timing( [&]() {
+      for (int k=0; k<repeat; k++)
+        for (int i=0; i<n; i++)
+          u2 += ref.i2all(spc.p,i); } );
+
+  using namespace textio;
+  cout << atom.info() + spc.info() + pot.info() << header("Hypersphere tables")
+    << pad(SUB,30,"Max. pair energy error") << maxerr << kT << endl
+    << pad(SUB,30,"Max. particle energy error") << maxierr << kT << endl
+    << pad(SUB,30,"Table i2all() time") << t1/(repeat*n)*1e6 << " us" << endl
+    << pad(SUB,30,"Exact i2all() time") << t2/(repeat*n)*1e6 << " us" << endl
+    << pad(SUB,30,"Speedup") << t2/t1 << endl
+    << pad(SUB,30,"Energy difference") << (u1-u2)/repeat << kT << endl;
+
+  return failed;
+}
+/**
+  @page example_hypersphere Example: Hypersphere pair tables
+
+  This example validates and times `Energy::NonbondedHyperSphere` against
+  `Energy::Nonbonded` using the geodesic distance from
+  `Geometry::hyperSphere::sqdist()`. Ions are placed on the hypersphere and
+  the program fails if
+
+  - a tabulated pair energy differs from the exact one by more than
+    `hypertab_utol`, or
+  - a particle energy, `i2all()`, differs from the one using `sqdist()` by
+    more than the number of particles times `hypertab_utol`.
+
+  The time per `i2all()` call is reported for both and the ratio is
+  printed as the speedup. Information about the input file can be found in
+  `src/examples/hypersphere.run`.
+
+  hypersphere.cpp
+  ===============
+  @includelineno examples/hypersphere.cpp
+*/
@@ -67,6 +67,22 @@ int main(int argc, char** argv) {
   Scatter::DebyeFormula<Scatter::FormFactorUnity<>> debye(mcp);
   Scatter::DebyeFormula<Scatter::FormFactorUnity<>> debye2(mcp);
 
+  // g(r) and I(q) of mass centers are sampled in background threads
+  typedef Analysis::AnalysisPipeline<Tspace> Tpipeline;
+  Tpipeline pipe(mcp,spc);
+  const size_t npol = pol.size();
+  pipe.add("g(r)", rdf, [=](decltype(rdf) &a, const Tpipeline::Snapshot &s) {
+      for (size_t i=0; i<npol-1; i++)
+        for (size_t j=i+1; j<npol; j++)
+          a( s.geo.dist(s.groups[i].cm, s.groups[j].cm) )++;
+      } );
+  pipe.add("I(q)", debye, [=](decltype(debye) &a, const Tpipeline::Snapshot &s) {
+      vector<Point> cm;
+      for (size_t i=0; i<npol; i++)
+        cm.push_back(s.groups[i].cm);
+      a.sample(cm,s.geo.getVolume());
+      } );
+
   spc.load("state"); // load previous state, if any
 
   Move::Isobaric<Tspace> iso(mcp,pot,spc);
@@ -106,15 +122,11 @@ int main(int argc, char** argv) {
           }
 
           if (slp_global()>0.995) {
-            // sample g(r)
-            for (auto i=pol.begin(); i!=pol.end()-1; i++)
-              for (auto j=i+1; j!=pol.end(); j++)
-                rdf( spc.geo.dist(i->cm,j->cm) )++;
+            pipe.sample(); // g(r) and I(q)
 
             cm_vec.clear();
             for (auto &i : pol)
               cm_vec.push_back(i.cm);
-            debye.sample(cm_vec,spc.geo.getVolume());
 
             if (mpi.isMaster())
               if (cmfile) {
@@ -146,6 +158,7 @@ int main(int argc, char** argv) {
     } // end of micro loop
 
     sys.checkDrift( Energy::systemEnergy(spc,pot,spc.p) ); // detect energy drift
+    pipe.merge();
 
     if (mpi.isMaster()) {
       cout << loop.timing();
@@ -162,7 +175,7 @@ int main(int argc, char** argv) {
 
   if (mpi.isMaster()) {
     cout << tit.info() + loop.info() + sys.info() + gmv.info() + mv.info()
-      + iso.info() + mpol.info() << endl;
+      + iso.info() + mpol.info() + pipe.info() << endl;
 
     // save first molecule with average charges (as opposed to instantaneous)
     eqenergy->eq.copyAvgCharge(spc.p);
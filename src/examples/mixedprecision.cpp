@@ -0,0 +1,84 @@
+#include <faunus/faunus.h>
+using namespace Faunus;
+using namespace Faunus::Potential;
+
+typedef CombinedPairPotential<CoulombWolf,LennardJonesLB> Tpairpot;
+typedef Geometry::Cuboid Tgeometry;
+typedef Space<Tgeometry,PointParticle> Tspace;
+
+int main() {
+  cout << textio::splash();
+
+  InputMap mcp("mixedprecision.input");
+  MCLoop loop(mcp);
+  EnergyDrift sys;
+  UnitTest test(mcp);
+
+  Tspace spc(mcp);
+  Energy::Nonbonded<Tspace,Tpairpot> pot(mcp);
+  pot.setSpace(spc);
+
+  Move::AtomicTranslation<Tspace> mv(mcp,pot,spc);
+  Group salt;
+  salt.addParticles(spc, mcp);
+  mv.setGroup(salt);
+
+  double u0 = Energy::systemEnergy(spc,pot,spc.p);
+  double maxdrift = mcp.get<double>("precision_maxdrift", 1e-8, "Max. relative energy drift");
+  Average<double> drift, uavg;
+  sys.init(u0);
+
+  cout << atom.info() + spc.info() + pot.info()
+    << textio::pad(textio::SUB,25,"Coordinate precision")
+    << sizeof(Point::Tcoord)*8 << " bit" << endl
+    << textio::pad(textio::SUB,25,"Particle size")
+    << sizeof(Tspace::ParticleType) << " bytes" << endl
+    << textio::header("MC Simulation Begins!");
+
+  while ( loop.macroCnt() ) {
+    while ( loop.microCnt() ) {
+      sys+=mv.move( salt.size() );
+      uavg+=sys.current();
+    }
+    double u = Energy::systemEnergy(spc,pot,spc.p);
+    drift += std::fabs( sys.checkDrift(u)/u );
+    sys.init(u); // restart drift measurement from current energy
+    cout << loop.timing();
+  }
+
+  // the initial energy differs only by rounding of the coordinates, while the
+  // trajectories diverge and averages agree within statistical uncertainty
+  test("initialEnergy", u0, 1e-4);
+  test("energyAverage", uavg.avg(), 0.05);
+  mv.test(test);
+
+  cout << loop.info() + sys.info() + mv.info()
+    << textio::pad(textio::SUB,25,"Mean relative drift") << drift.avg() << endl
+    << textio::pad(textio::SUB,25,"Max. relative drift") << maxdrift << endl
+    << test.info();
+
+  return test.numFailed() + (drift.avg()>maxdrift);
+}
+/**
+  @page example_mixedprecision Example: Mixed precision validation
+
+  This example validates builds with `-DENABLE_MIXEDPRECISION=on` in which
+  particle coordinates, charges, radii and masses are stored in single
+  precision while all energies are summed in double precision.
+  A melt of Lennard-Jones ions with Wolf electrostatics is simulated
+  and the program fails if
+
+  - the relative energy drift, i.e. the difference between the summed
+    energy changes of all accepted moves and the total system energy,
+    exceeds `precision_maxdrift`, or
+  - the initial energy and the average energy differ from those stored
+    by the double precision build in `mixedprecision.test`.
+
+  The drift bound applies to both builds so that the mixed precision drift
+  is bounded relative to the double precision one. Information about the
+  input file can be found in `src/examples/mixedprecision.run`.
+
+  mixedprecision.cpp
+  ==================
+  @includelineno examples/mixedprecision.cpp
+*/
@@ -2,6 +2,7 @@
 #define CATCH_CONFIG_MAIN  // This tell CATCH to provide a main() - only do this in one cpp file
 #include <catch/catch.hpp>
 #include <faunus/faunus.h>
+#include <faunus/mpi.h>
 
 using namespace Faunus;
 
@@ -172,6 +173,20 @@ TEST_CASE("Geometries", "Geometry tests")
   double y = geoCyl.sqdist(a,b);
   CHECK( x==Approx(16+64) );
   CHECK( x==Approx(y) );
+  CHECK( Geometry::Policy<Geometry::Sphere>::sqdist(geoSph,a,b) == Approx(x) );
+  CHECK( Geometry::Policy<Geometry::Geometrybase>::sqdist(geoCyl,a,b) == Approx(y) );
+}
+
+TEST_CASE("Hyperpoints", "4D dot products and geodesic distances")
+{
+  HyperPoint a(0.5,0.5,0.5,0.5), b(0,0,std::sqrt(0.5),std::sqrt(0.5));
+  CHECK( a.vec4().squaredNorm() == Approx(1) );
+  CHECK( a.cosangle(b) == Approx(std::sqrt(0.5)) );
+  CHECK( a.geodesic(b) == Approx(pc::pi/4) );
+  CHECK( a.geodesic(a) == Approx(0) ); // rounding must not give NaN
+  b.vec4() = -a.vec4();
+  CHECK( b.z4() == Approx(-0.5) );
+  CHECK( a.geodesic(b) == Approx(pc::pi) );
 }
 
 TEST_CASE("Random numbers", "Check random number generator")
@@ -200,6 +215,12 @@ TEST_CASE("Quaternion", "Check vector rotation")
   CHECK( a.x() == Approx(0.0) );
   a = qrot(a); // rot. 90 deg.
   CHECK( a.x() == Approx(-1.0) );
+
+  Geometry::QuaternionRotateBase<Geometry::Cylinder> srot;
+  srot.setAxis( geo, Point(0,0,0), Point(0,1,0), pc::pi/2);
+  Point c = srot(a);
+  CHECK( c.x() == Approx(0.0) );
+  CHECK( (c-qrot(a)).norm() == Approx(0.0) );
 }
 
 TEST_CASE("Tables and averages","Check table of averages")
@@ -210,3 +231,1082 @@ TEST_CASE("Tables and averages","Check table of averages")
   table(2.1)+=3;
   CHECK( table(2.1).avg() == Approx(2.0) );
 }
+
+TEST_CASE("Streaming statistics", "Blocking error and autocorrelation of an AR(1) process")
+{
+  // x(t) = phi*x(t-1) + noise has statistical inefficiency (1+phi)/(1-phi)
+  // and normalized autocorrelation phi^k
+  double phi=0.8, x=0;
+  std::mt19937 eng(7);
+  std::normal_distribution<double> noise;
+  BlockAverage<double> b;
+  MultipleTauCorrelation<double> c;
+  std::vector<double> v;
+  for (int i=0; i<(1<<18); i++) {
+    x = phi*x + noise(eng);
+    b += x;
+    c += x;
+    if (i<1000)
+      v.push_back(x);
+  }
+  CHECK( b.cnt() == (1u<<18) );
+  CHECK( b.levels() == 19 );
+  CHECK( b.inefficiency() == Approx( (1+phi)/(1-phi) ).epsilon(0.15) );
+  CHECK( b.converged( 2*b.error() ) );
+  CHECK( !b.converged( b.error()/2 ) );
+  CHECK( c.lag(20) == 24 );
+  for (size_t i=0; i<c.size() && c.lag(i)<=16; i++)
+    CHECK( c[i] == Approx( std::pow(phi, c.lag(i)) ).epsilon(0.02) );
+
+  // FFT autocorrelation must match direct summation
+  auto r = autocorrelation(v);
+  double mu = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+  for (size_t k : {0, 1, 5, 100, 999}) {
+    double nom=0, den=0;
+    for (size_t t=0; t<v.size(); t++) {
+      den += (v[t]-mu)*(v[t]-mu);
+      if (t+k<v.size())
+        nom += (v[t]-mu)*(v[t+k]-mu);
+    }
+    CHECK( r[k] == Approx(nom/den) );
+  }
+}
+
+TEST_CASE("Indexed trajectory", "Random access and parallel reanalysis of xtc files")
+{
+  std::ofstream js("xtc_test.json"), inp("xtc_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"xa\" : {\"q\":1, \"r\":1.0},\n"
+    << "\"xb\" : {\"q\":-1, \"r\":1.0}\n } \n }";
+  inp << "cuboid_len 20\n" << "tion1 xa\n nion1 20\n tion2 xb\n nion2 20\n";
+  js.close();
+  inp.close();
+  std::remove("xtc_test.xtc");
+  std::remove("xtc_test.xtc.idx");
+
+  ::atom.includefile("xtc_test.json");
+  InputMap in("xtc_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Tspace spc(in);
+  Group g;
+  g.addParticles(spc, in);
+
+  std::vector<Tspace::ParticleVector> saved;
+  auto write = [&](int frames) {
+    std::remove("xtc_test.xtc");
+    saved.clear();
+    FormatXTC xtc(spc.geo.len.x());
+    for (int i=0; i<frames; i++) {
+      for (auto &p : spc.p)
+        spc.geo.randompos(p);
+      saved.push_back(spc.p);
+      xtc.setbox(spc.geo.len);
+      xtc.save("xtc_test.xtc", spc.p);
+    }
+    xtc.close();
+  };
+  write(20);
+
+  TrajectoryXTC traj("xtc_test.xtc");
+  CHECK( traj.size() == 20 );
+  CHECK( traj.atoms() == 40 );
+  TrajectoryXTC::Frame<Tspace> f(spc);
+  for (int i : {13, 2, 19}) {
+    CHECK( traj.load(i, f) );
+    CHECK( f.step == i );
+    CHECK( f.geo.len.x() == Approx(20) );
+    for (size_t j=0; j<f.p.size(); j++)
+      CHECK( f.geo.dist(f.p[j], saved[i][j]) < 0.02 );
+  }
+  CHECK( TrajectoryXTC("xtc_test.xtc").size() == 20 ); // from index file
+
+  // parallel and serial analysis must agree
+  typedef Analysis::RadialDistribution<> Trdf;
+  short a=atom["xa"].id, b=atom["xb"].id;
+  Trdf serial(0.5);
+  for (size_t i=0; i<traj.size(); i++)
+    if (traj.load(i, f))
+      serial.sample(f, a, b);
+  Trdf parallel = traj.analyze( spc, Trdf(0.5),
+      [=](Trdf &rdf, TrajectoryXTC::Frame<Tspace> &frame) { rdf.sample(frame, a, b); },
+      0, -1, 1, 3 );
+  for (double r=0.5; r<10; r+=0.5)
+    CHECK( parallel(r) == serial(r) );
+
+  // a stale index must be detected and the trajectory rescanned
+  write(12);
+  CHECK( TrajectoryXTC("xtc_test.xtc").size() == 12 ); // file shrunk
+  {
+    std::vector<int64_t> idx;
+    std::ifstream in("xtc_test.xtc.idx", std::ios::binary);
+    for (int64_t k; in.read((char*)&k, sizeof(k));)
+      idx.push_back(k);
+    in.close();
+    idx.back() += 4; // last offset no longer at a frame header
+    std::ofstream out("xtc_test.xtc.idx", std::ios::binary);
+    out.write((const char*)&idx[0], idx.size()*sizeof(int64_t));
+  }
+  TrajectoryXTC rescanned("xtc_test.xtc");
+  CHECK( rescanned.size() == 12 );
+  CHECK( rescanned.load(11, f) );
+  CHECK( f.step == 11 );
+  CHECK( f.geo.dist(f.p[0], saved[11][0]) < 0.02 );
+}
+
+TEST_CASE("Analysis pipeline", "Snapshots analysed in worker threads must match inline analysis")
+{
+  std::ofstream js("pipe_test.json"), inp("pipe_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"pa\" : {\"q\":1, \"r\":1.0},\n"
+    << "\"pb\" : {\"q\":-1, \"r\":1.0}\n } \n }";
+  inp << "cuboid_len 20\n" << "tion1 pa\n nion1 20\n tion2 pb\n nion2 20\n"
+    << "pipeline_threads 2\n pipeline_queue 3\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("pipe_test.json");
+  InputMap in("pipe_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Tspace spc(in);
+  Group g;
+  g.addParticles(spc, in);
+  g.name="salt";
+  spc.enroll(g);
+
+  typedef Analysis::RadialDistribution<> Trdf;
+  typedef Analysis::AnalysisPipeline<Tspace> Tpipe;
+  short a=atom["pa"].id, b=atom["pb"].id;
+  Trdf serial(0.5), rdf(0.5);
+  Analysis::ChargeMultipole mpol;
+  int calls=0, never=0;
+  {
+    Tpipe pipe(in, spc);
+    pipe.add("g(r)", rdf, [=](Trdf &t, const Tpipe::Snapshot &s) { t.sample(s, a, b); } );
+    pipe.add("count", [&](const Tpipe::Snapshot &s) { calls++; } );
+    mpol.runfraction=0; // decided in sample(), never by the workers
+    pipe.add("never", mpol, [&](Analysis::ChargeMultipole &m, const Tpipe::Snapshot &s) { never++; } );
+    for (int i=0; i<50; i++) {
+      for (auto &p : spc.p)
+        spc.geo.randompos(p);
+      serial.sample(spc, a, b);
+      CHECK( pipe.sample() );
+      if (i==24)
+        pipe.merge();
+    }
+    pipe.merge();
+  }
+  CHECK( calls == 50 );
+  CHECK( never == 0 );
+  for (double r=0.5; r<10; r+=0.5)
+    CHECK( rdf(r) == serial(r) );
+}
+
+TEST_CASE("Multipole expansion", "Distant molecules must be within the multipole error bound")
+{
+  std::ofstream js("mp_test.json"), inp("mp_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"mp\" : {\"q\":0, \"r\":1.0}\n } \n }";
+  inp << "cuboid_len 2000\n" << "temperature 298\n" << "epsilon_r 80\n"
+    << "multipole_error 0.01\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("mp_test.json");
+  InputMap in("mp_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  typedef Energy::NonbondedMultipole<Tspace,Potential::Coulomb> Tpot;
+  Tspace spc(in);
+  Tpot pot(in);
+  Energy::Nonbonded<Tspace,Potential::Coulomb> exact(in);
+  pot.setSpace(spc);
+  exact.setSpace(spc);
+
+  Tspace::ParticleVector v(30);
+  std::mt19937 eng(3);
+  std::uniform_real_distribution<double> unit(-1,1);
+  for (auto &i : v) {
+    i = atom["mp"];
+    i.charge = unit(eng);
+    do {
+      i.x()=5*unit(eng); i.y()=5*unit(eng); i.z()=5*unit(eng);
+    } while (i.norm()>5);
+  }
+  Group a = spc.insert(v);
+  for (auto &i : v)
+    i.x()+=15;
+  Group b = spc.insert(v);
+  a.setMolSize(a.size());
+  b.setMolSize(b.size());
+  spc.trial=spc.p;
+
+  double u;
+  CHECK( !pot.multipole(spc.p, a, b, u) ); // too close
+  CHECK( pot.g2g(spc.p,a,b) == Approx(exact.g2g(spc.p,a,b)) );
+
+  for (double dx : {200, 500}) {
+    for (auto i : b) {
+      spc.trial[i].x() += dx;
+      std::swap( spc.trial[i].y(), spc.trial[i].z() ); // rotate
+    }
+    CHECK( pot.multipole(spc.trial, a, b, u) );
+    CHECK( std::fabs(pot.g2g(spc.trial,a,b) - exact.g2g(spc.trial,a,b)) < 0.01 );
+    CHECK( pot.g2g(spc.p,a,b) == Approx(exact.g2g(spc.p,a,b)) );
+  }
+
+  // particle energies with a distant molecule must add up to g2g()
+  spc.enroll(a);
+  spc.enroll(b);
+  spc.p = spc.trial;
+  double sum=0;
+  for (auto i : a) {
+    double ui = pot.i2all(spc.p,i);
+    CHECK( std::fabs(ui - exact.i2all(spc.p,i)) < 0.01 );
+    sum += ui - pot.i2g(spc.p,a,i);
+  }
+  CHECK( std::fabs(sum - exact.g2g(spc.p,a,b)) < 0.01 );
+  CHECK( std::fabs(exact.g2g(spc.p,a,b)) > 0.01 );
+}
+
+TEST_CASE("Tree code", "Octree electrostatics must match direct summation")
+{
+  std::ofstream js("tc_test.json"), inp("tc_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"tc+\" : {\"q\":1, \"r\":1.0},\n"
+    << "\"tc-\" : {\"q\":-1, \"r\":1.0}\n } \n }";
+  inp << "sphere_radius 40\n" << "temperature 298\n" << "epsilon_r 80\n"
+    << "tion1 tc+\n nion1 400\n tion2 tc-\n nion2 400\n"
+    << "treecode_theta 0.3\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("tc_test.json");
+  InputMap in("tc_test.input");
+  typedef Space<Geometry::Sphere, DipoleParticle> Tspace;
+  Tspace spc(in);
+  Group g;
+  g.addParticles(spc, in);
+  Energy::Treecode<Tspace> tree(in);
+  Energy::Nonbonded<Tspace,Potential::Coulomb> exact(in);
+  tree.setSpace(spc);
+  exact.setSpace(spc);
+
+  double u0 = exact.g_internal(spc.p,g);
+  double u = tree.external(spc.p);
+  CHECK( u == Approx(u0).epsilon(0.005) );
+
+  // incremental single particle and group updates
+  double sum=0;
+  for (int n=0; n<200; n++) {
+    Point d(0,0,0);
+    spc.geo.randompos(d);
+    int i = g.random();
+    spc.trial[i] = spc.p[i] + 0.05*d;
+    if (n%10==0)
+      for (int j=0; j<20; j++)
+        spc.trial[j] = spc.p[j] + 0.05*d; // group move
+    if (spc.geo.collision(spc.trial[i])) {
+      spc.trial=spc.p;
+      continue;
+    }
+    double du = tree.external(spc.trial) - tree.external(spc.p);
+    double duexact = exact.g_internal(spc.trial,g) - exact.g_internal(spc.p,g);
+    CHECK( std::fabs(du-duexact) < 0.02 );
+    if (n%2==0) {
+      spc.p=spc.trial;
+      sum+=du;
+    } else
+      spc.trial=spc.p;
+  }
+  CHECK( tree.external(spc.p) == Approx(u+sum) );
+  Energy::Treecode<Tspace> fresh(in);
+  fresh.setSpace(spc);
+  CHECK( fresh.external(spc.p) == Approx(u+sum).epsilon(0.005) );
+}
+
+TEST_CASE("Scaled NPT", "Cached volume move energies must match the system energy")
+{
+  std::ofstream js("npt_test.json"), inp("npt_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"npt1\" : {\"q\":1, \"r\":1.5, \"dp\":4}\n } \n }";
+  inp << "cuboid_len 40\n" << "temperature 298\n" << "epsilon_r 80\n"
+    << "tion1 npt1\n nion1 30\n npt_dV 0.2\n npt_P 200\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("npt_test.json");
+  InputMap in("npt_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  auto pot = Energy::Nonbonded<Tspace,Potential::Coulomb>(in)
+    + Energy::ExternalPressure<Tspace>(in);
+  Tspace spc(in);
+  Group salt;
+  salt.addParticles(spc, in);
+
+  Move::AtomicTranslation<Tspace> mv(in,pot,spc);
+  Move::IsobaricScaled<Tspace> npt(in,pot,spc);
+  mv.setGroup(salt);
+  npt.addScalable(pot.first, 1);
+  npt.setRemainder(pot.second);
+
+  double u0 = Energy::systemEnergy(spc,pot,spc.p), du=0;
+  for (int i=0; i<200; i++) {
+    du += mv.move( 1+i%5 );
+    du += npt.move();
+  }
+  double u1 = Energy::systemEnergy(spc,pot,spc.p);
+  CHECK( npt.getAcceptance() > 0 );
+  CHECK( du == Approx(u1-u0) );
+}
+
+TEST_CASE("Virial cell list", "Virial pressure with pair cutoff must match full pair loop")
+{
+  std::ofstream js("virial_test.json"), inp("virial_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"vir1\" : {\"q\":0, \"r\":1.5, \"eps\":1}\n } \n }";
+  inp << "cuboid_len 30\n" << "temperature 298\n"
+    << "tion1 vir1\n nion1 300\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("virial_test.json");
+  InputMap in("virial_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::Nonbonded<Tspace,Potential::WeeksChandlerAndersen> pot(in);
+  Tspace spc(in);
+  Group g;
+  g.addParticles(spc, in);
+  pot.setSpace(spc);
+
+  Analysis::VirialPressure full, cut;
+  cut.cutoff = 4.0; // WCA range is 2^(1/6)*3 angstrom
+  full.sample(spc, pot);
+  cut.sample(spc, pot);
+  CHECK( std::fabs(full.excessTensor().trace()) > 0 );
+  CHECK( cut.excessTensor().trace() == Approx( full.excessTensor().trace() ) );
+  CHECK( cut.excessTensor()(0,1) == Approx( full.excessTensor()(0,1) ) );
+}
+
+TEST_CASE("Cell list energy", "Persistent cell list must match the full pair loop")
+{
+  std::ofstream js("cell_test.json"), inp("cell_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"ce1\" : {\"q\":0, \"r\":1.5, \"eps\":1, \"dp\":2}\n } \n }";
+  inp << "cuboid_len 40\n" << "temperature 298\n"
+    << "tion1 ce1\n nion1 300\n cell_cutoff 4.0\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("cell_test.json");
+  InputMap in("cell_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  typedef Potential::WeeksChandlerAndersen Tpair; // range 2^(1/6)*3 angstrom
+  typedef Energy::Nonbonded<Tspace,Tpair> Texact;
+  Texact exact(in);
+  Energy::NonbondedCellList<Tspace,Tpair,Texact> pot(in);
+  Tspace spc(in);
+  Group salt;
+  salt.addParticles(spc, in);
+  Group a(0,149), b(150,299);
+  pot.setSpace(spc);
+  exact.setSpace(spc);
+
+  auto compare = [&](Tspace::ParticleVector &p) {
+    for (int i=0; i<300; i+=30) {
+      CHECK( pot.i2all(p,i) == Approx( exact.i2all(p,i) ) );
+      CHECK( pot.i2g(p,b,i) == Approx( exact.i2g(p,b,i) ) );
+    }
+    CHECK( pot.g2g(p,a,b) == Approx( exact.g2g(p,a,b) ) );
+    CHECK( pot.g_internal(p,salt) == Approx( exact.g_internal(p,salt) ) );
+  };
+  compare(spc.p);
+
+  // list is updated incrementally by moves
+  Move::AtomicTranslation<Tspace> mv(in,pot,spc);
+  mv.setGroup(salt);
+  double u0 = Energy::systemEnergy(spc,exact,spc.p);
+  double du = mv.move( 5*salt.size() );
+  CHECK( du == Approx( Energy::systemEnergy(spc,exact,spc.p)-u0 ) );
+  compare(spc.p);
+
+  // trial energies with reported moved particles
+  spc.trial[60] = spc.p[30]+Point(0,2.5,0);
+  spc.trial[61] = spc.p[31]+Point(0.1,0,0);
+  pot.setMoved( {60,61} );
+  compare(spc.trial);
+  spc.trial[60] = spc.p[60];
+  spc.trial[61] = spc.p[61];
+  pot.update(false);
+
+  // changes outside of moves
+  spc.p[90] = spc.trial[90] = spc.p[120]+Point(0,0,2.5);
+  pot.update(true);
+  compare(spc.p);
+}
+
+TEST_CASE("MPI work split", "Ranks must share all items and pairs exactly once")
+{
+  for (int N : {0, 1, 2, 5, 17, 100, 1001})
+    for (int nproc : {1, 2, 3, 4, 7, 16}) {
+      std::vector<int> items(N,0), rows(N,0);
+      long npairs = long(N)*(N-1)/2, maxpairs=0;
+      for (int rank=0; rank<nproc; rank++) {
+        auto s = Faunus::MPI::splitEven(rank, nproc, N);
+        for (int i=s.first; i<=s.second; i++)
+          items.at(i)++;
+        auto t = Faunus::MPI::splitTriangle(rank, nproc, N);
+        long pairs=0;
+        for (int i=t.first; i<=t.second; i++) {
+          rows.at(i)++;
+          pairs += N-1-i;
+        }
+        maxpairs = std::max(maxpairs, pairs);
+      }
+      CHECK( std::count(items.begin(), items.end(), 1) == N );
+      CHECK( std::count(rows.begin(), rows.end(), 1) == N );
+      CHECK( maxpairs <= npairs/nproc + N ); // balanced to within one row
+    }
+}
+
+TEST_CASE("Parallel translation", "Checkerboard sweeps must conserve energy bookkeeping")
+{
+  std::ofstream js("ptrans_test.json"), inp("ptrans_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"pt1\" : {\"q\":0, \"r\":1.5, \"eps\":1, \"dp\":2}\n } \n }";
+  inp << "cuboid_len 40\n" << "temperature 298\n"
+    << "tion1 pt1\n nion1 400\n mv_particle_cutoff 4.0\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("ptrans_test.json");
+  InputMap in("ptrans_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::Nonbonded<Tspace,Potential::WeeksChandlerAndersen> pot(in);
+  Tspace spc(in);
+  Group salt;
+  salt.addParticles(spc, in);
+
+  Move::ParallelAtomicTranslation<Tspace> mv(in,pot,spc);
+  mv.setGroup(salt);
+
+  double u0 = Energy::systemEnergy(spc,pot,spc.p), du=0;
+  for (int i=0; i<5; i++)
+    du += mv.move();
+  double u1 = Energy::systemEnergy(spc,pot,spc.p);
+  CHECK( du == Approx(u1-u0) );
+  CHECK( spc.p == spc.trial );
+}
+
+/* WCA potential counting the number of pair evaluations */
+struct CountingWCA : public Potential::WeeksChandlerAndersen {
+  int calls;
+  CountingWCA(InputMap &in) : Potential::WeeksChandlerAndersen(in), calls(0) {}
+  template<class Tparticle>
+    double operator() (const Tparticle &a, const Tparticle &b, double r2) {
+      calls++;
+      return Potential::WeeksChandlerAndersen::operator()(a,b,r2);
+    }
+  template<class Tparticle>
+    double operator() (const Tparticle &a, const Tparticle &b, const Point &r) {
+      return operator()(a,b,r.squaredNorm());
+    }
+};
+
+TEST_CASE("Early rejection", "Bounded energy sums must be exact or certainly rejected")
+{
+  std::ofstream js("early_test.json"), inp("early_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"er1\" : {\"q\":0, \"r\":1.5, \"eps\":1, \"dp\":2}\n } \n }";
+  inp << "cuboid_len 30\n" << "temperature 298\n"
+    << "tion1 er1\n nion1 300\n mv_particle_earlyreject yes\n"
+    << "earlyreject_umin 0\n earlyreject_rnear 4.0\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("early_test.json");
+  InputMap in("early_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::NonbondedEarlyReject<Tspace,Potential::WeeksChandlerAndersen> pot(in);
+  Tspace spc(in);
+  Group salt;
+  salt.addParticles(spc, in);
+  pot.setSpace(spc);
+
+  for (int i=0; i<10; i++) {
+    CHECK( pot.i2all_bound(spc.p, i, pc::infty) == Approx( pot.i2all(spc.p, i) ) );
+    CHECK( pot.i2all_bound(spc.p, i, -1) == pc::infty );
+  }
+
+  Move::AtomicTranslation<Tspace> mv(in,pot,spc);
+  mv.setGroup(salt);
+  double u0 = Energy::systemEnergy(spc,pot,spc.p);
+  double du = mv.move( salt.size() );
+  double u1 = Energy::systemEnergy(spc,pot,spc.p);
+  CHECK( du == Approx(u1-u0) );
+  CHECK( spc.p == spc.trial );
+
+  // an overlap in the near shell must reject before any far pair is visited
+  Energy::NonbondedEarlyReject<Tspace,CountingWCA> cpot(in);
+  cpot.setSpace(spc);
+  spc.trial[0] = spc.p[0] = spc.p[150] + Point(0.5,0,0);
+  cpot.pairpot.calls=0;
+  CHECK( cpot.i2all_bound(spc.p, 0, 10) == pc::infty );
+  CHECK( cpot.pairpot.calls == 1 );
+}
+
+TEST_CASE("Penalty grid", "Dense grid penalty lookup, updates and walker merging")
+{
+  Analysis::PenaltyGrid<> a(0, 10, 0.5), b(0, 10, 0.5);
+  a.setWangLandau(0.1);
+  b.setWangLandau(0.1);
+  CHECK( a(-0.1) == pc::infty );
+  CHECK( a(10.0) == pc::infty );
+  for (int i=0; i<10; i++)
+    a.update(0.25);
+  for (int i=0; i<5; i++)
+    b.update(1.3);
+  std::vector<Analysis::PenaltyGrid<>*> walkers = {&a, &b};
+  Analysis::PenaltyGrid<>::merge(walkers);
+  CHECK( a(0.4) == Approx(1.0) );
+  CHECK( b(0.1) == Approx(1.0) );
+  CHECK( a(1.4) == Approx(0.5) );
+  a.update(0.25);
+  Analysis::PenaltyGrid<>::merge(walkers);
+  CHECK( b(0.25) == Approx(1.1) );
+
+  Analysis::PenaltyGrid<> c(-1, 1, 0.1, -1, 1, 0.1); // 2D
+  c.setWellTempered(1.0, 2.0);
+  double du1 = c.update(0.05, -0.05);
+  double du2 = c.update(0.05, -0.05);
+  CHECK( du1 == Approx(1.0) );
+  CHECK( du2 == Approx(std::exp(-0.5)) );
+  CHECK( c(0.01, -0.01) == Approx(du1+du2) );
+  CHECK( c(0.01, 0.01) == 0 );
+}
+
+TEST_CASE("Grand canonical salt", "Swap-remove tracking and cavity biased insertion")
+{
+  std::ofstream js("gc_test.json"), inp("gc_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"gcna\" : {\"q\":1, \"r\":1.5, \"eps\":1, \"dp\":2, \"activity\":0.5},\n"
+    << "\"gccl\" : {\"q\":-1, \"r\":1.5, \"eps\":1, \"dp\":2, \"activity\":0.5}\n } \n }";
+  inp << "cuboid_len 30\n" << "temperature 298\n"
+    << "tion1 gcna\n nion1 40\n tion2 gccl\n nion2 40\n"
+    << "saltbath_cavitybias yes\n saltbath_cavitygrid 2.5\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("gc_test.json");
+  InputMap in("gc_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::Nonbonded<Tspace,Potential::WeeksChandlerAndersen> pot(in);
+  Tspace spc(in);
+  Group salt;
+  salt.addParticles(spc, in);
+  salt.name="salt";
+
+  Move::GrandCanonicalSalt<Tspace> gc(in,pot,spc,salt);
+  double u0 = Energy::systemEnergy(spc,pot,spc.p), du=0;
+  for (int i=0; i<200; i++)
+    du += gc.move();
+  double u1 = Energy::systemEnergy(spc,pot,spc.p);
+  CHECK( du == Approx(u1-u0) );
+  CHECK( spc.p == spc.trial );
+  CHECK( salt.size() == (int)spc.p.size() );
+  CHECK( gc.getAcceptance() > 0 );
+}
+
+TEST_CASE("Grand canonical chains", "Configurational-bias insertion and deletion of chains")
+{
+  std::ofstream js("cbmc_test.json"), inp("cbmc_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"cbmc1\" : {\"q\":0, \"r\":1.5, \"eps\":1}\n } \n }";
+  inp << "cuboid_len 40\n" << "temperature 298\n"
+    << "gcmol_activity 0.01\n gcmol_trials 8\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("cbmc_test.json");
+  InputMap in("cbmc_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::Nonbonded<Tspace,Potential::WeeksChandlerAndersen> pot(in);
+  Tspace spc(in);
+
+  int n=5, nmol=4; // chain length and initial number of chains
+  DipoleParticle a;
+  a = atom["cbmc1"];
+  for (int m=0; m<nmol; m++)
+    for (int i=0; i<n; i++) {
+      a.x() = -15 + 8*m;
+      a.y() = 0;
+      a.z() = -10 + 3.5*i;
+      spc.insert(a);
+    }
+  Group chains(0, n*nmol-1);
+  chains.setMolSize(n);
+  chains.name="chains";
+  spc.enroll(chains);
+
+  Move::GCMolecular<Tspace> gc(in,pot,spc,chains);
+  double u0 = Energy::systemEnergy(spc,pot,spc.p), du=0;
+  for (int i=0; i<200; i++)
+    du += gc.move();
+  double u1 = Energy::systemEnergy(spc,pot,spc.p);
+  CHECK( du == Approx(u1-u0) );
+  CHECK( spc.p == spc.trial );
+  CHECK( chains.size() == (int)spc.p.size() );
+  CHECK( chains.numMolecules() >= 1 );
+  CHECK( gc.getAcceptance() > 0 );
+  for (int m=0; m<chains.numMolecules(); m++)
+    for (int i=1; i<n; i++) {
+      int j=chains.front()+m*n+i;
+      CHECK( spc.geo.dist(spc.p[j], spc.p[j-1]) == Approx(3.5) );
+    }
+}
+
+TEST_CASE("Force biased translation", "Biased proposals must return unbiased energy changes")
+{
+  std::ofstream js("fbias_test.json"), inp("fbias_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"fb1\" : {\"q\":0, \"r\":1.5, \"eps\":1, \"dp\":1}\n } \n }";
+  inp << "cuboid_len 20\n" << "temperature 298\n"
+    << "tion1 fb1\n nion1 150\n mv_particle_forcebias force\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("fbias_test.json");
+  InputMap in("fbias_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::Nonbonded<Tspace,Potential::WeeksChandlerAndersen> pot(in);
+  Tspace spc(in);
+  Group g;
+  g.addParticles(spc, in);
+
+  Move::ForceBias smart(Move::ForceBias::SMART), force(Move::ForceBias::FORCE, 1.0);
+  Point F(2,0,-1), d(0.1,-0.2,0.3), dir(1,1,1);
+  CHECK( force.lnProposal(Point(0.6,0,0), F, 1.0, dir) == -pc::infty );
+  double dlnp = smart.lnProposal(d, F, 1.0, dir) - smart.lnProposal(d, Point(0,0,0), 1.0, dir);
+  CHECK( dlnp == Approx( -( (d-F/24).squaredNorm() - d.squaredNorm() )*6 ) );
+
+  Move::ForceBiasedTranslation<Tspace> mv(in,pot,spc);
+  mv.setGroup(g);
+  double u0 = Energy::systemEnergy(spc,pot,spc.p);
+  double du = mv.move( 5*g.size() );
+  double u1 = Energy::systemEnergy(spc,pot,spc.p);
+  CHECK( du == Approx(u1-u0) );
+  CHECK( spc.p == spc.trial );
+  CHECK( mv.getAcceptance() > 0.1 );
+}
+
+TEST_CASE("Hydrophobic SASA", "Interface pruning must find the same contacts as all site pairs")
+{
+  std::ofstream js("sasa_test.json"), inp("sasa_test.input"), sf("sasa_test.dat");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"hp\" : {\"q\":0, \"r\":1.5, \"hydrophobic\":true},\n"
+    << "\"np\" : {\"q\":0, \"r\":1.5}\n } \n }";
+  inp << "cuboid_len 300\n temperature 298\n"
+    << "sasahydro_sasafile sasa_test.dat\n sasahydro_duplicate 1\n"
+    << "sasahydro_tension 1\n sasahydro_threshold 3\n";
+  std::mt19937 eng(17);
+  std::uniform_real_distribution<double> unit(-1,1);
+  for (int i=0; i<60; i++)
+    sf << ( (i%5==1) ? 0 : 20*(1+unit(eng)) ) << "\n";
+  js.close();
+  inp.close();
+  sf.close();
+
+  ::atom.includefile("sasa_test.json");
+  InputMap in("sasa_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Tspace spc(in);
+  std::vector<Group> mol(2);
+  for (auto &g : mol) {
+    Tspace::ParticleVector v(30);
+    for (size_t k=0; k<v.size(); k++) { // rod with the first site at the +x end
+      v[k] = atom[ (k==0 || unit(eng)>0) ? "hp" : "np" ];
+      v[k].x() = -2.0*k + 0.3*unit(eng);
+      v[k].y() = 0.5*unit(eng);
+      v[k].z() = 0.5*unit(eng);
+    }
+    g = spc.insert(v);
+    g.setMolSize(v.size());
+    g.name = "mol";
+    g.setMassCenter(spc);
+  }
+  spc.enroll(mol[0]);
+  spc.enroll(mol[1]);
+  spc.trial = spc.p;
+  Energy::HydrophobicSASA<Tspace> pot(in);
+  pot.setSpace(spc);
+
+  // all site pairs, as before pruning
+  std::vector<double> sasa;
+  std::ifstream f("sasa_test.dat");
+  for (double a; f >> a;)
+    sasa.push_back(a);
+  auto reference = [&](const Tspace::ParticleVector &p) {
+    std::vector<bool> v(p.size(),true);
+    double ds=0;
+    for (auto i : mol[0])
+      for (auto j : mol[1])
+        if (p[i].hydrophobic && p[j].hydrophobic && sasa[i]>1e-3 && sasa[j]>1e-3)
+          if (spc.geo.dist(p[i],p[j]) < 3+p[i].radius+p[j].radius) {
+            if (v[i]) ds+=sasa[i];
+            if (v[j]) ds+=sasa[j];
+            v[i]=v[j]=false;
+          }
+    return ds;
+  };
+
+  int contacts=0;
+  double tension = -pot.g2g(spc.p,mol[0],mol[1]) / reference(spc.p);
+  for (double dx=50; dx<70; dx+=0.25) { // contacts only at the edges of the extents
+    for (auto i : mol[1]) {
+      spc.trial[i] = spc.p[i] + Point(dx, 0.2, 0);
+      spc.geo.boundary(spc.trial[i]);
+    }
+    double ds = reference(spc.trial);
+    CHECK( pot.g2g(spc.trial,mol[0],mol[1]) == Approx(-tension*ds) );
+    if (ds>0)
+      contacts++;
+  }
+  CHECK( tension > 0 );
+  CHECK( contacts > 10 );
+  CHECK( pot.g2g(spc.trial,mol[0],mol[1]) == 0 ); // out of reach
+}
+
+TEST_CASE("Rigid body moves", "Rigid and atomic molecular moves must give the same trajectory")
+{
+  std::ofstream js("rigid_test.json");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"rb+\" : {\"q\":1, \"r\":1.5, \"eps\":0.05},\n"
+    << "\"rb-\" : {\"q\":-1, \"r\":1.5, \"eps\":0.05}\n } \n }";
+  js.close();
+  ::atom.includefile("rigid_test.json");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+
+  // run identical move sequences in atomic and rigid mode
+  std::vector<double> energy, drift;
+  std::vector<Tspace::ParticleVector> final;
+  std::vector<double> acceptance;
+  for (string rigid : {"no", "yes"}) {
+    std::ofstream inp("rigid_test.input");
+    inp << "cuboid_len 25\n temperature 298\n epsilon_r 10\n"
+      << "transrot_transdp 4\n transrot_rotdp 2\n transrot_rigid " << rigid << "\n";
+    inp.close();
+    InputMap in("rigid_test.input");
+    Tspace spc(in);
+    Energy::Nonbonded<Tspace,Potential::CoulombLJ> pot(in);
+    pot.setSpace(spc);
+
+    std::mt19937 eng(11);
+    std::uniform_real_distribution<double> unit(-1,1);
+    std::vector<Group> mol(6);
+    for (size_t m=0; m<mol.size(); m++) {
+      Tspace::ParticleVector v(4);
+      for (size_t k=0; k<v.size(); k++) {
+        v[k] = atom[ (k%2) ? "rb+" : "rb-" ];
+        v[k].x() = 8*unit(eng) + 1.2*k;
+        v[k].y() = 8*unit(eng);
+        v[k].z() = 8*unit(eng);
+      }
+      for (size_t k=1; k<v.size(); k++) // compact molecule around first particle
+        v[k] = v[0] + Point(v[k].x()-v[0].x(), v[k].y()-v[0].y(), v[k].z()-v[0].z()).normalized()*1.5*k;
+      mol[m] = spc.insert(v);
+      mol[m].name = "rb";
+      mol[m].setMolSize(v.size());
+      mol[m].setMassCenter(spc);
+      spc.enroll(mol[m]);
+    }
+    spc.trial = spc.p;
+
+    Move::TranslateRotate<Tspace> mv(in,pot,spc);
+    slp_global.seed(-13);
+    double u0 = Energy::systemEnergy(spc,pot,spc.p), du=0;
+    for (int n=0; n<300; n++) {
+      if (n==150) { // change one molecule outside the move
+        Point u(0,0,1);
+        mol[2].rotate(spc, mol[2].cm+u, 0.7);
+        mol[2].translate(spc, Point(1,-1,0.5));
+        mol[2].accept(spc);
+        u0 = Energy::systemEnergy(spc,pot,spc.p) - du;
+      }
+      mv.setGroup( mol[n%mol.size()] );
+      du += mv.move();
+    }
+    double u1 = Energy::systemEnergy(spc,pot,spc.p);
+    CHECK( spc.p == spc.trial );
+    energy.push_back(u1);
+    drift.push_back(u1-u0-du);
+    final.push_back(spc.p);
+    acceptance.push_back(mv.getAcceptance());
+  }
+  CHECK( acceptance[0] > 0.1 );
+  CHECK( acceptance[0] == acceptance[1] );
+  CHECK( energy[0] == Approx(energy[1]) );
+  CHECK( std::fabs(drift[0]) < 1e-8 );
+  CHECK( std::fabs(drift[1]) < 1e-8 );
+  double dmax=0;
+  for (size_t i=0; i<final[0].size(); i++)
+    dmax = std::max(dmax, double( (final[0][i]-final[1][i]).norm() ));
+  CHECK( dmax < 1e-8 );
+}
+
+TEST_CASE("Event chain", "Event chains must move hard spheres without overlap")
+{
+  std::ofstream js("ecmc_test.json"), inp("ecmc_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"ec1\" : {\"q\":0, \"r\":1.0}\n } \n }";
+  inp << "cuboid_len 15\n" << "temperature 298\n"
+    << "tion1 ec1\n nion1 200\n mv_eventchain_length 5\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("ecmc_test.json");
+  InputMap in("ecmc_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Energy::Nonbonded<Tspace,Potential::HardSphere> pot(in);
+  Tspace spc(in);
+  Group g;
+  g.addParticles(spc, in);
+  auto p0 = spc.p;
+
+  Move::EventChain<Tspace> mv(in,pot,spc);
+  mv.setGroup(g);
+  CHECK( mv.move(200) == 0 );
+  CHECK( Energy::systemEnergy(spc,pot,spc.p) == 0 );
+  CHECK( spc.p == spc.trial );
+
+  // each chain displaces particles along one axis by exactly the chain length
+  int wrong=0;
+  for (int n=0; n<100; n++) {
+    if (n==50) // relocate half of the particles outside the move
+      for (int i=0; i<100; i++)
+        do {
+          spc.geo.randompos(spc.p[i]);
+          spc.trial[i] = spc.p[i];
+        } while (pot.i2all(spc.p,i)>0);
+    p0 = spc.p;
+    mv.move(1);
+    Point d(0,0,0);
+    for (size_t i=0; i<p0.size(); i++)
+      d += spc.geo.vdist(spc.p[i], p0[i]);
+    if (std::fabs(d.sum()-5.0)>1e-9 || std::fabs(d.norm()-5.0)>1e-9)
+      wrong++;
+    if (Energy::systemEnergy(spc,pot,spc.p)>0)
+      wrong++;
+  }
+  CHECK( wrong==0 );
+  CHECK( spc.p == spc.trial );
+
+  // a box too small for the cell list must leave particles untouched
+  std::ofstream small("ecmc_small.input");
+  small << "cuboid_len 5\n" << "temperature 298\n" << "tion1 ec1\n nion1 2\n";
+  small.close();
+  InputMap in2("ecmc_small.input");
+  Tspace spc2(in2);
+  Group g2;
+  g2.addParticles(spc2, in2);
+  p0 = spc2.p;
+  Move::EventChain<Tspace> mv2(in2,pot,spc2);
+  mv2.setGroup(g2);
+  mv2.move(5);
+  CHECK( spc2.p == p0 );
+}
+
+TEST_CASE("Ewald summation", "Madelung constant and incremental k-space updates")
+{
+  std::ofstream js("ewald_test.json"), inp("ewald_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"ew1\" : {\"q\":1, \"r\":0.5, \"dp\":0.5},\n"
+    << "\"ew2\" : {\"q\":-1, \"r\":0.5, \"dp\":0.5}\n } \n }";
+  inp << "cuboid_xlen 4\n cuboid_ylen 4\n cuboid_zlen 6\n" << "temperature 298\n"
+    << "epsilon_r 80\n ewald_precision 1e-7\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("ewald_test.json");
+  InputMap in("ewald_test.input");
+  typedef Space<Geometry::Cuboid, DipoleParticle> Tspace;
+  Tspace spc(in);
+  Group g;
+  for (int i=0; i<4; i++)      // rock salt with unit spacing
+    for (int j=0; j<4; j++)
+      for (int k=0; k<6; k++) {
+        DipoleParticle a;
+        a = atom[ (i+j+k)%2 ? "ew2" : "ew1" ];
+        a = Point(i-1.5, j-1.5, k-2.5);
+        spc.insert(a);
+      }
+  g.setrange(0, spc.p.size()-1);
+  spc.enroll(g);
+
+  Energy::Ewald<Tspace> pot(in);
+  pot.setSpace(spc);
+  double lB = pot.pairpot.bjerrumLength();
+  double M = -Energy::systemEnergy(spc,pot,spc.p) / (spc.p.size()/2) / lB;
+  CHECK( M == Approx(1.747565).epsilon(1e-5) );
+
+  Move::AtomicTranslation<Tspace> mv(in,pot,spc);
+  mv.setGroup(g);
+  double u0 = Energy::systemEnergy(spc,pot,spc.p);
+  double du = mv.move(200);
+  Energy::Ewald<Tspace> fresh(in);
+  double u1 = Energy::systemEnergy(spc,fresh,spc.p);
+  CHECK( u1 == Approx(u0+du) );
+}
+
+TEST_CASE("External grid", "Interpolated external potential must match the exact one")
+{
+  std::ofstream js("extgrid_test.json"), inp("extgrid_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"eg1\" : {\"q\":1, \"r\":1.0},\n"
+    << "\"eg2\" : {\"q\":-2, \"r\":1.0}\n } \n }";
+  inp << "cuboid_len 50\n" << "temperature 298\n" << "epsilon_r 80\n"
+    << "dh_ionicstrength 0.05\n gouychapman_phi0 -3\n"
+    << "extgrid_zmin -25\n extgrid_zmax 25\n extgrid_spacing 0.25\n"
+    << "extgrid_rmin 0\n extgrid_rmax 40\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("extgrid_test.json");
+  InputMap in("extgrid_test.input");
+  Geometry::Cuboidslit geo(in);
+  Potential::GouyChapman<> gc(in);
+  gc.setSurfPositionZ( &geo.len_half.z() );
+  Potential::ExternalGrid<Potential::GouyChapman<> > g1(in);
+  g1.potential.setSurfPositionZ( &geo.len_half.z() );
+  Potential::ExternalGrid<Potential::GouyChapman<>,2> g2(in);
+  g2.potential.setSurfPositionZ( &geo.len_half.z() );
+
+  double err1=0, err2=0;
+  DipoleParticle a;
+  for (int i=0; i<1000; i++) {
+    a = atom[ (i%2) ? "eg1" : "eg2" ];
+    a.x() = slp_global.randHalf()*50;
+    a.y() = slp_global.randHalf()*50;
+    a.z() = slp_global.randHalf()*50;
+    double u = gc(a);
+    err1 = std::max(err1, std::fabs(g1(a)-u));
+    err2 = std::max(err2, std::fabs(g2(a)-u));
+  }
+  CHECK( err1 < 1e-4 );
+  CHECK( err2 < 1e-4 );
+  a.z() = 30; // outside grid
+  CHECK( g1(a) == Approx(gc(a)) );
+}
+
+TEST_CASE("Body frame grid", "Interpolated molecule-ion energies must follow rigid rotations")
+{
+  std::ofstream js("bg_test.json"), inp("bg_test.input");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"bga\" : {\"q\":0, \"r\":1.5, \"eps\":0.05},\n"
+    << "\"bg+\" : {\"q\":1, \"r\":1.5, \"eps\":0.05},\n"
+    << "\"bg-\" : {\"q\":-1, \"r\":1.5, \"eps\":0.05}\n } \n }";
+  inp << "sphere_radius 60\n" << "temperature 298\n" << "epsilon_r 80\n"
+    << "tion1 bg+\n nion1 100\n tion2 bg-\n nion2 100\n"
+    << "bodygrid_spacing 0.5\n bodygrid_pad 8\n bodygrid_shell 6\n";
+  js.close();
+  inp.close();
+
+  ::atom.includefile("bg_test.json");
+  InputMap in("bg_test.input");
+  typedef Space<Geometry::Sphere, DipoleParticle> Tspace;
+  Tspace spc(in);
+  Energy::NonbondedBodyGrid<Tspace,Potential::CoulombLJ> pot(in);
+  Energy::Nonbonded<Tspace,Potential::CoulombLJ> exact(in);
+  pot.setSpace(spc);
+  exact.setSpace(spc);
+
+  Tspace::ParticleVector v(40);
+  std::mt19937 eng(7);
+  std::uniform_real_distribution<double> unit(-1,1);
+  for (auto &i : v) {
+    i = atom["bga"];
+    i.charge = unit(eng);
+    do {
+      i.x()=8*unit(eng); i.y()=8*unit(eng); i.z()=8*unit(eng);
+    } while (i.norm()>8);
+  }
+  Group mol = spc.insert(v);
+  mol.setMolSize(mol.size());
+  mol.setMassCenter(spc);
+  Group salt;
+  salt.addParticles(spc, in);
+  spc.trial=spc.p;
+  pot.addBody(mol);
+
+  for (int n=0; n<3; n++) {
+    Point u;
+    u.ranunit(slp_global);
+    mol.rotate(spc, mol.cm+u, 1.0);
+    mol.translate(spc, Point(3,-2,1));
+    mol.accept(spc);
+
+    for (auto i : salt)
+      CHECK( std::fabs(pot.i2all(spc.p,i) - exact.i2all(spc.p,i)) < 0.01 );
+    double u0 = exact.g2g(spc.p,mol,salt);
+    CHECK( pot.g2g(spc.p,mol,salt) == Approx(u0).epsilon(0.001) );
+    CHECK( pot.g2g(spc.p,salt,mol) == Approx(u0).epsilon(0.001) );
+    CHECK( pot.g_internal(spc.p,mol) == Approx(exact.g_internal(spc.p,mol)) );
+  }
+}
+
+TEST_CASE("Damped multipoles", "Tabulated Wolf and Gaussian damping kernels must match direct evaluation")
+{
+  std::ofstream js("damp_test.json");
+  js << "{ \"atomlist\" : \n { \n "
+    << "\"gd1\" : {\"q\":1, \"betaC\":0.8, \"betaD\":0.6, \"betaQ\":0.7},\n"
+    << "\"gd2\" : {\"q\":-1, \"betaC\":1.1, \"betaD\":0.9, \"betaQ\":0.5}\n } \n }";
+  js.close();
+  ::atom.includefile("damp_test.json");
+  int id1=atom["gd1"].id, id2=atom["gd2"].id;
+
+  const WolfBase tab(0.2, 12), exact(0.2, 12, 12); // second is never tabulated
+  const GaussianDampingBase gdb;
+
+  Point muA(1,0,0), muB(0,0.6,0.8);
+  Eigen::Matrix3d quadA, quadB;
+  quadA << 1,0.2,0, 0.2,-0.5,0.1, 0,0.1,-0.5;
+  quadB << -0.3,0,0.4, 0,0.6,0, 0.4,0,-0.3;
+  DipoleParticle p;
+  p.charge = 1;
+  p.mu = muB;
+  p.muscalar = 1;
+  p.id = id2;
+
+  double c = 2/std::sqrt(pc::pi);
+  auto mix = [](double a, double b) { return a*b/std::sqrt(a*a+b*b); };
+  auto B1 = [&](double x) { return ( std::erf(x)/x - c*std::exp(-x*x) ) / (x*x); };
+  auto B2 = [&](double x) { return ( 3*std::erf(x)/x - (3+2*x*x)*c*std::exp(-x*x) ) / std::pow(x,4); };
+  double bCC=mix(0.8,1.1), bDD=mix(0.6,0.9), bCD=mix(0.8,0.9), bDC=mix(0.6,1.1);
+
+  double errW=0, errG=0;
+  for (double r1=0.05; r1<13; r1+=0.0137) {
+    Point r = Point(0.3,-0.8,0.52).normalized()*r1;
+    if (r1>1.5) {
+      WolfBase::wdata d;
+      CHECK( tab.calcWolfData(r,d)==(r1<12) );
+      errW = std::max(errW, std::fabs( tab.q2q(1,-1,r) - exact.q2q(1,-1,r) ));
+      errW = std::max(errW, std::fabs( tab.q2mu(1,muA,1,muB,r) - exact.q2mu(1,muA,1,muB,r) ));
+      errW = std::max(errW, std::fabs( tab.mu2mu(muA,muB,1,r) - exact.mu2mu(muA,muB,1,r) ));
+      errW = std::max(errW, std::fabs( tab.q2quad(1,quadB,-1,quadA,r) - exact.q2quad(1,quadB,-1,quadA,r) ));
+      errW = std::max(errW, double( (tab.fieldDipole(p,r) - exact.fieldDipole(p,r)).norm() ));
+      if (r1<12) {
+        CHECK( tab.q2q(d,1,-1) == Approx(tab.q2q(1,-1,r)) );
+        CHECK( tab.mu2mu(d,muA,muB,1,r) == Approx(tab.mu2mu(muA,muB,1,r)) );
+      }
+    }
+
+    double u = bCC*std::erf(bCC*r1)/bCC/r1;
+    errG = std::max(errG, std::fabs( gdb.q2q(1,1,id1,id2,r) - u ));
+    u = muA.dot(r)*std::pow(bCD,3)*B1(bCD*r1) - muB.dot(r)*std::pow(bDC,3)*B1(bDC*r1);
+    errG = std::max(errG, std::fabs( gdb.q2mu(1,muA,1,muB,id1,id2,r) - u ));
+    u = ( muA.dot(muB)*B1(bDD*r1) - bDD*bDD*muA.dot(r)*muB.dot(r)*B2(bDD*r1) ) * std::pow(bDD,3);
+    errG = std::max(errG, std::fabs( gdb.mu2mu(muA,muB,1,id1,id2,r) - u ));
+    Point E = -( B1(bDD*r1)*muB - bDD*bDD*muB.dot(r)*B2(bDD*r1)*r ) * std::pow(bDD,3);
+    errG = std::max(errG, double( (gdb.fieldDipole(p,r,id1) - E).norm() ));
+  }
+  double eps = std::numeric_limits<Point::Tcoord>::epsilon(); // dot products in coordinate precision
+  CHECK( errW < std::max(1e-7, 10*eps) );
+  CHECK( errG < std::max(1e-8, 10*eps) );
+}
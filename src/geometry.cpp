@@ -316,41 +316,30 @@ namespace Faunus {
     }
 
 #ifdef HYPERSPHERE
-    const double hyperSphere::pi=pc::pi;
-
     hyperSphere::hyperSphere(InputMap &in) : Sphere(in) {
+      name="Hyperspherical";
     }
 
-    bool hyperSphere::collision(const particle &p) const {
+    bool hyperSphere::collision(const particle &p, collisiontype type) const {
       return false;
     }
 
-    void hyperSphere::randompos(point &m) {
-      double rho=sqrt(slp.random_one());
-      double omega=slp.random_one()*2.*pi;
-      double fi=slp.random_one()*2.*pi;
-      m.z1=sqrt(1.-rho*rho);
-      m.z2=m.z1*cos(omega);
-      m.z1=m.z1*sin(omega);
-      m.z3=rho*sin(fi);
-      m.z4=rho*cos(fi);
+    void hyperSphere::randompos(Point &m) {
+      double rho=sqrt(slp());
+      double omega=slp()*2.*pc::pi;
+      double fi=slp()*2.*pc::pi;
+      m.z1()=sqrt(1.-rho*rho);
+      m.z2()=m.z1()*cos(omega);
+      m.z1()=m.z1()*sin(omega);
+      m.z3()=rho*sin(fi);
+      m.z4()=rho*cos(fi);
     }
 
-    string hyperSphere::_info() {
+    string hyperSphere::_info(char w) {
       std::ostringstream o;
-      o << "#   Shape                = Hyperspherical" << endl
-        << "#   Radius               = " << r << endl;
+      o << pad(SUB,w,"Radius") << getRadius() << textio::_angstrom << endl;
       return o.str();
     }
-
-    /*
-       void hyperSphere::move(int i, double dangle) {
-       double nfi=2.*acos(-1.)*slp.random_one();
-       double nrho=sqrt((slp.random_one()-1.)*sin(dangle)*sin(dangle)+1.);
-       double nomega=(2.*slp.random_one()-1.)*acos(cos(dangle)/nrho);
-       move(trial[i],nrho,nomega,nfi);
-       }
-       */
 #endif
 
   }//namespace geometry
@@ -228,6 +228,10 @@ namespace Faunus {
     WeeksChandlerAndersen::WeeksChandlerAndersen(InputMap &in) :
       Tbase(in), onefourth(1/4.), twototwosixth(std::pow(2,2/6.))  {
         name="WeeksChandlerAnderson";
+        size_t n=atom.list.size();
+        for (size_t i=0; i<n; i++)
+          for (size_t j=i; j<n; j++)
+            rcut2.set(i,j, s2(i,j)*twototwosixth);
       }
 
     LorentzBerthelot::LorentzBerthelot() : name("Lorentz-Berthelot Mixing Rule") {}
@@ -406,6 +410,28 @@ namespace Faunus {
       return o.str();
     }
 
+    CoulombEwald::CoulombEwald(InputMap &in) : Coulomb(in) {
+      name+=" Ewald real-space";
+      setParameters( in.get<double>("ewald_alpha", 0.2),
+          in.get<double>("ewald_cutoff", 10.) );
+    }
+
+    void CoulombEwald::setParameters(double damping, double cutoff) {
+      assert(damping>0 && cutoff>0);
+      alpha=damping;
+      Rc2=cutoff*cutoff;
+      c=2*alpha/std::sqrt(pc::pi);
+    }
+
+    string CoulombEwald::info(char w) {
+      using namespace textio;
+      std::ostringstream o;
+      o << Coulomb::info(w)
+        << pad(SUB,w,"Damping parameter") << alpha << " 1/"+angstrom+"\n"
+        << pad(SUB,w,"Cut-off") << std::sqrt(Rc2) << _angstrom+"\n";
+      return o.str();
+    }
+
     ChargeNonpolar::ChargeNonpolar(InputMap &in) : Coulomb(in) {
       name="Charge-Nonpolar";
       c=bjerrumLength()/2*in.get<double>("excess_polarization", -1);
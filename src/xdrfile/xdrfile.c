@@ -56,6 +56,14 @@
 #include <config.h>
 #endif
 
+/* 64-bit file offsets for xdr_tell() and xdr_seek() */
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+#ifndef _LARGEFILE_SOURCE
+#define _LARGEFILE_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -276,6 +284,32 @@ xdrfile_close(XDRFILE *xfp)
 }
 
 
+int64_t
+xdr_tell(XDRFILE *xfp)
+{
+	if(xfp==NULL)
+		return -1;
+#ifdef _WIN32
+	return _ftelli64(xfp->fp);
+#else
+	return ftello(xfp->fp);
+#endif
+}
+
+
+int
+xdr_seek(XDRFILE *xfp, int64_t pos, int whence)
+{
+	if(xfp==NULL)
+		return -1;
+#ifdef _WIN32
+	return _fseeki64(xfp->fp, pos, whence);
+#else
+	return fseeko(xfp->fp, (off_t)pos, whence);
+#endif
+}
+
+
 
 int 
 xdrfile_read_int(int *ptr, int ndata, XDRFILE* xfp) 